@@ -0,0 +1,69 @@
+#include "world/batch_queries.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// "All objects within r of each of these points": one-by-one queries in the
+// caller's order versus BatchQuery (Morton sorted, threaded, CSR output).
+// usage: bench_batch_queries [repeats]
+
+using namespace SketchBook::World;
+
+int main(int argc, char* argv[])
+{
+    const int repeats = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 20;
+    const size_t object_count = 100000;
+    const size_t query_count = 10000;
+    const float radius = 3.f;
+
+    const float extent = std::sqrt(static_cast<float>(object_count) * 4.f);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(0.f, extent);
+
+    std::vector<glm::vec2> positions(object_count);
+    std::vector<glm::vec2> queries(query_count);
+    for (glm::vec2& p : positions) p = {coord(rng), coord(rng)};
+    for (glm::vec2& q : queries) q = {coord(rng), coord(rng)};
+
+    SpatialHashGrid grid(radius);
+    grid.build(positions);
+
+    spdlog::info("bench_batch_queries | threads={} objects={} queries={} radius={}",
+        SketchBook::Threading::ThreadPool::shared().thread_count(), object_count, query_count, radius);
+
+    using Clock = std::chrono::steady_clock;
+
+    size_t single_hits = 0;
+    std::vector<std::vector<uint32_t>> single_results(query_count);
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++)
+    {
+        for (size_t q = 0; q < query_count; q++)
+        {
+            single_results[q].clear();
+            for_each_id_in_radius(grid, queries[q], radius, [&](const uint32_t id) { single_results[q].push_back(id); });
+            single_hits += single_results[q].size();
+        }
+    }
+    const std::chrono::duration<double, std::milli> single_elapsed = Clock::now() - start;
+
+    BatchQuery batch;
+    BatchQueryResults results;
+    size_t batch_hits = 0;
+    start = Clock::now();
+    for (int r = 0; r < repeats; r++)
+    {
+        batch.radius(grid, queries, radius, results);
+        batch_hits += results.ids.size();
+    }
+    const std::chrono::duration<double, std::milli> batch_elapsed = Clock::now() - start;
+
+    spdlog::info("single | {:>8.3f} ms/batch | hits {}", single_elapsed.count() / repeats, single_hits / repeats);
+    spdlog::info("batch  | {:>8.3f} ms/batch | hits {}", batch_elapsed.count() / repeats, batch_hits / repeats);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "world/collision.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Moving KinematicObjects through CollisionWorld::step (sort and sweep + SIMD narrowphase).
+// usage: bench_collision [ticks_per_size]
+
+using namespace SketchBook::World;
+
+int main(int argc, char* argv[])
+{
+    const int ticks = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 60;
+    const float seconds_per_tick = 1.f / 60.f;
+    const size_t sizes[] = {10000, 50000, 100000};
+
+    spdlog::info("bench_collision | threads={} ticks_per_size={}", SketchBook::Threading::ThreadPool::shared().thread_count(), ticks);
+
+    for (const size_t count : sizes)
+    {
+        // constant density: ~1 body per 4 square meters, radius 0.5
+        const float extent = std::sqrt(static_cast<float>(count) * 4.f);
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> coord(0.f, extent);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        std::vector<std::unique_ptr<KinematicObject>> bodies;
+        bodies.reserve(count);
+        Collision::CollisionWorld world;
+        for (size_t i = 0; i < count; i++)
+        {
+            bodies.push_back(std::make_unique<KinematicObject>(coord(rng), coord(rng)));
+            bodies.back()->set_max_speed(2.f);
+            SteeringOutputHandle cruise(unit(rng), unit(rng), 0.f, 0.0, 0.0, false);
+            bodies.back()->add_steering(cruise, 0.0);
+            world.add_object(bodies.back().get());
+        }
+        world.step();
+
+        double collide_ms = 0.0;
+        size_t contacts = 0;
+        size_t events = 0;
+        for (int tick = 0; tick < ticks; tick++)
+        {
+            const Event_NextTick event{static_cast<double>(tick), seconds_per_tick};
+            for (auto& body : bodies) body->update(event);
+
+            const auto start = std::chrono::steady_clock::now();
+            world.step();
+            collide_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            contacts += world.contacts().size();
+            events += world.entered().size() + world.exited().size();
+        }
+
+        spdlog::info("bodies={:>7} | step {:>8.3f} ms | pairs/tick {:>7} | contacts/tick {:>7} | enter+exit/tick {}",
+            count, collide_ms / ticks, world.candidate_pairs().size(), contacts / ticks, events / ticks);
+    }
+
+    return 0;
+}
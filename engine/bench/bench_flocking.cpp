@@ -0,0 +1,64 @@
+#include "world/flocking.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Scales swarm size and reports flocking ticks per second.
+// usage: bench_flocking [ticks_per_size]
+
+using namespace SketchBook::World;
+
+int main(int argc, char* argv[])
+{
+    const int ticks = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 100;
+    const float seconds_per_tick = 0.01f;
+    const size_t sizes[] = {1000, 5000, 10000, 50000, 100000};
+
+    spdlog::info("bench_flocking | threads={} ticks_per_size={}", SketchBook::Threading::ThreadPool::shared().thread_count(), ticks);
+
+    for (const size_t count : sizes)
+    {
+        // constant density: ~1 agent per 4 square meters
+        const float extent = std::sqrt(static_cast<float>(count) * 4.f);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coord(0.f, extent);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        std::vector<std::unique_ptr<Actor>> storage;
+        std::vector<Actor*> actors;
+        storage.reserve(count);
+        actors.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            storage.push_back(std::make_unique<Actor>(coord(rng), coord(rng)));
+            storage.back()->set_max_speed(2.f);
+            SteeringOutputHandle cruise(unit(rng), unit(rng), 0.f, 0.0, 0.0, false);
+            storage.back()->add_steering(cruise, 0.0);
+            actors.push_back(storage.back().get());
+        }
+
+        Flocking::Flock flock;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; tick++)
+        {
+            const Event_NextTick event{static_cast<double>(tick), seconds_per_tick};
+            flock.steer(actors, event);
+            for (Actor* actor : actors)
+            {
+                actor->update(event);
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        spdlog::info("agents={:>7} | {:>9.2f} ticks/s | {:>8.3f} ms/tick", count, ticks / elapsed.count(), 1000.0 * elapsed.count() / ticks);
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "obj_parser.h"
+#include "sk_io.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Parallel OBJ parser against tinyobj, on a synthetic grid mesh and on any OBJ files given.
+// usage: bench_obj_parser [grid_size] [file.obj ...]
+//   e.g. bench_obj_parser 1000 ../vulkan_tutorial/assets/monkey_smooth.obj
+
+using namespace SketchBook;
+
+// grid_size^2 quads with normals and texcoords, written like a DCC exporter would
+static void write_grid(const std::string& path, const size_t grid_size)
+{
+    std::ofstream out(path, std::ios::binary);
+    out << "o Grid\n";
+    for (size_t y = 0; y <= grid_size; y++)
+    {
+        for (size_t x = 0; x <= grid_size; x++)
+        {
+            out << "v " << x * 0.01f << " " << y * 0.01f << " " << ((x * 7 + y * 13) % 17) * 0.001f << "\n";
+            out << "vt " << float(x) / grid_size << " " << float(y) / grid_size << "\n";
+        }
+    }
+    out << "vn 0.000000 0.000000 1.000000\n";
+    for (size_t y = 0; y < grid_size; y++)
+    {
+        for (size_t x = 0; x < grid_size; x++)
+        {
+            const size_t i = y * (grid_size + 1) + x + 1;
+            const size_t corners[4] = {i, i + 1, i + grid_size + 2, i + grid_size + 1};
+            out << "f";
+            for (const size_t c : corners) out << " " << c << "/" << c << "/1";
+            out << "\n";
+        }
+    }
+}
+
+template<typename F>
+static double best_ms(F&& f, const int runs = 3)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; r++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+static void bench_file(const std::string& path)
+{
+    size_t tinyobj_corners = 0;
+    const double tinyobj_ms = best_ms([&]() {
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warn;
+        std::string err;
+        IO::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str());
+        tinyobj_corners = 0;
+        for (const tinyobj::shape_t& shape : shapes) tinyobj_corners += shape.mesh.indices.size();
+    });
+
+    IO::ObjData obj;
+    const double parallel_ms = best_ms([&]() { IO::load_obj(path, obj); });
+
+    Threading::ThreadPool single(0);
+    const double single_ms = best_ms([&]() { IO::load_obj(path, obj, single); });
+
+    spdlog::info("bench_obj_parser | {} | {:.1f} MB | corners tinyobj={} ours={} | tinyobj {:.1f} ms | 1 thread {:.1f} ms | {} threads {:.1f} ms ({:.1f}x)",
+        std::filesystem::path(path).filename().string(), std::filesystem::file_size(path) / (1024.0 * 1024.0),
+        tinyobj_corners, obj.indices.size(), tinyobj_ms, single_ms,
+        Threading::ThreadPool::shared().thread_count() + 1, parallel_ms, tinyobj_ms / std::max(parallel_ms, 1e-3));
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t grid_size = (argc > 1) ? static_cast<size_t>(std::max(std::atoll(argv[1]), 1ll)) : 1000;
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_obj_parser.obj").string();
+
+    write_grid(path, grid_size);
+    bench_file(path);
+    std::filesystem::remove(path);
+
+    for (int i = 2; i < argc; i++)
+    {
+        bench_file(argv[i]);
+    }
+    return 0;
+}
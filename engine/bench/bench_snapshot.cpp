@@ -0,0 +1,46 @@
+#include "snapshot.h"
+#include "world/kinematics.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+// Saving and loading kinematic agents through the binary registry snapshot.
+// usage: bench_snapshot [entity_count]
+
+using namespace SketchBook;
+using namespace SketchBook::World::Kinematics;
+
+int main(int argc, char* argv[])
+{
+    const size_t count = (argc > 1) ? static_cast<size_t>(std::max(std::atoll(argv[1]), 1ll)) : 1000000;
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_snapshot.sksn").string();
+
+    std::vector<glm::vec2> positions(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        positions[i] = {static_cast<float>(i % 1000), static_cast<float>(i / 1000)};
+    }
+
+    entt::registry source;
+    std::vector<entt::entity> entities;
+    create_many(source, positions.data(), count, entities);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!save_snapshot<Position, Velocity, Heading, MotionLimits>(source, path)) return 1;
+    const double save_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    entt::registry loaded;
+    if (!load_snapshot<Position, Velocity, Heading, MotionLimits>(loaded, path)) return 1;
+    const double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    spdlog::info("bench_snapshot | entities={} | file {:.1f} MB | save {:.1f} ms | load {:.1f} ms",
+        count, std::filesystem::file_size(path) / (1024.0 * 1024.0), save_ms, load_ms);
+
+    std::filesystem::remove(path);
+    return 0;
+}
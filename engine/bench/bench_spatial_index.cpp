@@ -0,0 +1,193 @@
+#include "world/sk_world.h"
+#include "world/loose_tree.h"
+#include "world/spatial_hash.h"
+#include "sk_threads.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Moves every object every tick (crowd-style wander), then runs a batch of box
+// queries in parallel. Compares the r-tree (World2dModel), the loose quadtree
+// and the rebuilt-per-tick uniform grid.
+// usage: bench_spatial_index [ticks_per_size]
+
+using namespace SketchBook;
+using namespace SketchBook::View;
+
+namespace
+{
+    struct Timings
+    {
+        double update_ms{0.0};
+        double query_ms{0.0};
+        size_t hits{0};
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(const Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    struct Scenario
+    {
+        std::vector<WorldObject> objects;
+        std::vector<glm::vec3> velocities;
+        std::vector<glm::vec3> queries;
+        float extent;
+    };
+
+    Scenario make_scenario(const size_t count, const size_t query_count)
+    {
+        Scenario scenario;
+        // constant density: ~1 object per 4 square meters
+        scenario.extent = std::sqrt(static_cast<float>(count) * 4.f);
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> coord(0.f, scenario.extent);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            WorldObject object;
+            object.id = static_cast<int>(i);
+            object.position = {coord(rng), coord(rng), 0.f};
+            object.min_corner = object.position - glm::vec3(0.5f, 0.5f, 0.f);
+            object.max_corner = object.position + glm::vec3(0.5f, 0.5f, 0.f);
+            scenario.objects.push_back(object);
+            scenario.velocities.push_back({unit(rng) * 2.f, unit(rng) * 2.f, 0.f});
+        }
+        for (size_t i = 0; i < query_count; i++)
+        {
+            scenario.queries.push_back({coord(rng), coord(rng), 0.f});
+        }
+        return scenario;
+    }
+
+    // velocity for this tick: cruise, with a turn every few seconds and a bounce at the edges
+    glm::vec3 step(Scenario& scenario, const size_t i, const int tick, const float seconds_per_tick)
+    {
+        glm::vec3& velocity = scenario.velocities[i];
+        if ((tick + static_cast<int>(i)) % 180 == 0) velocity = glm::vec3(-velocity.y, velocity.x, 0.f);
+
+        const glm::vec3 next = scenario.objects[i].position + velocity * seconds_per_tick;
+        if (next.x < 0.f || next.x > scenario.extent) velocity.x = -velocity.x;
+        if (next.y < 0.f || next.y > scenario.extent) velocity.y = -velocity.y;
+        return velocity * seconds_per_tick;
+    }
+
+    template<typename Index>
+    Timings run_index(Scenario scenario, Index& index, const int ticks, const float seconds_per_tick, const float query_half)
+    {
+        Timings timings;
+        Threading::ThreadPool& pool = Threading::ThreadPool::shared();
+        index.load(scenario.objects);
+
+        for (int tick = 0; tick < ticks; tick++)
+        {
+            auto start = Clock::now();
+            for (size_t i = 0; i < scenario.objects.size(); i++)
+            {
+                const glm::vec3 delta = step(scenario, i, tick, seconds_per_tick);
+                scenario.objects[i].update_position(delta);
+                index.move_object(scenario.objects[i].id, delta);
+            }
+            timings.update_ms += elapsed_ms(start);
+
+            start = Clock::now();
+            std::atomic<size_t> hits{0};
+            pool.parallel_for(0, scenario.queries.size(), 64, [&](const size_t first, const size_t last) {
+                int ids[256];
+                size_t local = 0;
+                for (size_t q = first; q < last; q++)
+                {
+                    const glm::vec3& center = scenario.queries[q];
+                    const WorldBox box = to_world_box(center - glm::vec3(query_half, query_half, 1.f), center + glm::vec3(query_half, query_half, 1.f));
+                    local += index.query_box(box, ids, 256);
+                }
+                hits += local;
+            });
+            timings.query_ms += elapsed_ms(start);
+            timings.hits += hits;
+        }
+        return timings;
+    }
+
+    Timings run_grid(Scenario scenario, const int ticks, const float seconds_per_tick, const float query_half)
+    {
+        Timings timings;
+        Threading::ThreadPool& pool = Threading::ThreadPool::shared();
+        World::SpatialHashGrid grid(2.f * query_half);
+        std::vector<glm::vec2> positions(scenario.objects.size());
+
+        for (int tick = 0; tick < ticks; tick++)
+        {
+            auto start = Clock::now();
+            for (size_t i = 0; i < scenario.objects.size(); i++)
+            {
+                const glm::vec3 delta = step(scenario, i, tick, seconds_per_tick);
+                scenario.objects[i].update_position(delta);
+                positions[i] = {scenario.objects[i].position.x, scenario.objects[i].position.y};
+            }
+            grid.build(positions);
+            timings.update_ms += elapsed_ms(start);
+
+            // the grid indexes points, so widen the box by the object half size
+            const float reach = query_half + 0.5f;
+            start = Clock::now();
+            std::atomic<size_t> hits{0};
+            pool.parallel_for(0, scenario.queries.size(), 64, [&](const size_t first, const size_t last) {
+                size_t local = 0;
+                for (size_t q = first; q < last; q++)
+                {
+                    const glm::vec2 center{scenario.queries[q].x, scenario.queries[q].y};
+                    grid.for_each_in_box(center - glm::vec2(reach), center + glm::vec2(reach), [&](const uint32_t, const glm::vec2&) { ++local; });
+                }
+                hits += local;
+            });
+            timings.query_ms += elapsed_ms(start);
+            timings.hits += hits;
+        }
+        return timings;
+    }
+
+    void report(const char* name, const size_t count, const Timings& timings, const int ticks)
+    {
+        spdlog::info("{:<14} agents={:>7} | update {:>8.3f} ms/tick | query {:>8.3f} ms/tick | hits/tick {}",
+            name, count, timings.update_ms / ticks, timings.query_ms / ticks, timings.hits / ticks);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int ticks = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 60;
+    const float seconds_per_tick = 1.f / 60.f;
+    const float query_half = 4.f;
+    const size_t query_count = 2000;
+    const size_t sizes[] = {1000, 10000, 50000, 100000};
+
+    spdlog::info("bench_spatial_index | threads={} ticks_per_size={} queries_per_tick={}", Threading::ThreadPool::shared().thread_count(), ticks, query_count);
+
+    for (const size_t count : sizes)
+    {
+        const Scenario scenario = make_scenario(count, query_count);
+        const float half = scenario.extent * 0.5f;
+
+        World2dModel rtree(0.5f);
+        report("rtree", count, run_index(scenario, rtree, ticks, seconds_per_tick, query_half), ticks);
+
+        LooseQuadtree quadtree({half, half, 0.f}, half, 8);
+        report("loose quadtree", count, run_index(scenario, quadtree, ticks, seconds_per_tick, query_half), ticks);
+
+        report("uniform grid", count, run_grid(scenario, ticks, seconds_per_tick, query_half), ticks);
+    }
+
+    return 0;
+}
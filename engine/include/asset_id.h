@@ -0,0 +1,31 @@
+#pragma once
+
+#include <entt/core/hashed_string.hpp>
+#include <string>
+#include <string_view>
+
+namespace SketchBook
+{
+    // Compact asset name id (entt's FNV-1a hash, the same value as "name"_hs).
+    using AssetId = entt::id_type;
+
+    constexpr AssetId asset_id(const std::string_view name)
+    {
+        return entt::hashed_string::value(name.data(), name.size());
+    }
+
+    // Asset name together with its id. Keys made from literals are hashed at compile
+    // time, e.g. `static constexpr AssetKey pipeline_mesh_key{"pipeline.mesh"};`.
+    // The key only views the name, so it must not outlive the string it was made from.
+    struct AssetKey
+    {
+        std::string_view name;
+        AssetId id;
+
+        constexpr AssetKey(const char* in_name) : AssetKey(std::string_view{in_name}) {}
+        constexpr AssetKey(const std::string_view in_name) : name{in_name}, id{asset_id(in_name)} {}
+        AssetKey(const std::string& in_name) : AssetKey(std::string_view{in_name}) {}
+
+        std::string str() const { return std::string{name}; }
+    };
+}
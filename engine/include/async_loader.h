@@ -0,0 +1,121 @@
+#pragma once
+
+#include "sk_threads.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        enum class LoadStatus : uint8_t
+        {
+            Pending = 0,
+            Ready,
+            Failed
+        };
+
+        // future-like view of one AsyncLoader::load; cheap to copy and never blocks
+        class LoadTicket
+        {
+        public:
+            LoadTicket() = default;
+
+            // a default constructed ticket reads as failed
+            inline LoadStatus status() const { return m_status ? m_status->load(std::memory_order_acquire) : LoadStatus::Failed; }
+            inline bool is_pending() const { return status() == LoadStatus::Pending; }
+            inline bool is_ready() const { return status() == LoadStatus::Ready; }
+            inline bool is_failed() const { return status() == LoadStatus::Failed; }
+
+        private:
+            friend class AsyncLoader;
+            explicit LoadTicket(std::shared_ptr<std::atomic<LoadStatus>> status) : m_status(std::move(status)) {}
+
+            std::shared_ptr<std::atomic<LoadStatus>> m_status;
+        };
+
+        // Loads in two stages. decode (file IO, parsing, decompression) runs on a pool thread;
+        // finish (GPU upload, swapping the asset in for its placeholder) runs on the thread that
+        // calls pump, in the order the decodes completed. pump takes a budget so a burst of
+        // finished loads is spread over several frames.
+        class AsyncLoader
+        {
+        public:
+            explicit AsyncLoader(Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+            ~AsyncLoader();
+
+            AsyncLoader(const AsyncLoader&) = delete;
+            AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+            // bool decode(Decoded&) on a pool thread, then bool finish(Decoded&) in pump; either
+            // returning false fails the load. Decoded is default constructed and lives until finish returns.
+            template<typename Decoded, typename Decode, typename Finish>
+            LoadTicket load(Decode&& decode, Finish&& finish)
+            {
+                auto job = std::make_shared<Job<Decoded, std::decay_t<Decode>, std::decay_t<Finish>>>(
+                    std::forward<Decode>(decode), std::forward<Finish>(finish));
+                LoadTicket ticket(job->status);
+                start(std::move(job));
+                return ticket;
+            }
+
+            // runs at most max_finishes finish stages and returns how many loads completed
+            size_t pump(const size_t max_finishes = SIZE_MAX);
+
+            // blocks until no decode is running; finished decodes still wait for pump
+            void wait_decoded();
+
+            // wait_decoded, then pump everything: a synchronous load of whatever is queued
+            void finish_all();
+
+            // waits for running decodes and fails every load that has not finished
+            void cancel();
+
+            // loads not finished yet, decoding or waiting for pump
+            size_t pending() const;
+            bool has_decoded() const;
+
+        private:
+            struct JobBase
+            {
+                std::shared_ptr<std::atomic<LoadStatus>> status{std::make_shared<std::atomic<LoadStatus>>(LoadStatus::Pending)};
+                bool b_decoded{false};
+
+                virtual ~JobBase() = default;
+                virtual bool decode() = 0;
+                virtual bool finish() = 0;
+            };
+
+            template<typename Decoded, typename Decode, typename Finish>
+            struct Job : JobBase
+            {
+                Decoded value{};
+                Decode decode_fn;
+                Finish finish_fn;
+
+                template<typename D, typename F>
+                Job(D&& decode, F&& finish) : decode_fn(std::forward<D>(decode)), finish_fn(std::forward<F>(finish)) {}
+
+                bool decode() override { return decode_fn(value); }
+                bool finish() override { return finish_fn(value); }
+            };
+
+            void start(std::shared_ptr<JobBase> job);
+            void run_decode(const std::shared_ptr<JobBase>& job);
+
+            Threading::ThreadPool& m_pool;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<std::shared_ptr<JobBase>> m_decoded;
+            size_t m_decoding{0};
+        };
+    }
+}
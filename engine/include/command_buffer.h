@@ -0,0 +1,214 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+    // Structural changes recorded while systems iterate in parallel and applied at a sync point.
+    //
+    // Every pool thread records into its own EntityCommandBuffer (no locks, no registry access).
+    // CommandBuffers::playback merges them on one thread: commands are ordered by the key set
+    // with set_order() and then by recording order, so the result does not depend on which
+    // thread picked up which chunk. Give each parallel_for item its own key (its index works).
+    // Creates are done as one range create, and every touched storage is reserved up front.
+
+    // entity created by a buffer; only meaningful to the buffer that returned it
+    struct PendingEntity
+    {
+        uint32_t index;
+    };
+
+    class EntityCommandBuffer
+    {
+    public:
+        // commands recorded from now on sort by this key in the merge
+        inline void set_order(const uint64_t order) { m_order = order; }
+
+        PendingEntity create();
+        void destroy(const entt::entity entity);
+        void destroy(const PendingEntity entity);
+
+        // replaces the component if the entity already has one
+        template<typename Component, typename... Args>
+        void emplace(const entt::entity entity, Args&&... args) { record_emplace<Component>(Target::of(entity), std::forward<Args>(args)...); }
+
+        template<typename Component, typename... Args>
+        void emplace(const PendingEntity entity, Args&&... args) { record_emplace<Component>(Target::of(entity), std::forward<Args>(args)...); }
+
+        template<typename Component>
+        void remove(const entt::entity entity) { record(Op::Remove, Target::of(entity), pool<Component>().slot, 0); }
+
+        template<typename Component>
+        void remove(const PendingEntity entity) { record(Op::Remove, Target::of(entity), pool<Component>().slot, 0); }
+
+        inline size_t size() const { return m_commands.size(); }
+        inline bool empty() const { return m_commands.empty(); }
+
+    private:
+        friend class CommandBuffers;
+
+        enum class Op : uint8_t
+        {
+            Create = 0,
+            Destroy,
+            Emplace,
+            Remove
+        };
+
+        struct Target
+        {
+            entt::entity entity;
+            uint32_t pending;       // index into m_created, or NOT_PENDING
+
+            static constexpr uint32_t NOT_PENDING = UINT32_MAX;
+            static Target of(const entt::entity entity) { return Target{entity, NOT_PENDING}; }
+            static Target of(const PendingEntity entity) { return Target{entt::null, entity.index}; }
+        };
+
+        struct Command
+        {
+            uint64_t order;
+            Target target;
+            uint32_t slot;          // component pool, for Emplace and Remove
+            uint32_t payload;       // index into the pool's values, for Emplace
+            Op op;
+        };
+
+        // values of one component type, addressed by slot
+        struct PoolBase
+        {
+            uint32_t slot{0};
+            size_t pending_emplaces{0};
+
+            virtual ~PoolBase() = default;
+            virtual void reserve(entt::registry& registry, const size_t count) = 0;
+            virtual void emplace(entt::registry& registry, const entt::entity entity, const uint32_t payload) = 0;
+            virtual void remove(entt::registry& registry, const entt::entity entity) = 0;
+            virtual void clear() = 0;
+        };
+
+        template<typename Component>
+        struct Pool : PoolBase
+        {
+            std::vector<Component> values;
+
+            void reserve(entt::registry& registry, const size_t count) override
+            {
+                auto& storage = registry.storage<Component>();
+                storage.reserve(storage.size() + count);
+            }
+
+            void emplace(entt::registry& registry, const entt::entity entity, const uint32_t payload) override
+            {
+                if constexpr (std::is_empty_v<Component>)
+                {
+                    registry.emplace_or_replace<Component>(entity);
+                }
+                else
+                {
+                    registry.emplace_or_replace<Component>(entity, std::move(values[payload]));
+                }
+            }
+
+            void remove(entt::registry& registry, const entt::entity entity) override
+            {
+                registry.remove<Component>(entity);
+            }
+
+            void clear() override
+            {
+                values.clear();
+                pending_emplaces = 0;
+            }
+        };
+
+        // process wide slot per component type, so every buffer agrees on it
+        static uint32_t next_slot();
+
+        template<typename Component>
+        static uint32_t slot_of()
+        {
+            static const uint32_t slot = next_slot();
+            return slot;
+        }
+
+        template<typename Component>
+        Pool<Component>& pool()
+        {
+            const uint32_t slot = slot_of<Component>();
+            if (slot >= m_pools.size()) m_pools.resize(slot + 1);
+            if (!m_pools[slot])
+            {
+                m_pools[slot] = std::make_unique<Pool<Component>>();
+                m_pools[slot]->slot = slot;
+            }
+            return static_cast<Pool<Component>&>(*m_pools[slot]);
+        }
+
+        template<typename Component, typename... Args>
+        void record_emplace(const Target target, Args&&... args)
+        {
+            Pool<Component>& values = pool<Component>();
+            uint32_t payload = 0;
+            if constexpr (!std::is_empty_v<Component>)
+            {
+                payload = static_cast<uint32_t>(values.values.size());
+                values.values.push_back(Component{std::forward<Args>(args)...});
+            }
+            ++values.pending_emplaces;
+            record(Op::Emplace, target, values.slot, payload);
+        }
+
+        inline void record(const Op op, const Target target, const uint32_t slot, const uint32_t payload)
+        {
+            m_commands.push_back(Command{m_order, target, slot, payload, op});
+        }
+
+        void clear();
+
+        uint64_t m_order{0};
+        std::vector<Command> m_commands;
+        std::vector<std::unique_ptr<PoolBase>> m_pools;
+        std::vector<entt::entity> m_created;    // filled in by playback, indexed by PendingEntity
+        uint32_t m_create_count{0};
+    };
+
+    // One EntityCommandBuffer per thread of a pool, plus one for the thread that owns the sync point.
+    class CommandBuffers
+    {
+    public:
+        explicit CommandBuffers(Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+
+        // the calling thread's buffer; threads outside the pool all share slot 0, so record
+        // from at most one of them (normally the one that calls playback)
+        inline EntityCommandBuffer& local() { return m_buffers[m_pool.worker_slot()]; }
+
+        size_t size() const;
+
+        // applies and clears every buffer; call with no system iterating the registry.
+        // Commands on entities that are no longer valid are dropped.
+        void playback(entt::registry& registry);
+
+    private:
+        struct MergeEntry
+        {
+            uint64_t order;
+            uint32_t buffer;
+            uint32_t command;
+        };
+
+        Threading::ThreadPool& m_pool;
+        std::vector<EntityCommandBuffer> m_buffers;
+        std::vector<MergeEntry> m_merge;
+        std::vector<entt::entity> m_created;
+        std::vector<std::pair<EntityCommandBuffer::PoolBase*, size_t>> m_reserve;   // per slot, emplaces across buffers
+    };
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "sk_types.h"
+#include "asset_id.h"
 #include <vulkan_init.h>
 #include "VkBootstrap.h"
+#include <type_traits>
 
 namespace SketchBook
 {
@@ -11,19 +13,20 @@ namespace Components
     struct Pipeline
     {
         std::string name;
-        VkPipeline pipeline;
+        PipelineHandle pipeline;
     };
 
     struct PipelineLayout
     {
         std::string name;
-        VkPipelineLayout pipeline_layout;
+        PipelineLayoutHandle pipeline_layout;
     };
 
     struct Mesh 
     {
         std::string name;
         Vertex_RBG_Normal_Mesh mesh;
+        bool b_placeholder{false};  // mesh shares the engine's placeholder buffers until its async load finishes
     };
 
     struct Material
@@ -31,8 +34,21 @@ namespace Components
         std::string name;
         std::string pipeline_name;
         std::string pipeline_layout_name;
+        AssetId pipeline_id{0};
+        AssetId pipeline_layout_id{0};
     };
 
+    // names and ids only; the GPU objects are looked up again after a load
+    template<typename Archive, typename M>
+    std::enable_if_t<std::is_same_v<std::remove_const_t<M>, Material>> snapshot_fields(Archive& archive, M& material)
+    {
+        archive.field(material.name);
+        archive.field(material.pipeline_name);
+        archive.field(material.pipeline_layout_name);
+        archive.field(material.pipeline_id);
+        archive.field(material.pipeline_layout_id);
+    }
+
     struct Texture 
     {
         std::string name;
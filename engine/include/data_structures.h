@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+#include <utility>
 #include <functional>
 #include <memory>
 #include <string>
@@ -32,6 +34,65 @@ namespace DataStructures
         }
     };
 
+    // Handles tagged with the last frame that may use them, destroyed once that frame is done.
+    // Frames finish in order and handles are retired with a non-decreasing frame, so the list
+    // stays sorted and a release only ever pops a prefix.
+    template<typename Handle>
+    class RetireList
+    {
+    public:
+        void push(const Handle& handle, const uint64_t frame)
+        {
+            m_entries.push_back(Entry{frame, handle});
+        }
+
+        // calls destroy on every handle retired on or before completed_frame, oldest first
+        template<typename Destroy>
+        size_t release(const uint64_t completed_frame, Destroy&& destroy)
+        {
+            size_t end = m_head;
+            while (end < m_entries.size() && m_entries[end].frame <= completed_frame)
+            {
+                destroy(m_entries[end].handle);
+                ++end;
+            }
+
+            const size_t released = end - m_head;
+            m_head = end;
+            if (m_head == m_entries.size())
+            {
+                m_entries.clear();
+                m_head = 0;
+            }
+            else if (m_head >= 64 && m_head * 2 >= m_entries.size())
+            {
+                // compact once the released prefix outweighs the live entries
+                m_entries.erase(m_entries.begin(), m_entries.begin() + m_head);
+                m_head = 0;
+            }
+            return released;
+        }
+
+        template<typename Destroy>
+        size_t flush(Destroy&& destroy)
+        {
+            return release(UINT64_MAX, std::forward<Destroy>(destroy));
+        }
+
+        inline size_t size() const { return m_entries.size() - m_head; }
+        inline bool empty() const { return size() == 0; }
+
+    private:
+        struct Entry
+        {
+            uint64_t frame;
+            Handle handle;
+        };
+
+        std::vector<Entry> m_entries;
+        size_t m_head{0};
+    };
+
  
     // Retiring in favor of Entt
     // --------------------------------
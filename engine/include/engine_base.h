@@ -4,6 +4,12 @@
 #include "sk_initializers.h"
 #include "vulkan_structs.h"
 #include "data_structures.h"
+#include "frame_deletion_queue.h"
+#include "frame_arena.h"
+#include "async_loader.h"
+#include "mesh_cache.h"
+#include "mipmaps.h"
+#include "pipeline_cache.h"
 #include "macros.h"
 #include "registry.h"
 #include "sk_views.h"
@@ -16,6 +22,7 @@ namespace SketchBook
 namespace Core
 {
     constexpr unsigned int FRAME_OVERLAP = 2;
+    constexpr unsigned int MAX_INSTANCES = 10000; // matrices in each frame's instance buffer
 
     using DataStructures::DeletionQueue;
 
@@ -35,7 +42,40 @@ namespace Core
         VkCommandBuffer main_command_buffer;
 
         AllocatedBuffer view_buffer;
+        AllocatedBuffer instance_buffer; // MAX_INSTANCES matrices, binding 1; slot 0 is the identity
         VkDescriptorSet global_descriptor;
+
+        Memory::FrameArena arena; // transient CPU data of this frame, reset after render_fence
+    };
+
+    // GPU objects owned by the engine; components and draw code refer to them by handle
+    struct GpuResources
+    {
+        DataStructures::SlotMap<AllocatedBuffer>                        buffers;
+        DataStructures::SlotMap<AllocatedImage>                         images;
+        DataStructures::SlotMap<VkPipeline, PipelineTag>                pipelines;
+        DataStructures::SlotMap<VkPipelineLayout, PipelineLayoutTag>    pipeline_layouts;
+    };
+
+    // a decoded mesh waiting for its upload: the mapped .skmesh, or the parsed mesh when the cache missed
+    struct MeshSource
+    {
+        IO::MeshCacheFile cache;
+        Vertex_RBG_Normal_Mesh mesh;
+    };
+
+    // what async assets show until their load finishes
+    struct Placeholders
+    {
+        Vertex_RBG_Normal_Mesh mesh;    // small octahedron, buffers only
+        ImageHandle image;              // 2x2 magenta and black checker
+    };
+
+    // a pipeline whose build create_pipeline deferred to end_pipeline_batch
+    struct PendingPipeline
+    {
+        entt::entity entity;
+        PipelineBuilder builder;
     };
 
     class EngineVulkanBase {
@@ -49,12 +89,75 @@ namespace Core
         const InitDetails& vk_init() const { return m_vk_init; }
 
         inline FrameData& get_current_frame(){ return m_frames[m_frameNumber % FRAME_OVERLAP]; }
+        // scratch memory valid until this frame slot comes around again, see Memory::FrameVector
+        inline Memory::FrameArena& frame_arena() { return get_current_frame().arena; }
         void immediate_submit(std::function<void(VkCommandBuffer cmd)>&& function);
         AllocatedBuffer create_buffer(size_t allocSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
         bool load_shader_module(const char *filePath, VkShaderModule *outShaderModule);
         void load_mesh_from_obj_file(const char *filename, Vertex_RBG_Normal_Mesh* mesh, const char* base_dir = "assets");
-
+        // uploads from the .skmesh next to filename, (re)building it from the OBJ when missing or stale
+        void load_mesh(const char* filename, Vertex_RBG_Normal_Mesh* mesh, const char* base_dir = "assets");
+        // the CPU half of load_mesh, no Vulkan calls: safe on any thread
+        bool decode_mesh(const char* filename, MeshSource& out, const char* base_dir = "assets");
+        // the GPU half of load_mesh
+        void upload_mesh_source(MeshSource& source, Vertex_RBG_Normal_Mesh* mesh);
+        // device local buffer (usage: e.g. VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) filled through a staging buffer; null handle for no data
+        BufferHandle upload_buffer(const void* data, const size_t bytes, const VkBufferUsageFlags usage);
+        // binds the mesh's buffers and draws it, indexed when it has indices
+        void draw_mesh(VkCommandBuffer cmd, const Vertex_RBG_Normal_Mesh& mesh, const uint32_t first_instance = 0) const;
+
+        // the caller owns outImage
         bool load_image_from_file(const char* file, AllocatedImage& outImage);
+        // sampled R8G8B8A8 sRGB image with level_count mips, filled from the chain in pixels (see Imaging::build_mip_chain); the caller owns outImage
+        bool upload_image(const void* pixels, const size_t bytes, const Imaging::MipLevel* levels, const uint32_t level_count, AllocatedImage& outImage);
+        // the image stays in the engine's pool until destroy_image; null handle on failure
+        ImageHandle load_image(const char* file);
+        void destroy_image(const ImageHandle handle);
+
+        // Async loads: files are read and decoded on the thread pool, uploads happen in
+        // pump_loads. The returned handle or asset is usable at once and shows a placeholder
+        // until the load finishes; a failed load keeps the placeholder.
+        ImageHandle load_image_async(const std::string& file, IO::LoadTicket* out_ticket = nullptr);
+        IO::LoadTicket load_mesh_async(const entt::entity mesh_entity, const std::string& filename);
+
+        // finishes at most max_finishes decoded loads with their uploads in one submit; draw() calls it every frame
+        void pump_loads(const size_t max_finishes = 8);
+        inline IO::AsyncLoader& loader() { return m_loader; }
+        inline const Placeholders& placeholders() const { return m_placeholders; }
+
+        // uploads between these share one command buffer and one wait instead of one per upload
+        void begin_upload_batch();
+        void end_upload_batch();
+
+        // pipelines created between these are built together across the thread pool by
+        // end_pipeline_batch; keep their shader modules alive until it returns
+        void begin_pipeline_batch();
+        void end_pipeline_batch();
+        inline VkPipelineCache pipeline_cache() const { return m_pipeline_cache; }
+
+        inline const GpuResources& gpu_resources() const { return m_gpu; }
+
+        // VK_NULL_HANDLE for null or stale handles
+        inline VkBuffer resolve(const BufferHandle handle) const
+        {
+            const AllocatedBuffer* buffer = m_gpu.buffers.get(handle);
+            return buffer ? buffer->buffer : VK_NULL_HANDLE;
+        }
+        inline VkImage resolve(const ImageHandle handle) const
+        {
+            const AllocatedImage* image = m_gpu.images.get(handle);
+            return image ? image->image : VK_NULL_HANDLE;
+        }
+        inline VkPipeline resolve(const PipelineHandle handle) const
+        {
+            const VkPipeline* pipeline = m_gpu.pipelines.get(handle);
+            return pipeline ? *pipeline : VK_NULL_HANDLE;
+        }
+        inline VkPipelineLayout resolve(const PipelineLayoutHandle handle) const
+        {
+            const VkPipelineLayout* layout = m_gpu.pipeline_layouts.get(handle);
+            return layout ? *layout : VK_NULL_HANDLE;
+        }
 
         inline const Views::AppWindow&          get_window() const          { return window; }
         inline const Views::AppWindow&          get_window()                { return window; }
@@ -66,8 +169,19 @@ namespace Core
         InitDetails                 m_vk_init = {};
         VkRenderPass                m_render_pass;
         FrameData                   m_frames[FRAME_OVERLAP];
-        DeletionQueue               m_mainDeletionQueue; //todo: implement basic garbage collection?
+        DeletionQueue               m_mainDeletionQueue; // objects that live as long as the engine
+        FrameDeletionQueue          m_frameDeletionQueue; // runtime assets, released per frame in draw()
+        GpuResources                m_gpu;
         VmaAllocator                m_allocator; //vma lib allocator
+        IO::AsyncLoader             m_loader;
+        Placeholders                m_placeholders;
+        bool                        b_upload_batch_open{false};
+        std::vector<AllocatedBuffer> m_upload_staging; // freed when the upload batch completes
+        VkPipelineCache             m_pipeline_cache{VK_NULL_HANDLE};
+        std::string                 m_pipeline_cache_path{"pipelines.skpc"};
+        IO::PipelineCacheKey        m_pipeline_cache_key{};
+        bool                        b_pipeline_batch_open{false};
+        std::vector<PendingPipeline> m_pending_pipelines;
         DepthImage                  m_depth_image;
         std::vector<VkFramebuffer>  m_frame_buffers;
         Views::AppWindow            window;
@@ -84,14 +198,26 @@ namespace Core
         } buffer_data;
     
         void init_vulkan();
+        // loads m_pipeline_cache_path when it was written by this device and driver
+        void init_pipeline_cache();
+        void save_pipeline_cache();
         void init_swapchain();
         void init_framebuffers();
         void init_default_renderpass();
         void init_descriptors();
         void init_sync_structures();
         void init_commands();
+        // after init_commands and init_descriptors, before any async load
+        void init_placeholders();
         void upload_mesh(void* mesh_ptr);
 
+        // on_destroy listeners of the GPU asset components: hand their objects to m_frameDeletionQueue
+        void retire_mesh(entt::registry& r, const entt::entity entity);
+        void retire_pipeline(entt::registry& r, const entt::entity entity);
+        void retire_pipeline_layout(entt::registry& r, const entt::entity entity);
+        // hands whatever is still pooled to m_frameDeletionQueue, for shutdown
+        void retire_gpu_resources();
+
     public:
         void cleanup();
 
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SketchBook
+{
+namespace Memory
+{
+    template<typename T>
+    class ArenaAllocator;
+
+    // Bump allocator for data that lives for one frame. Allocation is a pointer bump,
+    // deallocation is a no-op (except for the newest block, which is given back so a growing
+    // vector can reuse it), and reset() frees everything at once.
+    //
+    // When a frame outgrows the arena it chains another block; the next reset() replaces the
+    // chain with one block of the combined size, so after a frame or two a steady workload
+    // never reaches malloc. Not thread safe: one arena per frame, used from the render thread.
+    class FrameArena
+    {
+    public:
+        explicit FrameArena(const size_t initial_capacity = 64 * 1024);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* allocate(const size_t bytes, const size_t alignment = alignof(std::max_align_t));
+
+        // only reclaims the memory if ptr is the newest allocation
+        void deallocate(void* ptr, const size_t bytes);
+
+        // invalidates everything allocated since the last reset
+        void reset();
+
+        template<typename T>
+        std::vector<T, ArenaAllocator<T>> make_vector(const size_t reserve = 0);
+
+        inline size_t used() const { return m_used_before + m_offset; }
+        inline size_t capacity() const { return m_capacity; }
+        inline size_t block_count() const { return m_blocks.size(); }
+        inline size_t high_water() const { return m_high_water; }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        void add_block(const size_t min_bytes);
+
+        std::vector<Block> m_blocks;
+        size_t m_offset{0};         // into m_blocks.back()
+        size_t m_used_before{0};    // bytes handed out from the earlier blocks
+        size_t m_capacity{0};
+        size_t m_high_water{0};
+    };
+
+    // STL allocator over a FrameArena; containers using it must not outlive the frame
+    template<typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+        T* allocate(const size_t count)
+        {
+            return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, const size_t count) noexcept
+        {
+            m_arena->deallocate(ptr, count * sizeof(T));
+        }
+
+        inline FrameArena* arena() const noexcept { return m_arena; }
+
+    private:
+        FrameArena* m_arena;
+    };
+
+    template<typename T, typename U>
+    bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept { return a.arena() == b.arena(); }
+
+    template<typename T, typename U>
+    bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept { return a.arena() != b.arena(); }
+
+    template<typename T>
+    using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    template<typename T>
+    FrameVector<T> FrameArena::make_vector(const size_t reserve)
+    {
+        FrameVector<T> vector{ArenaAllocator<T>(*this)};
+        vector.reserve(reserve);
+        return vector;
+    }
+}
+}
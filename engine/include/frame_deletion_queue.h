@@ -0,0 +1,52 @@
+#pragma once
+
+#include "sk_types.h"
+#include "data_structures.h"
+
+namespace SketchBook
+{
+namespace Core
+{
+    // GPU objects destroyed while frames may still be in flight. Each one is tagged with the
+    // frame number that could last have recorded it and is destroyed once that frame's fence
+    // has signalled, so runtime destruction never waits on the whole device.
+    //
+    // Objects that live as long as the engine stay in EngineVulkanBase::m_mainDeletionQueue.
+    class FrameDeletionQueue
+    {
+    public:
+        void init(VkDevice device, VmaAllocator allocator);
+
+        void retire_buffer(const AllocatedBuffer& buffer, const uint64_t frame)         { m_buffers.push(buffer, frame); }
+        void retire_image(const AllocatedImage& image, const uint64_t frame)            { m_images.push(image, frame); }
+        void retire_image_view(const VkImageView view, const uint64_t frame)            { m_image_views.push(view, frame); }
+        void retire_sampler(const VkSampler sampler, const uint64_t frame)              { m_samplers.push(sampler, frame); }
+        void retire_pipeline(const VkPipeline pipeline, const uint64_t frame)           { m_pipelines.push(pipeline, frame); }
+        void retire_pipeline_layout(const VkPipelineLayout layout, const uint64_t frame){ m_pipeline_layouts.push(layout, frame); }
+        void retire_framebuffer(const VkFramebuffer framebuffer, const uint64_t frame)  { m_framebuffers.push(framebuffer, frame); }
+        void retire_descriptor_pool(const VkDescriptorPool pool, const uint64_t frame)  { m_descriptor_pools.push(pool, frame); }
+
+        // destroys everything retired on or before completed_frame; returns the object count
+        size_t release(const uint64_t completed_frame);
+
+        // destroys everything; only once the device is idle
+        size_t flush();
+
+        size_t size() const;
+
+    private:
+        VkDevice        m_device{VK_NULL_HANDLE};
+        VmaAllocator    m_allocator{VK_NULL_HANDLE};
+
+        // views before images and pipelines before layouts, in case both retire on one frame
+        DataStructures::RetireList<AllocatedBuffer>     m_buffers;
+        DataStructures::RetireList<VkImageView>         m_image_views;
+        DataStructures::RetireList<AllocatedImage>      m_images;
+        DataStructures::RetireList<VkSampler>           m_samplers;
+        DataStructures::RetireList<VkFramebuffer>       m_framebuffers;
+        DataStructures::RetireList<VkPipeline>          m_pipelines;
+        DataStructures::RetireList<VkPipelineLayout>    m_pipeline_layouts;
+        DataStructures::RetireList<VkDescriptorPool>    m_descriptor_pools;
+    };
+}
+}
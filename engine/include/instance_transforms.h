@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SketchBook
+{
+    // [first, last) slot range
+    struct SlotRange
+    {
+        uint32_t first;
+        uint32_t last;
+    };
+
+    // Two-level dirty bitset: one bit per slot, one summary bit per 64 slots, so collecting
+    // the dirty slots costs O(dirty words) and a scene where nothing moved costs nothing.
+    class DirtyRanges
+    {
+    public:
+        // slots past the old size start dirty
+        void resize(const size_t slot_count);
+        void mark(const size_t slot);
+        void mark_all();
+
+        inline size_t size() const { return m_slot_count; }
+        inline bool any() const { return m_dirty_words > 0; }
+
+        // appends the dirty slots as ranges and clears them. Runs separated by at most
+        // max_gap clean slots are merged: one larger copy beats many small ones.
+        void take_ranges(std::vector<SlotRange>& out_ranges, const size_t max_gap = 4);
+
+    private:
+        std::vector<uint64_t> m_words;
+        std::vector<uint64_t> m_summary;
+        size_t m_slot_count{0};
+        size_t m_dirty_words{0};
+    };
+
+    // CPU copy of a GPU instance buffer of matrices. Every frame in flight owns its own
+    // buffer, so each keeps its own dirty set and catches up on what changed since it was
+    // last written. Slot 0 holds the identity for draws that do not use the buffer.
+    class InstanceTransforms
+    {
+    public:
+        InstanceTransforms() { resize(0); }
+
+        // object slots, not counting slot 0
+        void resize(const size_t object_count);
+        inline size_t size() const { return m_matrices.size(); }
+
+        void set(const uint32_t slot, const glm::mat4& matrix);
+        inline const glm::mat4& get(const uint32_t slot) const { return m_matrices[slot]; }
+
+        // e.g. after the GPU buffers were recreated or another scene used them
+        void mark_all_dirty();
+
+        // copies the slots dirty for this frame into dst (the mapped buffer of frame_index) and
+        // returns the bytes written. At most capacity slots are written.
+        size_t upload(const size_t frame_index, const size_t frame_count, void* dst, const size_t capacity);
+
+        // true when frame_index has nothing to upload, so the buffer need not even be mapped
+        bool is_clean(const size_t frame_index, const size_t frame_count) const;
+
+        inline const std::vector<SlotRange>& last_ranges() const { return m_ranges; }
+
+    private:
+        std::vector<glm::mat4> m_matrices;
+        std::vector<DirtyRanges> m_frames;
+        std::vector<SlotRange> m_ranges;
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "sk_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        // .skmesh: a mesh compiled from its source file, laid out so a load is one mapping and
+        // one memcpy per blob into the staging buffer. Blobs start on SKMESH_ALIGNMENT byte
+        // boundaries of the file, so they are just as aligned in the mapping.
+        //
+        // The cache is stale, and ignored, when the source's hash or size, the format version or
+        // the vertex stride differ from the header.
+        constexpr uint32_t SKMESH_VERSION = 3;
+        constexpr uint64_t SKMESH_ALIGNMENT = 256;
+
+        struct SkMeshHeader
+        {
+            char magic[4];              // "SKMH"
+            uint32_t version;
+            uint64_t source_hash;       // hash_bytes of the source file
+            uint64_t source_size;
+            uint32_t vertex_stride;
+            uint32_t vertex_count;
+            uint32_t index_count;       // 0 for unindexed meshes
+            uint32_t index_size;        // 2 or 4 bytes
+            uint64_t vertex_offset;     // from the start of the file
+            uint64_t index_offset;
+            float bounds_min[3];
+            float bounds_max[3];
+        };
+
+        // what write_mesh_cache stores; the pointers are only read during the call
+        struct MeshBlobs
+        {
+            const void* vertices{nullptr};
+            uint32_t vertex_count{0};
+            uint32_t vertex_stride{0};
+            const void* indices{nullptr};
+            uint32_t index_count{0};
+            uint32_t index_size{4};
+            float bounds_min[3]{};
+            float bounds_max[3]{};
+        };
+
+        // 64-bit FNV-1a
+        uint64_t hash_bytes(const void* data, const size_t size);
+
+        // source path with its extension replaced by extension (".skmesh", ".sktex", ...)
+        std::string cache_path(const std::string& source_path, const char* extension);
+
+        // source path with its extension replaced by .skmesh
+        std::string mesh_cache_path(const std::string& source_path);
+
+        bool write_mesh_cache(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const MeshBlobs& blobs);
+
+        // A mapped .skmesh. The data pointers point into the mapping and live as long as the object.
+        class MeshCacheFile
+        {
+        public:
+            // false, leaving nothing mapped, when the file is missing, corrupt or stale
+            bool open(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const uint32_t vertex_stride);
+
+            inline bool is_valid() const { return m_header != nullptr; }
+            inline const SkMeshHeader& header() const { return *m_header; }
+
+            inline const void* vertex_data() const { return m_file.data() + m_header->vertex_offset; }
+            inline size_t vertex_bytes() const { return size_t{m_header->vertex_count} * m_header->vertex_stride; }
+
+            inline const void* index_data() const { return m_file.data() + m_header->index_offset; }
+            inline size_t index_bytes() const { return size_t{m_header->index_count} * m_header->index_size; }
+
+        private:
+            MappedFile m_file;
+            const SkMeshHeader* m_header{nullptr};
+        };
+    }
+}
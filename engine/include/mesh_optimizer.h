@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SketchBook
+{
+namespace MeshOptimizer
+{
+    // Import-time reordering of indexed triangle lists, run once before a mesh is cached.
+    // The usual order is optimize_vertex_cache, optimize_overdraw, optimize_vertex_fetch.
+
+    struct VertexCacheStats
+    {
+        uint32_t transformed{0};    // vertex shader invocations in the simulated cache
+        float acmr{0.f};            // transformed / triangle; 0.5 is ideal for large grids, 3 is worst
+        float atvr{0.f};            // transformed / referenced vertex; 1 is ideal
+    };
+
+    // simulates a FIFO post-transform cache of cache_size entries
+    VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t>& indices, const size_t vertex_count, const uint32_t cache_size = 16);
+
+    // Forsyth's linear-speed vertex cache optimisation: greedily emits the triangle whose
+    // vertices score best for an LRU cache of 32. Reorders triangles only.
+    void optimize_vertex_cache(std::vector<uint32_t>& indices, const size_t vertex_count);
+
+    // Splits the cache-optimised order into clusters where the cache restarts anyway and sorts
+    // them to draw outward facing ones first, so more occluded pixels fail the depth test.
+    // Keeps the input order if that would raise ACMR above threshold times the input's.
+    // positions: x, y, z floats of vertex i at (const char*)positions + i * stride.
+    void optimize_overdraw(std::vector<uint32_t>& indices, const float* positions, const size_t stride, const size_t vertex_count, const float threshold = 1.05f);
+
+    // fills remap[old vertex] = new vertex in first-use order (UINT32_MAX for unused ones)
+    // and rewrites indices; returns the number of used vertices
+    size_t build_fetch_remap(std::vector<uint32_t>& indices, const size_t vertex_count, std::vector<uint32_t>& remap);
+
+    // orders vertices by first use so fetches walk memory forward; drops unused vertices
+    template<typename Vertex>
+    void optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        std::vector<uint32_t> remap;
+        const size_t used = build_fetch_remap(indices, vertices.size(), remap);
+
+        std::vector<Vertex> reordered(used);
+        for (size_t v = 0; v < vertices.size(); v++)
+        {
+            if (remap[v] != UINT32_MAX) reordered[remap[v]] = vertices[v];
+        }
+        vertices.swap(reordered);
+    }
+}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "sk_threads.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SketchBook
+{
+    namespace Imaging
+    {
+        // enough for a 32768 x 32768 image
+        constexpr uint32_t MAX_MIP_LEVELS = 16;
+
+        // one level of an RGBA8 mip chain stored back to back in one buffer
+        struct MipLevel
+        {
+            uint32_t width;
+            uint32_t height;
+            uint64_t offset;    // bytes from the start of the chain
+            uint64_t bytes;
+        };
+
+        // levels down to 1 x 1, at most MAX_MIP_LEVELS
+        uint32_t mip_level_count(const uint32_t width, const uint32_t height);
+
+        // Halves src (RGBA8) into dst with a 2x2 box filter; odd edges repeat their last texel.
+        // With b_srgb the color channels are averaged in linear light and alpha as is, so a
+        // minified texture keeps its brightness. Rows [first_row, last_row) of dst are written.
+        void downsample(const uint8_t* src, const uint32_t src_width, const uint32_t src_height,
+            uint8_t* dst, const uint32_t dst_width, const bool b_srgb, const uint32_t first_row, const uint32_t last_row);
+
+        // Copies rgba as level 0 and filters every further level from the one above into
+        // out_pixels; large levels are split across the pool by rows.
+        void build_mip_chain(const uint8_t* rgba, const uint32_t width, const uint32_t height, const bool b_srgb,
+            std::vector<uint8_t>& out_pixels, std::vector<MipLevel>& out_levels, Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sk_threads.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        // 0-based attribute indices of one face corner, -1 when the corner has none
+        struct ObjIndex
+        {
+            int32_t position;
+            int32_t texcoord;
+            int32_t normal;
+        };
+
+        struct ObjData
+        {
+            std::vector<float> positions;       // x, y, z
+            std::vector<float> texcoords;       // u, v
+            std::vector<float> normals;         // x, y, z
+            std::vector<ObjIndex> indices;      // 3 per triangle
+        };
+
+        // Parallel OBJ parser for the geometry subset the engine uses: v, vt, vn and f.
+        // Everything else (o, g, s, usemtl, mtllib, comments) is skipped. Polygons are fan
+        // triangulated and negative (relative) indices are resolved.
+        //
+        // The text is split at line boundaries into one chunk per worker; each chunk parses into
+        // its own arrays, prefix sums over the chunk counts give every chunk its place in the
+        // output, and the chunks are copied there in parallel.
+        bool parse_obj(const char* text, const size_t size, ObjData& out, Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+
+        // memory maps path and parses it
+        bool load_obj(const std::string& path, ObjData& out, Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sk_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        // .skpc: VkPipelineCache data saved at shutdown and fed back to vkCreatePipelineCache at
+        // startup, so the driver skips compiling shaders it has compiled before. The data is only
+        // valid for the device and driver that produced it, so they key the file.
+        constexpr uint32_t SKPC_VERSION = 1;
+
+        // from VkPhysicalDeviceProperties
+        struct PipelineCacheKey
+        {
+            uint32_t vendor_id;
+            uint32_t device_id;
+            uint32_t driver_version;
+            uint8_t cache_uuid[16];     // pipelineCacheUUID
+        };
+
+        struct SkPipelineCacheHeader
+        {
+            char magic[4];              // "SKPC"
+            uint32_t version;
+            PipelineCacheKey key;
+            uint64_t data_size;         // follows the header
+            uint64_t data_hash;         // hash_bytes of the data
+        };
+
+        bool write_pipeline_cache(const std::string& path, const PipelineCacheKey& key, const void* data, const size_t size);
+
+        // false, with out_data empty, when the file is missing, corrupt or from another device or driver
+        bool read_pipeline_cache(const std::string& path, const PipelineCacheKey& key, std::vector<uint8_t>& out_data);
+    }
+}
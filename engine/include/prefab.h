@@ -0,0 +1,112 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+namespace SketchBook
+{
+    // Per-instance component values for one Prefab::instantiate call.
+    // Each array must hold one value per spawned entity and outlive the call.
+    class PrefabOverrides
+    {
+    public:
+        template<typename Component>
+        PrefabOverrides& set(const Component* values)
+        {
+            m_values.insert_or_assign(entt::type_hash<Component>::value(), static_cast<const void*>(values));
+            return *this;
+        }
+
+        const void* find(const entt::id_type type) const
+        {
+            const auto it = m_values.find(type);
+            return (it == m_values.end()) ? nullptr : it->second;
+        }
+
+        size_t size() const { return m_values.size(); }
+
+    private:
+        entt::dense_map<entt::id_type, const void*, entt::identity> m_values;
+    };
+
+    // A set of component values stamped onto many entities at once.
+    // Instantiating creates the whole range of entities in one call, then fills each
+    // component storage in one reserve + insert, so the per-entity cost is a copy of
+    // each component. For trivially copyable components that copy is a plain memcpy.
+    class Prefab
+    {
+    public:
+        template<typename Component>
+        Prefab& set(const Component& value = {})
+        {
+            static_assert(std::is_copy_constructible_v<Component>, "prefab components are copied into every instance");
+
+            const entt::id_type type = entt::type_hash<Component>::value();
+            Stamp stamp{type, [value](entt::registry& r, const entt::entity* first, const entt::entity* last, const void* overrides) {
+                auto& storage = r.storage<Component>();
+                storage.reserve(storage.size() + static_cast<size_t>(last - first));
+                if (overrides)
+                {
+                    r.insert<Component>(first, last, static_cast<const Component*>(overrides));
+                }
+                else
+                {
+                    r.insert<Component>(first, last, value);
+                }
+            }};
+
+            for (Stamp& existing : m_stamps)
+            {
+                if (existing.type == type)
+                {
+                    existing = std::move(stamp);
+                    return *this;
+                }
+            }
+            m_stamps.push_back(std::move(stamp));
+            return *this;
+        }
+
+        size_t component_count() const { return m_stamps.size(); }
+
+        // creates count entities and appends them to out_entities
+        void instantiate(entt::registry& registry, const size_t count, std::vector<entt::entity>& out_entities, const PrefabOverrides& overrides = {}) const
+        {
+            if (count == 0) return;
+
+            const size_t first = out_entities.size();
+            out_entities.resize(first + count);
+            registry.create(out_entities.begin() + first, out_entities.end());
+
+            const entt::entity* begin = out_entities.data() + first;
+            const entt::entity* end = begin + count;
+
+            size_t used_overrides = 0;
+            for (const Stamp& stamp : m_stamps)
+            {
+                const void* values = overrides.find(stamp.type);
+                used_overrides += (values != nullptr);
+                stamp.apply(registry, begin, end, values);
+            }
+
+            if (used_overrides != overrides.size())
+            {
+                spdlog::warn("prefab instantiate ignored {} override(s) for components the prefab does not have", overrides.size() - used_overrides);
+            }
+        }
+
+    private:
+        // one type-erased call per component type and batch, never per entity
+        struct Stamp
+        {
+            entt::id_type type;
+            std::function<void(entt::registry& r, const entt::entity* first, const entt::entity* last, const void* overrides)> apply;
+        };
+
+        std::vector<Stamp> m_stamps;
+    };
+}
@@ -4,13 +4,34 @@
 #include <sk_types.h>
 #include <functional>
 
+#include "asset_id.h"
+#include "prefab.h"
+#include "snapshot.h"
+#include "world/kinematics.h"
+#include "spdlog/spdlog.h"
+
 namespace SketchBook
 {
+    // name id -> entity for one asset component type, kept in the asset registry's context
+    template<typename Asset>
+    struct AssetIndex
+    {
+        entt::dense_map<AssetId, entt::entity, entt::identity> entities;
+    };
+
+    // object components written by Registry::save_objects; a change here invalidates old snapshots
+    using ObjectSnapshotComponents = entt::type_list<
+        World::Kinematics::Position,
+        World::Kinematics::Velocity,
+        World::Kinematics::Heading,
+        World::Kinematics::MotionLimits>;
+
     class Registry
     {
     protected:
         entt::registry m_assets;
         entt::registry m_objects;
+        uint64_t m_asset_version{0};
 
     public:
         entt::entity create_asset(std::function<void(entt::registry& r, const entt::entity &entity)> asset_callback)
@@ -27,6 +48,105 @@ namespace SketchBook
             return entity;
         }      
 
+        // count copies of prefab in one batch, see Prefab::instantiate
+        void instantiate_objects(const Prefab& prefab, const size_t count, std::vector<entt::entity>& out_entities, const PrefabOverrides& overrides = {})
+        {
+            prefab.instantiate(m_objects, count, out_entities, overrides);
+        }
+
+        // agent with Position, Velocity, Heading and MotionLimits, see World::Kinematics
+        entt::entity create_kinematic_object(const float x, const float y)
+        {
+            return World::Kinematics::create(m_objects, x, y);
+        }
+
+        // makes an asset findable by name id; the newest asset with a name wins
+        template<typename Asset>
+        void index_asset(const AssetKey& key, const entt::entity entity)
+        {
+            auto& index = m_assets.ctx().emplace<AssetIndex<Asset>>().entities;
+            if (auto it = index.find(key.id); it != index.end() && it->second != entity)
+            {
+                const Asset* existing = m_assets.try_get<Asset>(it->second);
+                if (existing && existing->name != key.name)
+                {
+                    spdlog::error("asset id collision between \"{}\" and \"{}\"", existing->name, key.name);
+                }
+                else
+                {
+                    spdlog::warn("asset \"{}\" redefined", key.name);
+                }
+            }
+            index.insert_or_assign(key.id, entity);
+            ++m_asset_version;
+        }
+
+        // unindexes and destroys the asset; GPU objects are released by the engine's on_destroy listeners
+        template<typename Asset>
+        bool destroy_asset(const AssetId id)
+        {
+            auto* index = m_assets.ctx().find<AssetIndex<Asset>>();
+            if (!index) return false;
+
+            const auto it = index->entities.find(id);
+            if (it == index->entities.end()) return false;
+
+            const entt::entity entity = it->second;
+            index->entities.erase(it);
+            if (m_assets.valid(entity)) m_assets.destroy(entity);
+            ++m_asset_version;
+            return true;
+        }
+
+        // bumped whenever an indexed asset is added, replaced or destroyed
+        uint64_t asset_version() const { return m_asset_version; }
+
+        // for assets changed in place, e.g. an async load replacing its placeholder
+        void touch_assets() { ++m_asset_version; }
+
+        // O(1), no allocation; nullptr when nothing is indexed under id
+        template<typename Asset>
+        Asset* find_asset(const AssetId id)
+        {
+            const auto* index = m_assets.ctx().find<AssetIndex<Asset>>();
+            if (!index) return nullptr;
+
+            const auto it = index->entities.find(id);
+            return (it == index->entities.end()) ? nullptr : m_assets.try_get<Asset>(it->second);
+        }
+
+        // binary snapshot of the object registry, see snapshot.h
+        bool save_objects(const std::string& path) const
+        {
+            return save_snapshot(m_objects, path, ObjectSnapshotComponents{});
+        }
+
+        // replaces every object with the snapshot's
+        bool load_objects(const std::string& path)
+        {
+            m_objects.clear();
+            return load_snapshot(m_objects, path, ObjectSnapshotComponents{});
+        }
+
+        // CPU side assets only (materials); GPU assets are rebuilt by the engine
+        template<typename... Assets>
+        bool save_assets(const std::string& path) const
+        {
+            return save_snapshot<Assets...>(m_assets, path);
+        }
+
+        // adds the snapshot's assets next to the existing ones and indexes them by name
+        template<typename... Assets>
+        bool merge_assets(const std::string& path)
+        {
+            if (!merge_snapshot<Assets...>(m_assets, path)) return false;
+
+            (m_assets.view<Assets>().each([this](const entt::entity entity, const Assets& asset) {
+                index_asset<Assets>(AssetKey{asset.name}, entity);
+            }), ...);
+            return true;
+        }
+
         entt::registry& get_assets() { return m_assets; }
         entt::registry& get_objects() { return m_objects; }
     };
@@ -6,6 +6,7 @@
 #include "glm/mat4x4.hpp"
 #include "imgui.h"
 #include "world/world.h"
+#include "instance_transforms.h"
 #include <memory>
 
 namespace SketchBook
@@ -45,11 +46,37 @@ namespace Components
         bool b_should_render{false};
         std::shared_ptr<SketchBook::World::Simulation> m_sim = nullptr;
         std::vector<RenderObject> render_objects;
+
+        // compiled from render_objects by the engine, see Engine::compile_draw_records
+        std::vector<DrawRecord> draw_records;
+        std::vector<MeshPushConstants> draw_constants;     // per instance slot; only the color is used
+        InstanceTransforms transforms;                     // slot i + 1 is render object i
+        uint64_t draw_records_version{0};                 // asset version they were resolved against
+        bool b_draw_records_dirty{true};
         std::vector<FreeCamera> free_cameras;
         int free_camera_index{-1};
 
         std::function<void(const float delta)> render = nullptr;
 
+        void add_render_object(const RenderObject& object)
+        {
+            render_objects.push_back(object);
+            b_draw_records_dirty = true;
+        }
+
+        // call after changing which objects render, or their mesh or material
+        void mark_render_objects_dirty() { b_draw_records_dirty = true; }
+
+        // moves an object without recompiling its draw record; only its matrix is uploaded again
+        void set_model_matrix(const size_t object_index, const ModelMatrix& model_matrix)
+        {
+            render_objects[object_index].model_matrix = model_matrix;
+            if (object_index + 1 < transforms.size())
+            {
+                transforms.set(static_cast<uint32_t>(object_index + 1), model_matrix.render_matrix());
+            }
+        }
+
         FreeCamera* current_camera()
         {
             if (free_cameras.size() > 0 && (free_camera_index > -1))
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <algorithm>
 
 #include "sk_types.h"
 #include "sk_initializers.h"
@@ -62,7 +63,9 @@ namespace SketchBook
 
         void set_scene(const entt::entity scene_entity)
         {
-            m_current_scene = registry.get_assets().get<BaseScene>(scene_entity);
+            m_current_scene = &registry.get_assets().get<BaseScene>(scene_entity);
+            // the instance buffers still hold the previous scene's matrices
+            m_current_scene->transforms.mark_all_dirty();
         }
 
         void set_scene(const std::string scene_name)
@@ -74,6 +77,7 @@ namespace SketchBook
                 if (scene.name == scene_name)
                 {
                     m_current_scene = &scene;
+                    m_current_scene->transforms.mark_all_dirty();
                     return;
                 }
             }
@@ -266,77 +270,56 @@ namespace SketchBook
             }
         }
 
-        Components::Pipeline* get_pipeline(const std::string name)
-        {
-            const auto view = registry.get_assets().view<Components::Pipeline>();
-            for (auto &entity: view)
-            {
-                auto &pipeline = view.get<Components::Pipeline>(entity);
-                if (pipeline.name == name) return &pipeline;
-            }
-            return nullptr;
-        }
+        // name lookups go through the registry's id index: O(1) and allocation free.
+        // Pass constexpr AssetKeys or stored ids on per-frame paths so nothing is hashed either.
 
-        Components::PipelineLayout* get_pipeline_layout(const std::string name)
-        {
-            const auto view = registry.get_assets().view<Components::PipelineLayout>();
-            for (auto &entity: view)
-            {
-                auto &layout = view.get<Components::PipelineLayout>(entity);
-                if (layout.name == name) return &layout;
-            }
-            return nullptr;
-        }
+        Components::Pipeline* get_pipeline(const AssetId id) { return registry.find_asset<Components::Pipeline>(id); }
+        Components::Pipeline* get_pipeline(const AssetKey& key) { return get_pipeline(key.id); }
 
-        Components::Material* get_material(const std::string &name)
-        {
-            const auto view = registry.get_assets().view<Components::Material>();
-            for (auto &entity: view)
-            {
-                auto &material = view.get<Components::Material>(entity);
-                if (material.name == name) return &material;
-            }
-            return nullptr;
-        }
+        Components::PipelineLayout* get_pipeline_layout(const AssetId id) { return registry.find_asset<Components::PipelineLayout>(id); }
+        Components::PipelineLayout* get_pipeline_layout(const AssetKey& key) { return get_pipeline_layout(key.id); }
 
-        Components::Mesh* get_mesh(const std::string &name)
-        {
-            const auto view = registry.get_assets().view<Components::Mesh>();
-            for (auto &entity: view)
-            {
-                auto &mesh = view.get<Components::Mesh>(entity);
-                if (mesh.name == name) return &mesh;
-            }
-            return nullptr;
-        }
+        Components::Material* get_material(const AssetId id) { return registry.find_asset<Components::Material>(id); }
+        Components::Material* get_material(const AssetKey& key) { return get_material(key.id); }
+
+        Components::Mesh* get_mesh(const AssetId id) { return registry.find_asset<Components::Mesh>(id); }
+        Components::Mesh* get_mesh(const AssetKey& key) { return get_mesh(key.id); }
+
+        // the GPU objects are freed a few frames later, once no frame in flight can still use them
+        bool destroy_mesh(const AssetKey& key) { return registry.destroy_asset<Components::Mesh>(key.id); }
+        bool destroy_pipeline(const AssetKey& key) { return registry.destroy_asset<Components::Pipeline>(key.id); }
+        bool destroy_pipeline_layout(const AssetKey& key) { return registry.destroy_asset<Components::PipelineLayout>(key.id); }
 
-        void create_pipeline_layout(const std::string name, std::function<void(VkPipelineLayoutCreateInfo& info)> create_layout_callback = [](VkPipelineLayoutCreateInfo& info){})
+        void create_pipeline_layout(const AssetKey& key, std::function<void(VkPipelineLayoutCreateInfo& info)> create_layout_callback = [](VkPipelineLayoutCreateInfo& info){})
         {
-            registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
+            const std::string name = key.str();
+            const entt::entity layout_entity = registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
                 VkPipelineLayoutCreateInfo create_info = SketchBook::VkInit::pipeline_layout_create_info();
                 create_layout_callback(create_info);
+                VkPipelineLayout pipeline_layout;
+                VK_CHECK(vkCreatePipelineLayout(vk_init().device, &create_info, nullptr, &pipeline_layout));
+
                 Components::PipelineLayout& layout = r.emplace<Components::PipelineLayout>(entity);
                 layout.name = name;
-                VK_CHECK(vkCreatePipelineLayout(vk_init().device, &create_info, nullptr, &layout.pipeline_layout));
-      
-                m_mainDeletionQueue.push([=]() {
-                    vkDestroyPipelineLayout(vk_init().device, layout.pipeline_layout, nullptr);
-                });
+                layout.pipeline_layout = m_gpu.pipeline_layouts.insert(pipeline_layout);
             });
+            registry.index_asset<Components::PipelineLayout>(key, layout_entity);
         }
 
         void create_pipeline(
-            const std::string name, 
-            const std::string pipeline_layout_name, 
+            const AssetKey& key, 
+            const AssetKey& pipeline_layout_key, 
             VkShaderModule& vert_shader, 
             VkShaderModule& fragment_shader, 
             VkPrimitiveTopology topology, 
             VkPolygonMode polygon_mode,
             std::function<void(SketchBook::Core::PipelineBuilder& builder)> builder_callback = [](SketchBook::Core::PipelineBuilder& builder){})
         {
-            Components::PipelineLayout* layout = get_pipeline_layout(pipeline_layout_name);
+            const Components::PipelineLayout* layout = get_pipeline_layout(pipeline_layout_key);
+            const VkPipelineLayout pipeline_layout = layout ? resolve(layout->pipeline_layout) : VK_NULL_HANDLE;
+            const std::string name = key.str();
 
-            registry.create_asset([=](entt::registry&r, const entt::entity& entity){
+            const entt::entity pipeline_entity = registry.create_asset([=](entt::registry&r, const entt::entity& entity){
 
                 SketchBook::Core::PipelineBuilder pipelineBuilder;
                 pipelineBuilder._depthStencil = SketchBook::VkInit::depth_stencil_create_info(true, true, VK_COMPARE_OP_LESS_OR_EQUAL);
@@ -377,46 +360,77 @@ namespace SketchBook
                 pipelineBuilder._shaderStages.push_back(
                     SketchBook::VkInit::pipeline_shader_stage_create_info(VK_SHADER_STAGE_FRAGMENT_BIT, fragment_shader));
 
-                pipelineBuilder._pipelineLayout = layout->pipeline_layout;
+                pipelineBuilder._pipelineLayout = pipeline_layout;
 
                 Components::Pipeline &pipeline = r.emplace<Components::Pipeline>(entity);
                 pipeline.name = name;
                 spdlog::info("internal:allocated pipeline");
-                pipeline.pipeline = pipelineBuilder.build_pipeline(vk_init().device, m_render_pass);
+                if (b_pipeline_batch_open)
+                {
+                    // the handle is filled in by end_pipeline_batch
+                    m_pending_pipelines.push_back(Core::PendingPipeline{entity, pipelineBuilder});
+                    return;
+                }
+                pipeline.pipeline = m_gpu.pipelines.insert(pipelineBuilder.build_pipeline(vk_init().device, m_render_pass, m_pipeline_cache));
                 spdlog::info("internal:created pipeline");
-                m_mainDeletionQueue.push([=]() {
-                    vkDestroyPipeline(vk_init().device, pipeline.pipeline, nullptr);
-                });
-
             });
+            registry.index_asset<Components::Pipeline>(key, pipeline_entity);
         }
 
 
-        entt::entity create_material(const std::string name, const std::string pipeline_name, const std::string pipeline_layout_name)
+        entt::entity create_material(const AssetKey& key, const AssetKey& pipeline_key, const AssetKey& pipeline_layout_key)
         {
-            return registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
+            const std::string name = key.str();
+            const std::string pipeline_name = pipeline_key.str();
+            const std::string pipeline_layout_name = pipeline_layout_key.str();
+            const AssetId pipeline_id = pipeline_key.id;
+            const AssetId pipeline_layout_id = pipeline_layout_key.id;
+
+            const entt::entity material_entity = registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
                 Components::Material &material = r.emplace<Components::Material>(entity);
                 material.name = name;
                 material.pipeline_name = pipeline_name;
                 material.pipeline_layout_name = pipeline_layout_name;
+                material.pipeline_id = pipeline_id;
+                material.pipeline_layout_id = pipeline_layout_id;
             });
+            registry.index_asset<Components::Material>(key, material_entity);
+            return material_entity;
         }
 
-        entt::entity create_mesh(const std::string name, std::function<void(Vertex_RBG_Normal_Mesh* mesh)> mesh_callback)
+        entt::entity create_mesh(const AssetKey& key, std::function<void(Vertex_RBG_Normal_Mesh* mesh)> mesh_callback)
         {
-            return registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
+            const std::string name = key.str();
+            const entt::entity mesh_entity = registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
                 Components::Mesh &mesh_comp = r.emplace<Components::Mesh>(entity);
                 mesh_comp.name = name;
                 mesh_callback(&mesh_comp.mesh);
                 upload_mesh((void*)&mesh_comp.mesh);
             });
+            registry.index_asset<Components::Mesh>(key, mesh_entity);
+            return mesh_entity;
+        }
+
+        entt::entity create_mesh_from_file(const AssetKey& key, const std::string filename)
+        {
+            return create_mesh(key, [&,filename](Vertex_RBG_Normal_Mesh* mesh){
+                load_mesh(filename.c_str(), mesh);
+            });
         }
 
-        entt::entity create_mesh_from_file(const std::string name, const std::string filename)
+        // the mesh asset exists at once and draws the placeholder until the file is decoded on the
+        // thread pool and uploaded by pump_loads; a failed load keeps the placeholder
+        IO::LoadTicket create_mesh_from_file_async(const AssetKey& key, const std::string filename)
         {
-            return create_mesh(name, [&,filename](Vertex_RBG_Normal_Mesh* mesh){
-                load_mesh_from_obj_file(filename.c_str(), mesh);
+            const std::string name = key.str();
+            const entt::entity mesh_entity = registry.create_asset([=](entt::registry&r, const entt::entity& entity) mutable {
+                Components::Mesh &mesh_comp = r.emplace<Components::Mesh>(entity);
+                mesh_comp.name = name;
+                mesh_comp.mesh = placeholders().mesh;
+                mesh_comp.b_placeholder = true;
             });
+            registry.index_asset<Components::Mesh>(key, mesh_entity);
+            return load_mesh_async(mesh_entity, filename);
         }
 
         entt::entity create_scene(const std::string name, std::function<void(BaseScene* scene)> scene_callback)
@@ -428,6 +442,118 @@ namespace SketchBook
             });
         }
 
+        // Resolves the scene's render objects into draw records. Does nothing unless the render
+        // objects were marked dirty or an indexed asset was added or replaced since the last compile.
+        void compile_draw_records(BaseScene* scene)
+        {
+            if (!scene->b_draw_records_dirty && scene->draw_records_version == registry.asset_version()) return;
+
+            scene->draw_records.clear();
+            scene->draw_constants.resize(scene->render_objects.size() + 1);
+            scene->transforms.resize(scene->render_objects.size());
+
+            Memory::FrameVector<DrawRecord> records = frame_arena().make_vector<DrawRecord>(scene->render_objects.size());
+
+            for (uint32_t i = 0; i < scene->render_objects.size(); i++)
+            {
+                const RenderObject& obj = scene->render_objects[i];
+                const uint32_t slot = i + 1;
+                scene->draw_constants[slot].render_matrix = glm::mat4(1.f);
+                scene->draw_constants[slot].normal_color = obj.normal_color;
+                scene->transforms.set(slot, obj.model_matrix.render_matrix());
+                if (!obj.b_should_render) continue;
+                if (slot >= Core::MAX_INSTANCES)
+                {
+                    spdlog::warn("render object \"{}\" skipped -- more than {} instances", obj.name, Core::MAX_INSTANCES - 1);
+                    continue;
+                }
+
+                const Components::Material* material = get_material(obj.material_name);
+                const Components::Mesh* mesh = get_mesh(obj.mesh_name);
+                const Components::Pipeline* pipeline = material ? get_pipeline(material->pipeline_id) : nullptr;
+                const Components::PipelineLayout* layout = material ? get_pipeline_layout(material->pipeline_layout_id) : nullptr;
+                DrawRecord record;
+                record.pipeline = pipeline ? resolve(pipeline->pipeline) : VK_NULL_HANDLE;
+                record.pipeline_layout = layout ? resolve(layout->pipeline_layout) : VK_NULL_HANDLE;
+                record.vertex_buffer = mesh ? resolve(mesh->mesh.vertex_buffer) : VK_NULL_HANDLE;
+                if (record.pipeline == VK_NULL_HANDLE || record.pipeline_layout == VK_NULL_HANDLE || record.vertex_buffer == VK_NULL_HANDLE)
+                {
+                    spdlog::warn("render object \"{}\" skipped -- material \"{}\" or mesh \"{}\" is not loaded", obj.name, obj.material_name, obj.mesh_name);
+                    continue;
+                }
+                record.vertex_count = mesh->mesh.vertex_count;
+                record.index_buffer = (mesh->mesh.index_count > 0) ? resolve(mesh->mesh.index_buffer) : VK_NULL_HANDLE;
+                record.index_type = mesh->mesh.index_type;
+                record.index_count = mesh->mesh.index_count;
+                record.transform_index = slot;
+                records.push_back(record);
+            }
+
+            // group by pipeline so binds only happen on a change; the slot keeps the order stable
+            // without the temporary buffer std::stable_sort would allocate
+            std::sort(records.begin(), records.end(), [](const DrawRecord& a, const DrawRecord& b) {
+                return (a.pipeline != b.pipeline) ? (a.pipeline < b.pipeline) : (a.transform_index < b.transform_index);
+            });
+            scene->draw_records.assign(records.begin(), records.end());
+
+            scene->draw_records_version = registry.asset_version();
+            scene->b_draw_records_dirty = false;
+        }
+
+        void record_draws(const BaseScene* scene, VkCommandBuffer cmd)
+        {
+            VkPipeline bound_pipeline = VK_NULL_HANDLE;
+            VkPipelineLayout bound_layout = VK_NULL_HANDLE;
+            VkBuffer bound_vertex_buffer = VK_NULL_HANDLE;
+            VkBuffer bound_index_buffer = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+
+            for (const DrawRecord& record : scene->draw_records)
+            {
+                if (record.pipeline != bound_pipeline)
+                {
+                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, record.pipeline);
+                    bound_pipeline = record.pipeline;
+                }
+                if (record.pipeline_layout != bound_layout)
+                {
+                    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, record.pipeline_layout, 0, 1, &get_current_frame().global_descriptor, 0, nullptr);
+                    bound_layout = record.pipeline_layout;
+                }
+                if (record.vertex_buffer != bound_vertex_buffer)
+                {
+                    vkCmdBindVertexBuffers(cmd, 0, 1, &record.vertex_buffer, &offset);
+                    bound_vertex_buffer = record.vertex_buffer;
+                }
+                vkCmdPushConstants(cmd, record.pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &scene->draw_constants[record.transform_index]);
+                if (record.index_buffer != VK_NULL_HANDLE)
+                {
+                    if (record.index_buffer != bound_index_buffer)
+                    {
+                        vkCmdBindIndexBuffer(cmd, record.index_buffer, 0, record.index_type);
+                        bound_index_buffer = record.index_buffer;
+                    }
+                    vkCmdDrawIndexed(cmd, record.index_count, 1, 0, 0, record.transform_index);
+                }
+                else
+                {
+                    vkCmdDraw(cmd, record.vertex_count, 1, 0, record.transform_index);
+                }
+            }
+        }
+
+        // writes only the matrices that changed since this frame's buffer was last written
+        void upload_instance_transforms(BaseScene* scene)
+        {
+            const size_t frame = m_frameNumber % Core::FRAME_OVERLAP;
+            if (scene->transforms.is_clean(frame, Core::FRAME_OVERLAP)) return;
+
+            void* data;
+            vmaMapMemory(m_allocator, get_current_frame().instance_buffer.allocation, &data);
+            scene->transforms.upload(frame, Core::FRAME_OVERLAP, data, Core::MAX_INSTANCES);
+            vmaUnmapMemory(m_allocator, get_current_frame().instance_buffer.allocation);
+        }
+
         void draw()
         {
             // spdlog::info("calling draw function");
@@ -436,6 +562,17 @@ namespace SketchBook
             VK_CHECK(vkWaitForFences(m_vk_init.device, 1, &get_current_frame().render_fence, true, 1000000000));
             VK_CHECK(vkResetFences(m_vk_init.device, 1, &get_current_frame().render_fence));
 
+            get_current_frame().arena.reset();
+
+            // that fence was signalled by frame m_frameNumber - FRAME_OVERLAP and frames finish in order
+            if (m_frameNumber >= static_cast<int>(Core::FRAME_OVERLAP))
+            {
+                m_frameDeletionQueue.release(m_frameNumber - Core::FRAME_OVERLAP);
+            }
+
+            // swaps finished async loads in for their placeholders before this frame compiles its draws
+            pump_loads();
+
             //request image from the swapchain, one second timeout
             uint32_t swapchainImageIndex;
             VK_CHECK(vkAcquireNextImageKHR(m_vk_init.device, m_vk_init.swapchain, 1000000000, get_current_frame().present_semaphore, nullptr, &swapchainImageIndex));
@@ -513,7 +650,13 @@ namespace SketchBook
 
                     auto current_time = std::chrono::system_clock::now();
                     auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>((current_time-m_time_last_frame));
-                    m_current_scene->render(duration_ms.count()/1000.f);
+                    compile_draw_records(m_current_scene);
+                    upload_instance_transforms(m_current_scene);
+                    record_draws(m_current_scene, cmd);
+                    if (m_current_scene->render)
+                    {
+                        m_current_scene->render(duration_ms.count()/1000.f);
+                    }
                     m_time_last_frame = current_time;
                 }
             }
@@ -48,7 +48,8 @@ namespace Core
 		VkPipelineLayout _pipelineLayout;
 		VkPipelineDepthStencilStateCreateInfo _depthStencil;
 
-		VkPipeline build_pipeline(VkDevice device, VkRenderPass pass);
+		// thread safe: builders may run concurrently, sharing one cache
+		VkPipeline build_pipeline(VkDevice device, VkRenderPass pass, VkPipelineCache cache = VK_NULL_HANDLE);
 	};
 
 	struct UploadContext {
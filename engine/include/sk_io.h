@@ -2,11 +2,61 @@
 
 #include "tiny_obj_loader.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
 namespace SketchBook
 {
     namespace IO
     {
         using tinyobj::LoadObj;
+
+        // Read-only memory mapping of a whole file. The mapping is released with the
+        // object; an empty or missing file leaves it invalid.
+        class MappedFile
+        {
+        public:
+            MappedFile() = default;
+            explicit MappedFile(const std::string& path) { open(path); }
+            ~MappedFile() { close(); }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+            MappedFile& operator=(MappedFile&& other) noexcept;
+
+            bool open(const std::string& path);
+            void close();
+
+            // touches every page so later reads do not fault on the calling thread
+            void prefault() const;
+
+            inline bool is_valid() const { return m_data != nullptr; }
+            inline const uint8_t* data() const { return m_data; }
+            inline size_t size() const { return m_size; }
+
+        private:
+            const uint8_t* m_data{nullptr};
+            size_t m_size{0};
+#ifdef _WIN32
+            void* m_file{nullptr};
+            void* m_mapping{nullptr};
+#else
+            int m_fd{-1};
+#endif
+        };
+
+        // true when count items of stride bytes starting at offset lie inside a file of size bytes;
+        // checked without forming offset + count * stride, so values read from a corrupt header cannot wrap
+        inline bool range_fits(const uint64_t offset, const uint64_t count, const uint64_t stride, const uint64_t size)
+        {
+            return offset <= size && (stride == 0 || count <= (size - offset) / stride);
+        }
+
+        // writes the buffer to a uniquely named temporary file and swaps it over path,
+        // so readers never map a partial file and concurrent writers do not collide
+        bool write_file(const std::string& path, const void* data, const size_t size);
     }
 }
-
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace SketchBook
+{
+namespace Threading
+{
+    // Fixed-size worker pool shared by the sim and asset systems.
+    // Tasks are plain FIFO; parallel_for lets the calling thread take chunks
+    // too, so it is safe to call from inside a pool task.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t thread_count = default_thread_count());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        static ThreadPool& shared();
+        static size_t default_thread_count();
+
+        inline size_t thread_count() const { return m_workers.size(); }
+
+        // 1 + worker index on this pool's workers, 0 on any other thread
+        size_t worker_slot() const;
+
+        // runs f on a worker; on a pool without workers it runs inline before returning
+        template<typename F>
+        auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+            std::future<Result> future = task->get_future();
+            if (m_workers.empty())
+            {
+                // nobody would ever pick it up; run it now, like parallel_for does
+                (*task)();
+                return future;
+            }
+            enqueue([task]() { (*task)(); });
+            return future;
+        }
+
+        // f(first, last) is called for consecutive [first, last) ranges of at most grain items;
+        // if f throws, the remaining chunks still run and the first exception is rethrown here
+        template<typename F>
+        void parallel_for(const size_t begin, const size_t end, size_t grain, F&& f)
+        {
+            if (end <= begin) return;
+            grain = std::max<size_t>(grain, 1);
+            const size_t chunk_count = (end - begin + grain - 1) / grain;
+
+            if (chunk_count == 1 || m_workers.empty())
+            {
+                // same chunking inline, so callers that keep per-chunk state see the same ranges
+                for (size_t first = begin; first < end; first += std::min(grain, end - first))
+                {
+                    f(first, std::min(end, first + grain));
+                }
+                return;
+            }
+
+            struct ForState
+            {
+                std::atomic<size_t> next{0};
+                std::atomic<size_t> done{0};
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::exception_ptr error;   // first exception thrown by f, guarded by mutex
+            };
+            auto state = std::make_shared<ForState>();
+
+            // helpers that start after the range is exhausted exit without touching f
+            auto run_chunks = [state, begin, end, grain, chunk_count, &f]()
+            {
+                size_t chunk;
+                while ((chunk = state->next.fetch_add(1)) < chunk_count)
+                {
+                    const size_t first = begin + chunk * grain;
+                    try
+                    {
+                        f(first, std::min(end, first + grain));
+                    }
+                    catch (...)
+                    {
+                        // the chunk still counts as done so the caller wakes up and rethrows
+                        std::scoped_lock guard(state->mutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    if (state->done.fetch_add(1) + 1 == chunk_count)
+                    {
+                        std::scoped_lock guard(state->mutex);
+                        state->cv.notify_all();
+                    }
+                }
+            };
+
+            const size_t helper_count = std::min(chunk_count - 1, m_workers.size());
+            for (size_t i = 0; i < helper_count; i++)
+            {
+                enqueue(run_chunks);
+            }
+            run_chunks();
+
+            std::unique_lock lock(state->mutex);
+            state->cv.wait(lock, [&]() { return state->done.load() == chunk_count; });
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+    private:
+        void enqueue(std::function<void()>&& task);
+        void worker_loop(const size_t index);
+
+        std::vector<std::thread> m_workers;
+        std::deque<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool b_stopping{false};
+    };
+}
+}
@@ -5,10 +5,12 @@
 #include <sstream>
 #include <cstddef>
 #include <vector>
+#include "slot_map.h"
 #include <glm/glm.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/ext/matrix_transform.hpp> 
 #include <functional>
+#include <type_traits>
 #include <glm/common.hpp>
 #include <boost/lexical_cast.hpp>
 #include <glm/vec4.hpp>
@@ -39,7 +41,7 @@ struct ModelMatrix
     glm::vec3 rotation_axis{1.f};
     glm::vec3 translation{1.f};
 
-    inline glm::mat4 render_matrix()
+    inline glm::mat4 render_matrix() const
     {
         glm::mat4 S = glm::scale(glm::mat4(1.0), scale);
         glm::mat4 R = glm::rotate(glm::mat4(1.0), glm::clamp(rotation_angle, -2.f * (float)M_PI, 2.f * (float)M_PI), rotation_axis);
@@ -112,30 +114,39 @@ public:
 
 
 
+// Scene description of a drawable. The engine compiles it into a DrawRecord and draws
+// that; the names are only resolved again when an asset or the render objects change.
 struct RenderObject
 {
     std::string name {"default_render_object"};
     std::string mesh_name;
     std::string material_name;
     ModelMatrix model_matrix;
+    glm::vec4 normal_color{.8f, 0.f, 0.f, 0.f};
 
     bool b_should_render{true};
-
-    std::function<void(const float delta)> render = nullptr;
 };
 
 struct AllocatedBuffer 
 {
-    VkBuffer buffer;
-    VmaAllocation allocation;
+    VkBuffer buffer{VK_NULL_HANDLE};
+    VmaAllocation allocation{VK_NULL_HANDLE};
 };
 
 struct AllocatedImage 
 {
-    VkImage image;
-    VmaAllocation allocation;
+    VkImage image{VK_NULL_HANDLE};
+    VmaAllocation allocation{VK_NULL_HANDLE};
 };
 
+// references into the engine's GPU resource pools (Core::GpuResources); stale handles resolve to VK_NULL_HANDLE
+struct PipelineTag;
+struct PipelineLayoutTag;
+using BufferHandle          = SketchBook::DataStructures::Handle<AllocatedBuffer>;
+using ImageHandle           = SketchBook::DataStructures::Handle<AllocatedImage>;
+using PipelineHandle        = SketchBook::DataStructures::Handle<PipelineTag>;
+using PipelineLayoutHandle  = SketchBook::DataStructures::Handle<PipelineLayoutTag>;
+
 struct DepthImage
 {
     VkImageView depth_view_image;
@@ -145,8 +156,26 @@ struct DepthImage
 
 struct Vertex_RBG_Normal_Mesh 
 {
-    std::vector<Vertex_RBG_Normal> vertices;
-    AllocatedBuffer vertex_buffer;
+    std::vector<Vertex_RBG_Normal> vertices;    // empty when uploaded straight from the mesh cache
+    std::vector<uint32_t> indices;              // empty for unindexed meshes
+    BufferHandle vertex_buffer;
+    BufferHandle index_buffer;
+    uint32_t vertex_count{0};                   // in vertex_buffer
+    uint32_t index_count{0};                    // in index_buffer, 0 draws unindexed
+    VkIndexType index_type{VK_INDEX_TYPE_UINT32};
+    glm::vec3 bounds_min{0.f};
+    glm::vec3 bounds_max{0.f};
+
+    void compute_bounds()
+    {
+        if (vertices.empty()) return;
+        bounds_min = bounds_max = vertices[0].position;
+        for (const Vertex_RBG_Normal& vertex : vertices)
+        {
+            bounds_min = glm::min(bounds_min, vertex.position);
+            bounds_max = glm::max(bounds_max, vertex.position);
+        }
+    }
 };
 
 
@@ -155,6 +184,22 @@ struct MeshPushConstants {
 	glm::vec4 normal_color{.8f, 0.f, 0.f, 0.f};
 };
 
+// Everything one draw needs, resolved ahead of time from a RenderObject.
+// transform_index is the object's instance buffer slot (drawn as firstInstance)
+// and also indexes the scene's draw_constants.
+struct DrawRecord
+{
+    VkPipeline pipeline;
+    VkPipelineLayout pipeline_layout;
+    VkBuffer vertex_buffer;
+    VkBuffer index_buffer;      // VK_NULL_HANDLE draws vertex_count vertices unindexed
+    VkIndexType index_type;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t transform_index;
+};
+static_assert(std::is_trivially_copyable_v<DrawRecord>, "DrawRecord must stay POD");
+
 
 
 
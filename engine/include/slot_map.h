@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace SketchBook
+{
+namespace DataStructures
+{
+    // 32-bit reference into a SlotMap: 20 bits of slot index, 12 bits of generation.
+    // Generations start at 1, so a default constructed handle is null and never valid.
+    template<typename Tag>
+    struct Handle
+    {
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+        uint32_t value{0};
+
+        static constexpr Handle make(const uint32_t index, const uint32_t generation)
+        {
+            return Handle{(generation << INDEX_BITS) | index};
+        }
+
+        constexpr uint32_t index() const { return value & INDEX_MASK; }
+        constexpr uint32_t generation() const { return value >> INDEX_BITS; }
+        constexpr bool is_null() const { return value == 0; }
+        constexpr explicit operator bool() const { return value != 0; }
+
+        constexpr bool operator==(const Handle& other) const { return value == other.value; }
+        constexpr bool operator!=(const Handle& other) const { return value != other.value; }
+    };
+
+    // Values stored densely for iteration and referenced through generational handles.
+    // Erasing moves the last value into the hole and bumps the slot's generation, so old
+    // handles to it resolve to nullptr instead of to whatever reuses the slot. A slot whose
+    // generation runs out is retired rather than reused.
+    //
+    // Pointers from get() are invalidated by emplace and erase; keep the handle instead.
+    // At most INDEX_MASK + 1 slots fit in a handle; emplace throws std::length_error
+    // past that, like a std container past max_size().
+    template<typename T, typename Tag = T>
+    class SlotMap
+    {
+    public:
+        using handle_type = Handle<Tag>;
+
+        template<typename... Args>
+        handle_type emplace(Args&&... args)
+        {
+            uint32_t index;
+            if (m_free_head != NONE)
+            {
+                index = m_free_head;
+                m_free_head = m_slots[index].dense;
+            }
+            else
+            {
+                // a wider index would spill into the generation bits and alias slot 0
+                if (m_slots.size() > handle_type::INDEX_MASK) throw std::length_error("SlotMap: out of handle indices");
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.push_back(Slot{NONE, 1});
+            }
+
+            m_slots[index].dense = static_cast<uint32_t>(m_values.size());
+            m_values.emplace_back(std::forward<Args>(args)...);
+            m_dense_to_slot.push_back(index);
+            return handle_type::make(index, m_slots[index].generation);
+        }
+
+        handle_type insert(T value) { return emplace(std::move(value)); }
+
+        bool erase(const handle_type handle)
+        {
+            if (!contains(handle)) return false;
+
+            Slot& slot = m_slots[handle.index()];
+            const uint32_t dense = slot.dense;
+            const uint32_t last = static_cast<uint32_t>(m_values.size() - 1);
+            if (dense != last)
+            {
+                m_values[dense] = std::move(m_values[last]);
+                m_dense_to_slot[dense] = m_dense_to_slot[last];
+                m_slots[m_dense_to_slot[dense]].dense = dense;
+            }
+            m_values.pop_back();
+            m_dense_to_slot.pop_back();
+
+            if (slot.generation < handle_type::MAX_GENERATION)
+            {
+                ++slot.generation;
+                slot.dense = m_free_head;
+                m_free_head = handle.index();
+            }
+            else
+            {
+                slot.dense = NONE;
+                slot.generation = 0;    // retired: matches no handle
+            }
+            return true;
+        }
+
+        inline bool contains(const handle_type handle) const
+        {
+            const uint32_t index = handle.index();
+            return index < m_slots.size()
+                && m_slots[index].generation == handle.generation()
+                && handle.generation() != 0;
+        }
+
+        // nullptr for null and stale handles
+        inline T* get(const handle_type handle) { return contains(handle) ? &m_values[m_slots[handle.index()].dense] : nullptr; }
+        inline const T* get(const handle_type handle) const { return contains(handle) ? &m_values[m_slots[handle.index()].dense] : nullptr; }
+
+        // handle of the value at a dense position, for iteration
+        inline handle_type handle_at(const size_t dense) const
+        {
+            const uint32_t index = m_dense_to_slot[dense];
+            return handle_type::make(index, m_slots[index].generation);
+        }
+
+        inline size_t size() const { return m_values.size(); }
+        inline bool empty() const { return m_values.empty(); }
+
+        void reserve(const size_t count)
+        {
+            m_values.reserve(count);
+            m_dense_to_slot.reserve(count);
+            m_slots.reserve(count);
+        }
+
+        void clear()
+        {
+            for (size_t dense = m_values.size(); dense > 0; dense--)
+            {
+                erase(handle_at(dense - 1));
+            }
+        }
+
+        inline std::vector<T>& values() { return m_values; }
+        inline const std::vector<T>& values() const { return m_values; }
+
+        inline auto begin() { return m_values.begin(); }
+        inline auto end() { return m_values.end(); }
+        inline auto begin() const { return m_values.begin(); }
+        inline auto end() const { return m_values.end(); }
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        struct Slot
+        {
+            uint32_t dense;         // position in m_values, or the next free slot
+            uint32_t generation;
+        };
+
+        std::vector<T> m_values;
+        std::vector<uint32_t> m_dense_to_slot;
+        std::vector<Slot> m_slots;
+        uint32_t m_free_head{NONE};
+    };
+}
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "sk_io.h"
+#include "spdlog/spdlog.h"
+
+namespace SketchBook
+{
+    // Binary registry snapshots on top of entt::snapshot / entt::snapshot_loader.
+    //
+    // Layout, all little-endian:
+    //   magic "SKSN", format version, component count, then (type hash, sizeof) per component,
+    //   then entt's stream: entity list, then per component a count and (entity, value) records.
+    // Trivially copyable components are stored as their raw bytes. Anything else must provide
+    //   template<typename Archive, typename T> void snapshot_fields(Archive& archive, T& value)
+    // next to the type (found by ADL), calling archive.field(member) for each member. T is const
+    // when saving. The header must match on load, so a snapshot only loads into a build with the
+    // same component list and layouts.
+
+    constexpr uint32_t SNAPSHOT_MAGIC = 0x4E534B53; // "SKSN"
+    constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+    bool is_little_endian_host();
+
+    class SnapshotWriter
+    {
+    public:
+        // entity ids and counts
+        template<typename T>
+        std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>> operator()(const T value) { write(&value, sizeof(T)); }
+
+        // empty components are written as the entity alone
+        template<typename Component>
+        void operator()(const entt::entity entity, const Component& component)
+        {
+            (*this)(entity);
+            field(component);
+        }
+
+        template<typename T>
+        void field(const T& value)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                write(&value, sizeof(T));
+            }
+            else
+            {
+                snapshot_fields(*this, value);
+            }
+        }
+
+        void field(const std::string& value);
+
+        template<typename T>
+        void field(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "vector fields must hold trivially copyable values");
+            field(static_cast<uint64_t>(values.size()));
+            write(values.data(), values.size() * sizeof(T));
+        }
+
+        void write(const void* data, const size_t size);
+
+        std::vector<uint8_t>& buffer() { return m_buffer; }
+
+    private:
+        std::vector<uint8_t> m_buffer;
+    };
+
+    class SnapshotReader
+    {
+    public:
+        SnapshotReader(const uint8_t* data, const size_t size) : m_data{data}, m_end{data + size} {}
+
+        template<typename T>
+        std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>> operator()(T& value)
+        {
+            read(&value, sizeof(T));
+            if constexpr (std::is_same_v<T, entt::entity>)
+            {
+                if (m_entities) m_entities->push_back(value);
+            }
+        }
+
+        template<typename Component>
+        void operator()(entt::entity& entity, Component& component)
+        {
+            (*this)(entity);
+            field(component);
+        }
+
+        template<typename T>
+        void field(T& value)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                read(&value, sizeof(T));
+            }
+            else
+            {
+                snapshot_fields(*this, value);
+            }
+        }
+
+        void field(std::string& value);
+
+        template<typename T>
+        void field(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "vector fields must hold trivially copyable values");
+            uint64_t count{0};
+            field(count);
+            if (count > remaining() / std::max<size_t>(sizeof(T), 1))
+            {
+                b_failed = true;
+                return;
+            }
+            values.resize(count);
+            read(values.data(), count * sizeof(T));
+        }
+
+        // a short read zero fills and marks the reader failed
+        void read(void* data, const size_t size);
+
+        inline size_t remaining() const { return static_cast<size_t>(m_end - m_data); }
+        inline bool failed() const { return b_failed; }
+
+        // appends every archived entity id read from here on; nullptr stops recording
+        void record_entities(std::vector<entt::entity>* out_entities) { m_entities = out_entities; }
+
+    private:
+        const uint8_t* m_data;
+        const uint8_t* m_end;
+        std::vector<entt::entity>* m_entities{nullptr};
+        bool b_failed{false};
+    };
+
+    template<typename... Components>
+    void write_snapshot_header(SnapshotWriter& writer)
+    {
+        writer(SNAPSHOT_MAGIC);
+        writer(SNAPSHOT_VERSION);
+        writer(static_cast<uint32_t>(sizeof...(Components)));
+        ((writer(static_cast<uint32_t>(entt::type_hash<Components>::value())), writer(static_cast<uint32_t>(sizeof(Components)))), ...);
+    }
+
+    template<typename... Components>
+    bool read_snapshot_header(SnapshotReader& reader)
+    {
+        uint32_t magic{0}, version{0}, count{0};
+        reader(magic);
+        reader(version);
+        reader(count);
+        if (reader.failed() || magic != SNAPSHOT_MAGIC)
+        {
+            spdlog::error("snapshot: not a snapshot archive");
+            return false;
+        }
+        if (version != SNAPSHOT_VERSION)
+        {
+            spdlog::error("snapshot: archive version {} (expected {})", version, SNAPSHOT_VERSION);
+            return false;
+        }
+        if (count != sizeof...(Components))
+        {
+            spdlog::error("snapshot: archive has {} component types (expected {})", count, sizeof...(Components));
+            return false;
+        }
+
+        bool b_matches = true;
+        auto check = [&](const uint32_t type, const uint32_t size) {
+            uint32_t archived_type{0}, archived_size{0};
+            reader(archived_type);
+            reader(archived_size);
+            b_matches = b_matches && archived_type == type && archived_size == size;
+        };
+        (check(static_cast<uint32_t>(entt::type_hash<Components>::value()), static_cast<uint32_t>(sizeof(Components))), ...);
+
+        if (!b_matches || reader.failed())
+        {
+            spdlog::error("snapshot: component types or layouts differ from this build");
+            return false;
+        }
+        return true;
+    }
+
+    template<typename... Components>
+    std::vector<uint8_t> save_snapshot(const entt::registry& registry)
+    {
+        SnapshotWriter writer;
+        write_snapshot_header<Components...>(writer);
+        entt::snapshot{registry}.entities(writer).template component<Components...>(writer);
+        return std::move(writer.buffer());
+    }
+
+    template<typename... Components>
+    bool save_snapshot(const entt::registry& registry, const std::string& path)
+    {
+        if (!is_little_endian_host())
+        {
+            spdlog::error("snapshot: big-endian hosts are not supported");
+            return false;
+        }
+        const std::vector<uint8_t> buffer = save_snapshot<Components...>(registry);
+        return IO::write_file(path, buffer.data(), buffer.size());
+    }
+
+    // registry must be empty (entt::snapshot_loader keeps entity ids as saved)
+    template<typename... Components>
+    bool load_snapshot(entt::registry& registry, const uint8_t* data, const size_t size)
+    {
+        if (!is_little_endian_host())
+        {
+            spdlog::error("snapshot: big-endian hosts are not supported");
+            return false;
+        }
+
+        SnapshotReader reader(data, size);
+        if (!read_snapshot_header<Components...>(reader)) return false;
+
+        entt::snapshot_loader{registry}.entities(reader).template component<Components...>(reader);
+        if (reader.failed())
+        {
+            spdlog::error("snapshot: archive is truncated");
+            registry.clear();
+            return false;
+        }
+        return true;
+    }
+
+    template<typename... Components>
+    bool load_snapshot(entt::registry& registry, const std::string& path)
+    {
+        IO::MappedFile file(path);
+        if (!file.is_valid())
+        {
+            spdlog::error("snapshot: cannot open \"{}\"", path);
+            return false;
+        }
+        return load_snapshot<Components...>(registry, file.data(), file.size());
+    }
+
+    template<typename... Components>
+    bool save_snapshot(const entt::registry& registry, const std::string& path, entt::type_list<Components...>)
+    {
+        return save_snapshot<Components...>(registry, path);
+    }
+
+    template<typename... Components>
+    bool load_snapshot(entt::registry& registry, const std::string& path, entt::type_list<Components...>)
+    {
+        return load_snapshot<Components...>(registry, path);
+    }
+
+    // Loads into a registry that already holds entities (entt::continuous_loader). Archived ids
+    // are mapped to fresh local entities. A failed merge leaves the registry as it was.
+    template<typename... Components>
+    bool merge_snapshot(entt::registry& registry, const uint8_t* data, const size_t size)
+    {
+        if (!is_little_endian_host())
+        {
+            spdlog::error("snapshot: big-endian hosts are not supported");
+            return false;
+        }
+
+        SnapshotReader reader(data, size);
+        if (!read_snapshot_header<Components...>(reader)) return false;
+
+        std::vector<entt::entity> archived;
+        reader.record_entities(&archived);
+
+        entt::continuous_loader loader{registry};
+        loader.entities(reader).template component<Components...>(reader);
+        if (reader.failed())
+        {
+            // the loader is fresh, so every entity it mapped was created by this call; take them back out
+            for (const entt::entity remote : archived)
+            {
+                if (!loader.contains(remote)) continue;
+                const entt::entity local = loader.map(remote);
+                if (registry.valid(local)) registry.destroy(local);
+            }
+            spdlog::error("snapshot: archive is truncated");
+            return false;
+        }
+        return true;
+    }
+
+    template<typename... Components>
+    bool merge_snapshot(entt::registry& registry, const std::string& path)
+    {
+        IO::MappedFile file(path);
+        if (!file.is_valid())
+        {
+            spdlog::error("snapshot: cannot open \"{}\"", path);
+            return false;
+        }
+        return merge_snapshot<Components...>(registry, file.data(), file.size());
+    }
+}
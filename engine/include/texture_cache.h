@@ -0,0 +1,65 @@
+#pragma once
+
+#include "mesh_cache.h"
+#include "mipmaps.h"
+#include "sk_io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        // .sktex: a decoded RGBA8 image with its whole mip chain, so a load maps the file and
+        // copies the chain into one staging buffer without touching the PNG/JPG decoder. The
+        // levels follow each other from pixel_offset, which is SKTEX_ALIGNMENT aligned.
+        //
+        // Stale, and ignored, when the source's hash or size or the format version differ.
+        constexpr uint32_t SKTEX_VERSION = 1;
+        constexpr uint64_t SKTEX_ALIGNMENT = 256;
+
+        struct SkTexHeader
+        {
+            char magic[4];              // "SKTX"
+            uint32_t version;
+            uint64_t source_hash;       // hash_bytes of the source file
+            uint64_t source_size;
+            uint32_t b_srgb;            // 1 when the mips were filtered as sRGB
+            uint32_t level_count;
+            uint64_t pixel_offset;      // from the start of the file
+            uint64_t pixel_bytes;       // the whole chain
+            Imaging::MipLevel levels[Imaging::MAX_MIP_LEVELS];  // offsets from pixel_offset
+        };
+
+        // source path with its extension replaced by .sktex
+        std::string texture_cache_path(const std::string& source_path);
+
+        bool write_texture_cache(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const bool b_srgb,
+            const void* pixels, const size_t pixel_bytes, const std::vector<Imaging::MipLevel>& levels);
+
+        // A mapped .sktex. The pixel pointer points into the mapping and lives as long as the object.
+        class TextureCacheFile
+        {
+        public:
+            // false, leaving nothing mapped, when the file is missing, corrupt or stale;
+            // mips filtered in the other color space count as stale
+            bool open(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const bool b_srgb);
+
+            inline bool is_valid() const { return m_header != nullptr; }
+            inline const SkTexHeader& header() const { return *m_header; }
+
+            inline const uint8_t* pixels() const { return m_file.data() + m_header->pixel_offset; }
+            inline size_t pixel_bytes() const { return m_header->pixel_bytes; }
+
+            inline const Imaging::MipLevel* levels() const { return m_header->levels; }
+            inline uint32_t level_count() const { return m_header->level_count; }
+
+        private:
+            MappedFile m_file;
+            const SkTexHeader* m_header{nullptr};
+        };
+    }
+}
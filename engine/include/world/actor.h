@@ -8,7 +8,7 @@ namespace World
 {
     struct Actor : public KinematicObject
     {
-        float m_max_speed = 1.f // meter per second
+        Actor(const float x, const float y) : KinematicObject(x, y) {}
     };
 }
 }
\ No newline at end of file
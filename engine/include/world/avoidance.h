@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "physics.h"
+#include "spatial_hash.h"
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Avoidance
+{
+    // Optimal reciprocal collision avoidance (ORCA).
+    // Each agent turns its nearest neighbors into half-plane velocity constraints
+    // and solves a small 2D linear program for the velocity closest to the one its
+    // steering asked for. Agents only read shared state, so the solve runs in parallel.
+
+    constexpr int MAX_NEIGHBORS = 16;
+
+    struct AvoidanceParams
+    {
+        float neighbor_distance{4.f}; // meters
+        int max_neighbors{10};        // clamped to MAX_NEIGHBORS
+        float time_horizon{2.f};      // seconds of look-ahead against other agents
+    };
+
+    struct OrcaLine
+    {
+        glm::vec2 point;
+        glm::vec2 direction;
+    };
+
+    class CrowdAvoidance
+    {
+    public:
+        CrowdAvoidance(const AvoidanceParams& params = {}, Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+
+        inline AvoidanceParams& params() { return m_params; }
+
+        // Full tick for a crowd: steer every agent, solve avoidance, integrate.
+        // Replaces calling KinematicObject::update on each agent.
+        void update(const std::vector<KinematicObject*>& agents, const Event_NextTick& event);
+
+        // Avoidance stage only: expects steer() to have run, sets each agent's avoidance velocity.
+        void solve(const std::vector<KinematicObject*>& agents, const float seconds_per_tick);
+
+    private:
+        void gather(const std::vector<KinematicObject*>& agents);
+        glm::vec2 solve_agent(const size_t agent, const float seconds_per_tick) const;
+
+        AvoidanceParams m_params;
+        Threading::ThreadPool& m_pool;
+        SpatialHashGrid m_grid;
+
+        // per-tick SoA snapshot of the crowd
+        std::vector<glm::vec2> m_positions;
+        std::vector<glm::vec2> m_velocities;
+        std::vector<glm::vec2> m_preferred_velocities;
+        std::vector<float> m_radii;
+        std::vector<float> m_max_speeds;
+        std::vector<glm::vec2> m_new_velocities;
+        float m_max_radius{0.f};
+    };
+}
+}
+}
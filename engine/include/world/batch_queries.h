@@ -0,0 +1,188 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "sk_threads.h"
+#include "spatial_hash.h"
+#include "sk_world.h"
+#include "loose_tree.h"
+
+namespace SketchBook
+{
+namespace World
+{
+    // Results of a batch query in compressed sparse row form: the ids for query i are
+    // ids[offsets[i], offsets[i + 1]), in the order the queries were given.
+    struct BatchQueryResults
+    {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> ids;
+
+        inline size_t query_count() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+        inline size_t count(const size_t query) const { return offsets[query + 1] - offsets[query]; }
+        inline const uint32_t* begin(const size_t query) const { return ids.data() + offsets[query]; }
+        inline const uint32_t* end(const size_t query) const { return ids.data() + offsets[query + 1]; }
+    };
+
+    // Index adapters used by BatchQuery. f(uint32_t id) per match.
+
+    template<typename F>
+    void for_each_id_in_radius(const SpatialHashGrid& grid, const glm::vec2& center, const float radius, F&& f)
+    {
+        grid.for_each_in_radius(center, radius, [&](const uint32_t item, const glm::vec2&) { f(item); });
+    }
+
+    template<typename F>
+    void for_each_id_in_radius(const View::World2dModel& model, const glm::vec2& center, const float radius, F&& f)
+    {
+        model.for_each_in_radius(glm::vec3(center.x, center.y, 0.f), radius, [&](const View::WorldObject& object) { f(static_cast<uint32_t>(object.id)); });
+    }
+
+    template<int Dim, typename F>
+    void for_each_id_in_radius(const View::LooseTree<Dim>& tree, const glm::vec2& center, const float radius, F&& f)
+    {
+        tree.for_each_in_radius(glm::vec3(center.x, center.y, 0.f), radius, [&](const View::WorldObject& object) { f(static_cast<uint32_t>(object.id)); });
+    }
+
+    // k nearest ids, closest first; returns how many were written (at most min(k, MAX_NEAREST))
+    size_t nearest_ids(const SpatialHashGrid& grid, const glm::vec2& center, const size_t k, uint32_t* out_ids);
+
+    template<typename Index>
+    size_t nearest_ids(const Index& index, const glm::vec2& center, const size_t k, uint32_t* out_ids)
+    {
+        int ids[Index::MAX_NEAREST];
+        const size_t found = index.query_nearest(View::WorldPoint{center.x, center.y, 0.f}, k, ids, Index::MAX_NEAREST);
+        for (size_t i = 0; i < found; i++)
+        {
+            out_ids[i] = static_cast<uint32_t>(ids[i]);
+        }
+        return found;
+    }
+
+    // Runs many queries against one index. Query points are sorted along a Morton
+    // curve first, so consecutive queries on a thread touch the same index nodes and
+    // grid cells, then the sorted order is split into batches across the pool.
+    // Scratch buffers are kept between calls; one BatchQuery should not be shared by
+    // threads, but any number of them can query the same index concurrently.
+    class BatchQuery
+    {
+    public:
+        static constexpr size_t MAX_NEAREST = 64;
+
+        explicit BatchQuery(Threading::ThreadPool& pool = Threading::ThreadPool::shared(), const size_t batch_size = 256)
+            : m_pool{pool}, m_batch_size{std::max<size_t>(batch_size, 1)} {}
+
+        template<typename Index>
+        void radius(const Index& index, const glm::vec2* points, const size_t count, const float radius, BatchQueryResults& out)
+        {
+            run(points, count, out, [&](const glm::vec2& point, std::vector<uint32_t>& sink) {
+                for_each_id_in_radius(index, point, radius, [&](const uint32_t id) { sink.push_back(id); });
+            });
+        }
+
+        template<typename Index>
+        void radius(const Index& index, const std::vector<glm::vec2>& points, const float radius, BatchQueryResults& out)
+        {
+            this->radius(index, points.data(), points.size(), radius, out);
+        }
+
+        // k is clamped to MAX_NEAREST
+        template<typename Index>
+        void nearest(const Index& index, const glm::vec2* points, const size_t count, const size_t k, BatchQueryResults& out)
+        {
+            const size_t wanted = std::min(k, MAX_NEAREST);
+            run(points, count, out, [&](const glm::vec2& point, std::vector<uint32_t>& sink) {
+                uint32_t ids[MAX_NEAREST];
+                const size_t found = nearest_ids(index, point, wanted, ids);
+                sink.insert(sink.end(), ids, ids + found);
+            });
+        }
+
+        template<typename Index>
+        void nearest(const Index& index, const std::vector<glm::vec2>& points, const size_t k, BatchQueryResults& out)
+        {
+            nearest(index, points.data(), points.size(), k, out);
+        }
+
+        // query indices in the Morton order used by the last call
+        inline const std::vector<uint32_t>& order() const { return m_order; }
+
+    private:
+        struct Batch
+        {
+            std::vector<uint32_t> ids;
+            std::vector<uint32_t> counts;   // per query, in sorted order
+        };
+
+        void sort_points(const glm::vec2* points, const size_t count);
+
+        template<typename Query>
+        void run(const glm::vec2* points, const size_t count, BatchQueryResults& out, Query&& query)
+        {
+            sort_points(points, count);
+
+            const size_t batch_count = (count + m_batch_size - 1) / m_batch_size;
+            if (m_batches.size() < batch_count) m_batches.resize(batch_count);
+
+            m_pool.parallel_for(0, batch_count, 1, [&](const size_t first_batch, const size_t last_batch) {
+                for (size_t b = first_batch; b < last_batch; b++)
+                {
+                    Batch& batch = m_batches[b];
+                    batch.ids.clear();
+                    batch.counts.clear();
+
+                    const size_t last = std::min(count, (b + 1) * m_batch_size);
+                    for (size_t s = b * m_batch_size; s < last; s++)
+                    {
+                        const size_t before = batch.ids.size();
+                        query(points[m_order[s]], batch.ids);
+                        batch.counts.push_back(static_cast<uint32_t>(batch.ids.size() - before));
+                    }
+                }
+            });
+
+            // offsets in the caller's query order
+            out.offsets.assign(count + 1, 0);
+            for (size_t b = 0; b < batch_count; b++)
+            {
+                const size_t first = b * m_batch_size;
+                for (size_t i = 0; i < m_batches[b].counts.size(); i++)
+                {
+                    out.offsets[m_order[first + i] + 1] = m_batches[b].counts[i];
+                }
+            }
+            for (size_t q = 0; q < count; q++)
+            {
+                out.offsets[q + 1] += out.offsets[q];
+            }
+            out.ids.resize(out.offsets[count]);
+
+            m_pool.parallel_for(0, batch_count, 1, [&](const size_t first_batch, const size_t last_batch) {
+                for (size_t b = first_batch; b < last_batch; b++)
+                {
+                    const Batch& batch = m_batches[b];
+                    const size_t first = b * m_batch_size;
+                    size_t read = 0;
+                    for (size_t i = 0; i < batch.counts.size(); i++)
+                    {
+                        const uint32_t n = batch.counts[i];
+                        if (n > 0) std::memcpy(out.ids.data() + out.offsets[m_order[first + i]], batch.ids.data() + read, n * sizeof(uint32_t));
+                        read += n;
+                    }
+                }
+            });
+        }
+
+        Threading::ThreadPool& m_pool;
+        size_t m_batch_size;
+
+        std::vector<uint64_t> m_keys;       // morton code << 32 | query index
+        std::vector<uint32_t> m_order;      // query indices sorted along the curve
+        std::vector<Batch> m_batches;
+    };
+}
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sk_io.h"
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Streaming
+{
+    // The world is split into square chunks on the sim plane (x, y). The camera maps
+    // onto that plane as FreeCamera::m_position (x, z), see camera_focus().
+    // Each chunk is one binary file that is memory mapped as-is: a ChunkHeader, the
+    // object records, then terrain heights. Missing files are empty (ungenerated) chunks.
+
+    constexpr uint32_t CHUNK_MAGIC = 0x48434b53; // "SKCH"
+    constexpr uint32_t CHUNK_VERSION = 1;
+
+    struct ChunkCoord
+    {
+        int32_t x{0};
+        int32_t y{0};
+
+        bool operator==(const ChunkCoord& other) const { return x == other.x && y == other.y; }
+        bool operator!=(const ChunkCoord& other) const { return !(*this == other); }
+    };
+
+    struct ChunkCoordHash
+    {
+        size_t operator()(const ChunkCoord& coord) const
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.y));
+        }
+    };
+
+    struct ChunkHeader
+    {
+        uint32_t magic{CHUNK_MAGIC};
+        uint32_t version{CHUNK_VERSION};
+        int32_t x{0};
+        int32_t y{0};
+        uint32_t object_count{0};
+        uint32_t terrain_resolution{0};     // heights are resolution * resolution floats, row major
+        uint64_t objects_offset{0};
+        uint64_t terrain_offset{0};
+    };
+
+    struct ChunkObjectRecord
+    {
+        int32_t id;
+        uint32_t type;
+        float position[3];
+        float min_corner[3];
+        float max_corner[3];
+    };
+
+    // A resident chunk. The pointers reference the mapping and stay valid as long as
+    // the shared_ptr handed out by the streamer is held, even after eviction.
+    struct ChunkData
+    {
+        ChunkCoord coord;
+        IO::MappedFile file;
+        const ChunkHeader* header{nullptr};
+        const ChunkObjectRecord* objects{nullptr};
+        const float* heights{nullptr};
+
+        inline bool is_empty() const { return header == nullptr; }
+        inline uint32_t object_count() const { return header ? header->object_count : 0; }
+        inline uint32_t terrain_resolution() const { return header ? header->terrain_resolution : 0; }
+        // resident cost; empty chunks still count so an endless walk cannot grow the table unbounded
+        inline size_t bytes() const { return sizeof(ChunkData) + file.size(); }
+    };
+
+    std::string chunk_file_name(const ChunkCoord& coord);
+
+    bool write_chunk(const std::string& path, const ChunkCoord& coord, const std::vector<ChunkObjectRecord>& objects,
+        const std::vector<float>& heights, const uint32_t terrain_resolution);
+
+    // maps and validates a chunk file; returns an empty chunk when the file is missing or malformed
+    std::shared_ptr<ChunkData> load_chunk(const std::string& path, const ChunkCoord& coord);
+
+    struct ChunkStreamingParams
+    {
+        float chunk_size{64.f};                     // meters per chunk side
+        int load_radius{2};                         // chunks kept around each focus point
+        size_t memory_budget{256ull << 20};         // bytes of mapped chunk data
+        size_t max_loads_in_flight{8};
+    };
+
+    // Keeps the chunks around a set of focus points resident. update() only polls and
+    // schedules, file IO and page faults happen on pool threads, so it is safe to call
+    // from the render or tick loop every frame.
+    class ChunkStreamer
+    {
+    public:
+        using ChunkCallback = std::function<void(const std::shared_ptr<const ChunkData>& chunk)>;
+
+        ChunkStreamer(const std::string& directory, const ChunkStreamingParams& params = {},
+            Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+        ~ChunkStreamer();
+
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+        static inline glm::vec2 camera_focus(const glm::vec3& camera_position) { return {camera_position.x, camera_position.z}; }
+
+        ChunkCoord chunk_at(const glm::vec2& position) const;
+
+        // focus points are camera and actor positions on the sim plane
+        void update(const std::vector<glm::vec2>& focus_points);
+
+        // blocks until every scheduled load has landed; meant for loading screens and tests
+        void flush();
+
+        std::shared_ptr<const ChunkData> acquire(const ChunkCoord& coord) const;
+        inline bool is_resident(const ChunkCoord& coord) const { return m_resident.count(coord) > 0; }
+        inline size_t resident_count() const { return m_resident.size(); }
+        inline size_t pending_count() const { return m_pending.size(); }
+        inline size_t resident_bytes() const { return m_resident_bytes; }
+
+        // called from update() on the caller's thread
+        ChunkCallback on_chunk_loaded = nullptr;
+        ChunkCallback on_chunk_evicted = nullptr;
+
+    private:
+        struct Resident
+        {
+            std::shared_ptr<const ChunkData> chunk;
+            std::list<ChunkCoord>::iterator lru;
+        };
+
+        void collect_finished(const bool b_wait);
+        void make_resident(std::shared_ptr<const ChunkData> chunk);
+        void evict_over_budget();
+
+        std::string m_directory;
+        ChunkStreamingParams m_params;
+        Threading::ThreadPool& m_pool;
+
+        std::unordered_map<ChunkCoord, Resident, ChunkCoordHash> m_resident;
+        std::unordered_map<ChunkCoord, std::future<std::shared_ptr<ChunkData>>, ChunkCoordHash> m_pending;
+        std::unordered_set<ChunkCoord, ChunkCoordHash> m_wanted;
+        std::list<ChunkCoord> m_lru;                // front is the most recently wanted
+        size_t m_resident_bytes{0};
+        bool b_warned_budget{false};
+    };
+}
+}
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "events.h"
+#include "physics.h"
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Collision
+{
+    // Collision detection for KinematicObjects and static boxes on the sim plane.
+    //
+    // Broadphase: sort and sweep along x inside horizontal strips, so a crowd does not
+    // turn into one long x-overlap list. A body has a proxy in every strip it spans, and
+    // the proxies stay sorted by (strip, min x) between steps. The order is repaired with
+    // an insertion sort, which is close to linear because bodies barely move relative to
+    // each other from one tick to the next. Proxies for strips a body has just entered
+    // are sorted on their own and merged in.
+    // Narrowphase: pairs with at least one circle are tested four at a time with SSE
+    // (circle vs circle is circle vs a zero-size box); box vs box is a plain AABB test.
+    // Touching pairs are diffed against the previous step into enter/stay/exit events.
+
+    enum class Shape : uint8_t
+    {
+        Circle = 0,
+        Box
+    };
+
+    struct BodyPair
+    {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    class CollisionWorld
+    {
+    public:
+        // strip_height should be a few body diameters
+        CollisionWorld(const float strip_height = 4.f, Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+
+        // circle that follows the object's position and radius every step
+        uint32_t add_object(KinematicObject* object);
+        uint32_t add_circle(const glm::vec2& center, const float radius);
+        uint32_t add_box(const glm::vec2& center, const glm::vec2& half_extents);
+        void remove(const uint32_t body);
+
+        // moves a body that is not bound to an object
+        void set_center(const uint32_t body, const glm::vec2& center);
+
+        inline size_t body_count() const { return m_alive_count; }
+
+        // sync bound objects, broadphase, narrowphase, then diff against the last step
+        void step();
+
+        inline const std::vector<BodyPair>& candidate_pairs() const { return m_pairs; }
+        inline const std::vector<CollisionContact>& contacts() const { return m_contacts; }
+        inline const std::vector<CollisionContact>& entered() const { return m_entered; }
+        inline const std::vector<CollisionContact>& stayed() const { return m_stayed; }
+        inline const std::vector<BodyPair>& exited() const { return m_exited; }
+
+        KinematicObject* object(const uint32_t body) const { return m_objects[body]; }
+
+        // Sends the last step's events through the sim's dispatcher
+        // (entt::dispatcher, see World::event_dispatcher).
+        template<typename Dispatcher>
+        void dispatch(Dispatcher& dispatcher) const
+        {
+            for (const CollisionContact& contact : m_entered)
+            {
+                dispatcher.trigger(Event_CollisionEnter{contact, m_objects[contact.body_a], m_objects[contact.body_b]});
+            }
+            for (const CollisionContact& contact : m_stayed)
+            {
+                dispatcher.trigger(Event_CollisionStay{contact, m_objects[contact.body_a], m_objects[contact.body_b]});
+            }
+            for (const BodyPair& pair : m_exited)
+            {
+                dispatcher.trigger(Event_CollisionExit{pair.a, pair.b, m_objects[pair.a], m_objects[pair.b]});
+            }
+        }
+
+    private:
+        uint32_t allocate(const Shape shape, const glm::vec2& center, const glm::vec2& half_extents, const float radius, KinematicObject* object);
+        void sync_objects();
+        inline int32_t strip_of(const float y) const { return static_cast<int32_t>(std::floor(y * m_inv_strip_height)); }
+        void update_order();
+        void sweep();
+        void narrowphase();
+        void diff_events();
+
+        Threading::ThreadPool& m_pool;
+
+        // bodies, structure of arrays indexed by body id
+        std::vector<float> m_center_x;
+        std::vector<float> m_center_y;
+        std::vector<float> m_half_x;        // 0 for circles
+        std::vector<float> m_half_y;
+        std::vector<float> m_radius;        // 0 for boxes
+        std::vector<Shape> m_shapes;
+        std::vector<KinematicObject*> m_objects;
+        std::vector<uint8_t> m_alive;
+        std::vector<uint32_t> m_free;
+        std::vector<uint32_t> m_released;     // removed since the last step, reusable once their proxies are gone
+        size_t m_alive_count{0};
+
+        // broadphase
+        struct Proxy
+        {
+            float min_x;
+            int32_t strip;
+            uint32_t body;
+
+            bool operator<(const Proxy& other) const { return strip < other.strip || (strip == other.strip && min_x < other.min_x); }
+        };
+
+        float m_strip_height;
+        float m_inv_strip_height;
+        std::vector<int32_t> m_strip_lo;    // per body, strips covered last step (lo > hi: none)
+        std::vector<int32_t> m_strip_hi;
+        std::vector<Proxy> m_proxies;       // sorted by (strip, min x), kept between steps
+        std::vector<Proxy> m_entering;
+        std::vector<Proxy> m_merged;
+        std::vector<float> m_max_x;         // per sorted proxy
+        std::vector<float> m_min_y;
+        std::vector<float> m_max_y;
+        std::vector<std::vector<BodyPair>> m_chunk_pairs;
+        std::vector<BodyPair> m_pairs;
+
+        // narrowphase and events
+        std::vector<std::vector<CollisionContact>> m_chunk_contacts;
+        std::vector<CollisionContact> m_contacts;     // sorted by (body_a, body_b)
+        std::vector<BodyPair> m_touching;             // last step's touching pairs, same order
+        std::vector<CollisionContact> m_entered;
+        std::vector<CollisionContact> m_stayed;
+        std::vector<BodyPair> m_exited;
+    };
+}
+}
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include "spdlog/spdlog.h"
+#include <glm/glm.hpp>
+#include <cstdint>
 
 namespace SketchBook
 {
@@ -12,5 +14,40 @@ namespace World
 
         const double total_seconds() const { return static_cast<double>(seconds_per_tick) * tick_count; } 
     };
+
+    struct KinematicObject;
+
+    struct CollisionContact
+    {
+        uint32_t body_a;
+        uint32_t body_b;
+        glm::vec2 normal;   // unit, from a towards b
+        float depth;        // penetration in meters
+        glm::vec2 point;    // on the surface of b
+    };
+
+    // Pair events from Collision::CollisionWorld, body_a < body_b. Objects are null for bodies
+    // that are not bound to a KinematicObject.
+    struct Event_CollisionEnter
+    {
+        CollisionContact contact;
+        KinematicObject* object_a;
+        KinematicObject* object_b;
+    };
+
+    struct Event_CollisionStay
+    {
+        CollisionContact contact;
+        KinematicObject* object_a;
+        KinematicObject* object_b;
+    };
+
+    struct Event_CollisionExit
+    {
+        uint32_t body_a;
+        uint32_t body_b;
+        KinematicObject* object_a;
+        KinematicObject* object_b;
+    };
 }
 }
\ No newline at end of file
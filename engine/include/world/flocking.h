@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "actor.h"
+#include "spatial_hash.h"
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Flocking
+{
+    // Reynolds-style group steering (separation, cohesion, alignment).
+    // Neighbors come from a SpatialHashGrid rebuilt every tick, so the cost is
+    // linear in the swarm size instead of all-pairs.
+
+    struct FlockingParams
+    {
+        float neighbor_radius{3.f};     // meters, cohesion + alignment range
+        float separation_radius{1.f};   // meters, push-apart range
+        float separation_weight{1.5f};
+        float cohesion_weight{1.f};
+        float alignment_weight{1.f};
+        float max_linear{2.f};          // meters per second, clamp on the combined output
+    };
+
+    class Flock
+    {
+    public:
+        Flock(const FlockingParams& params = {}, Threading::ThreadPool& pool = Threading::ThreadPool::shared());
+
+        inline FlockingParams& params() { return m_params; }
+
+        // one output per actor, in actor order; valid until the next compute()
+        const std::vector<SteeringOutput>& compute(const std::vector<Actor*>& actors);
+
+        // compute() and hand each actor its output as a single-tick steering handle;
+        // call it before the actors' update() for the same tick
+        void steer(const std::vector<Actor*>& actors, const Event_NextTick& event);
+
+    private:
+        FlockingParams m_params;
+        Threading::ThreadPool& m_pool;
+        SpatialHashGrid m_grid;
+
+        std::vector<glm::vec2> m_positions;
+        std::vector<glm::vec2> m_velocities;
+        std::vector<SteeringOutput> m_outputs;
+    };
+}
+}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "entt/entity/registry.hpp"
+
+#include "events.h"
+#include "physics.h"
+#include "prefab.h"
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Kinematics
+{
+    // KinematicObject split into entt components for Registry::m_objects.
+    // Position, Velocity and Heading are owned by one group, so the integrate, cull and
+    // render passes walk packed arrays. Limits and steering queues sit in plain storage
+    // and are only looked up when a handle is added or an entity is steered.
+    // The math is World::Motion, the same code KinematicObject runs.
+
+    struct Position
+    {
+        glm::vec2 value{0.f, 0.f};       // meters
+    };
+
+    struct Velocity
+    {
+        glm::vec2 linear{0.f, 0.f};      // unclamped steering sum, meters per second
+        float angular{0.f};              // heading change per second
+        glm::vec2 avoidance{0.f, 0.f};   // overrides linear for the next integrate
+        glm::vec2 effective{0.f, 0.f};   // velocity actually moved with last tick
+        bool b_has_avoidance{false};
+    };
+
+    struct Heading
+    {
+        float degrees{0.f};              // [-180, 180] wrt 0=north
+    };
+
+    struct MotionLimits
+    {
+        float max_speed{1.f};            // meters per second
+        float max_acceleration{5.f};
+        float radius{0.5f};              // meters
+    };
+
+    struct SteeringQueue
+    {
+        std::vector<SteeringOutputHandle> handles;   // sorted by time left
+    };
+
+    // the one group that owns the hot components; every hot pass goes through it
+    inline auto motion_group(entt::registry& registry)
+    {
+        return registry.group<Position, Velocity, Heading>();
+    }
+
+    entt::entity create(entt::registry& registry, const float x, const float y);
+
+    // all components at their defaults, limits as given
+    Prefab prefab(const MotionLimits& limits = {});
+    // one batch spawn, positions[i] for the i-th new entity
+    void create_many(entt::registry& registry, const glm::vec2* positions, const size_t count, std::vector<entt::entity>& out_entities, const MotionLimits& limits = {});
+
+    void set_max_speed(entt::registry& registry, const entt::entity entity, const float max_speed);
+    void set_avoidance_velocity(entt::registry& registry, const entt::entity entity, const glm::vec2& velocity);
+    void add_steering(entt::registry& registry, const entt::entity entity, const SteeringOutputHandle& handle, const double current_tick);
+    void halt(entt::registry& registry, const entt::entity entity);
+
+    // World Update, same order as KinematicObject::update
+    void steer(entt::registry& registry, const Event_NextTick& event);
+    void integrate(entt::registry& registry, const Event_NextTick& event);
+    void update(entt::registry& registry, const Event_NextTick& event);
+
+    // entities whose position is inside [lo, hi]; returns how many were appended
+    size_t cull(entt::registry& registry, const glm::vec2& lo, const glm::vec2& hi, std::vector<entt::entity>& out_entities);
+
+    // xyz in render space (see KinematicObject::get_position_in_render_space), w = heading in radians
+    void gather_render_positions(entt::registry& registry, std::vector<glm::vec4>& out_positions);
+}
+}
+}
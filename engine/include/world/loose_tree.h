@@ -0,0 +1,157 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "sk_world.h"
+
+namespace SketchBook
+{
+namespace View
+{
+    // Loose quadtree (Dim = 2, x/y) and loose octree (Dim = 3) with the same query
+    // interface as World2dModel. Each node's loose bounds are twice its cell, so an
+    // object is bucketed by its size and center and only moves to another node once
+    // it leaves those loose bounds; small per-tick motion never touches the tree.
+    // Nodes and object entries live in index-linked pools, queries are const and
+    // safe to run from many threads between updates.
+    template<int Dim>
+    class LooseTree
+    {
+    public:
+        static_assert(Dim == 2 || Dim == 3, "LooseTree is a quadtree or an octree");
+
+        static constexpr int CHILDREN = 1 << Dim;
+        static constexpr int MAX_DEPTH = 12;
+        static constexpr size_t MAX_NEAREST = 64;
+
+        LooseTree(const glm::vec3& center, const float half_extent, const int max_depth = 8);
+
+        void clear();
+        void load(const std::vector<WorldObject>& in_objects);
+
+        bool insert(const WorldObject& object);
+        bool remove(const int id);
+
+        // moves an object; returns true when it left its node's loose bounds and was re-bucketed
+        bool move_object(const int id, const glm::vec3& delta);
+
+        WorldObject* get_object(const int id);
+        const WorldObject* get_object(const int id) const;
+
+        inline size_t size() const { return m_slots.size(); }
+        inline size_t node_count() const { return m_nodes.size() - m_free_nodes.size(); }
+
+        size_t query_box(const WorldBox& box, int* out_ids, const size_t capacity) const;
+        size_t query_point(const WorldPoint& point, int* out_ids, const size_t capacity) const;
+        // k nearest by distance to each object's bounds, closest first; k is clamped to MAX_NEAREST
+        size_t query_nearest(const WorldPoint& point, const size_t k, int* out_ids, const size_t capacity) const;
+
+        // f(const WorldObject&) for every object whose bounds intersect box
+        template<typename F>
+        void for_each_in_box(const WorldBox& box, F&& f) const
+        {
+            const glm::vec3 min_corner{box.minCorner.x, box.minCorner.y, box.minCorner.h};
+            const glm::vec3 max_corner{box.maxCorner.x, box.maxCorner.y, box.maxCorner.h};
+
+            // depth-first with a fixed stack: at most CHILDREN - 1 siblings wait per level
+            int32_t stack[MAX_DEPTH * CHILDREN + 1];
+            int top = 0;
+            stack[top++] = 0;
+
+            while (top > 0)
+            {
+                const Node& node = m_nodes[stack[--top]];
+
+                for (int32_t e = node.head; e != NONE; e = m_entries[e].next)
+                {
+                    const WorldObject& object = m_entries[e].object;
+                    if (overlaps(object.min_corner, object.max_corner, min_corner, max_corner)) f(object);
+                }
+
+                for (int c = 0; c < CHILDREN; c++)
+                {
+                    const int32_t child = node.children[c];
+                    if (child == NONE) continue;
+
+                    const Node& child_node = m_nodes[child];
+                    const glm::vec3 loose(child_node.half * 2.f);
+                    if (overlaps(child_node.center - loose, child_node.center + loose, min_corner, max_corner))
+                    {
+                        stack[top++] = child;
+                    }
+                }
+            }
+        }
+
+        // f(const WorldObject&) for every object whose bounds are within radius of center
+        template<typename F>
+        void for_each_in_radius(const glm::vec3& center, const float radius, F&& f) const
+        {
+            const float radius_sq = radius * radius;
+            for_each_in_box(to_world_box(center - glm::vec3(radius), center + glm::vec3(radius)), [&](const WorldObject& object) {
+                if (distance_sq(center, object) <= radius_sq) f(object);
+            });
+        }
+
+        // distance over the indexed axes only, so a quadtree ignores height
+        static float distance_sq(const glm::vec3& point, const WorldObject& object);
+
+    private:
+        static constexpr int32_t NONE = -1;
+
+        struct Node
+        {
+            glm::vec3 center;
+            float half;
+            int depth;
+            int32_t parent;
+            int32_t children[CHILDREN];
+            int32_t head;           // first entry bucketed here
+            int child_count;
+        };
+
+        struct Entry
+        {
+            WorldObject object;
+            int32_t node;
+            int32_t prev;
+            int32_t next;
+        };
+
+        static inline bool overlaps(const glm::vec3& a_min, const glm::vec3& a_max, const glm::vec3& b_min, const glm::vec3& b_max)
+        {
+            for (int i = 0; i < Dim; i++)
+            {
+                if (a_min[i] > b_max[i] || b_min[i] > a_max[i]) return false;
+            }
+            return true;
+        }
+
+        bool fits_loose(const Node& node, const WorldObject& object) const;
+        int32_t allocate_node(const glm::vec3& center, const float half, const int depth, const int32_t parent);
+        int32_t find_node(const WorldObject& object);
+        void link(const int32_t entry, const int32_t node);
+        void unlink(const int32_t entry);
+        void prune(int32_t node);
+
+        glm::vec3 m_center;
+        float m_half_extent;
+        int m_max_depth;
+
+        std::vector<Node> m_nodes;
+        std::vector<int32_t> m_free_nodes;
+        std::vector<Entry> m_entries;
+        std::vector<int32_t> m_free_entries;
+        std::unordered_map<int, int32_t> m_slots;   // object id -> entry
+    };
+
+    using LooseQuadtree = LooseTree<2>;
+    using LooseOctree = LooseTree<3>;
+
+    extern template class LooseTree<2>;
+    extern template class LooseTree<3>;
+}
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "physics.h"
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Pathfinding
+{
+    // Hierarchical A* (HPA*) over a walkability grid.
+    // The grid is cut into square clusters; walkable runs along shared cluster borders
+    // become portal nodes, and portals inside the same cluster are linked by precomputed
+    // intra-cluster costs. Queries search the small portal graph, then refine each
+    // abstract edge with a grid search bounded to a single cluster.
+
+    struct GridCell
+    {
+        int x{0};
+        int y{0};
+
+        bool operator==(const GridCell& other) const { return x == other.x && y == other.y; }
+        bool operator!=(const GridCell& other) const { return !(*this == other); }
+    };
+
+    class NavigationGrid
+    {
+    public:
+        NavigationGrid(const int width, const int height, const float cell_size = 1.f, const glm::vec2 origin = {0.f, 0.f});
+
+        inline int width() const { return m_width; }
+        inline int height() const { return m_height; }
+        inline float cell_size() const { return m_cell_size; }
+
+        inline bool in_bounds(const GridCell& cell) const
+        {
+            return cell.x >= 0 && cell.y >= 0 && cell.x < m_width && cell.y < m_height;
+        }
+
+        inline bool is_walkable(const GridCell& cell) const
+        {
+            return in_bounds(cell) && m_walkable[index(cell)] != 0;
+        }
+
+        inline int index(const GridCell& cell) const { return cell.y * m_width + cell.x; }
+
+        void set_walkable(const GridCell& cell, const bool walkable);
+        void set_walkable_rect(const GridCell& min_cell, const GridCell& max_cell, const bool walkable);
+
+        GridCell cell_at(const glm::vec2& world_position) const;
+        glm::vec2 cell_center(const GridCell& cell) const;
+
+    private:
+        int m_width;
+        int m_height;
+        float m_cell_size; // meters
+        glm::vec2 m_origin;
+        std::vector<uint8_t> m_walkable;
+    };
+
+    struct AbstractEdge
+    {
+        int to;
+        float cost; // in cells
+        bool b_inter_cluster;
+    };
+
+    struct AbstractNode
+    {
+        GridCell cell;
+        int cluster;
+        std::vector<AbstractEdge> edges;
+    };
+
+    class HierarchicalGraph
+    {
+    public:
+        HierarchicalGraph(NavigationGrid grid, const int cluster_size = 16);
+
+        inline const NavigationGrid& grid() const { return m_grid; }
+        inline int cluster_size() const { return m_cluster_size; }
+        inline int cluster_count() const { return m_clusters_x * m_clusters_y; }
+        inline const std::vector<AbstractNode>& nodes() const { return m_nodes; }
+
+        int cluster_of(const GridCell& cell) const;
+
+        // Cell path from start to goal (both inclusive).
+        // cached_chain: portal sequence to try first (validated, ignored if it no longer connects)
+        // out_chain: portal sequence actually used, empty for paths local to one cluster
+        bool find_path(
+            const GridCell& start,
+            const GridCell& goal,
+            std::vector<GridCell>& out_cells,
+            const std::vector<int>* cached_chain = nullptr,
+            std::vector<int>* out_chain = nullptr) const;
+
+        // removes waypoints that have a clear straight line between their neighbors
+        void smooth_path(std::vector<GridCell>& cells) const;
+
+    private:
+        struct ClusterRect
+        {
+            GridCell min_cell;
+            GridCell max_cell;
+        };
+
+        ClusterRect cluster_rect(const int cluster) const;
+        int add_node(const GridCell& cell);
+        void add_edge(const int from, const int to, const float cost, const bool inter_cluster);
+        void build_entrances();
+        void build_entrance_run(const GridCell& a0, const GridCell& b0, const GridCell& step, const int length);
+        void build_intra_edges();
+
+        // A* (goal != nullptr) or Dijkstra (goal == nullptr) bounded to rect;
+        // out_dist is indexed by rect-local cell index
+        bool search_grid(
+            const GridCell& start,
+            const GridCell* goal,
+            const ClusterRect& rect,
+            std::vector<float>& out_dist,
+            std::vector<int>& out_parent) const;
+
+        bool local_path(const GridCell& start, const GridCell& goal, const ClusterRect& rect, std::vector<GridCell>& out_cells) const;
+        bool refine_chain(const GridCell& start, const GridCell& goal, const std::vector<int>& chain, std::vector<GridCell>& out_cells) const;
+        bool search_abstract(const GridCell& start, const GridCell& goal, std::vector<int>& out_chain) const;
+        bool line_of_sight(const GridCell& a, const GridCell& b) const;
+
+        NavigationGrid m_grid;
+        int m_cluster_size;
+        int m_clusters_x;
+        int m_clusters_y;
+        std::vector<AbstractNode> m_nodes;
+        std::vector<std::vector<int>> m_cluster_nodes;
+        std::vector<int> m_node_at_cell; // grid index -> node id, -1 for none
+    };
+
+    struct PathRequest
+    {
+        glm::vec2 start;
+        glm::vec2 goal;
+        float speed; // meters per second
+        double tick;
+        float seconds_per_tick;
+        bool b_smooth{true};
+    };
+
+    struct PathResult
+    {
+        bool b_found{false};
+        bool b_cache_hit{false};
+        std::vector<glm::vec2> waypoints;
+        // one finite handle per straight segment, back to back in tick order
+        std::vector<SteeringOutputHandle> steering;
+    };
+
+    // Solves path requests on a worker pool against a shared, read-only graph.
+    // Portal chains are cached per (start cluster, goal cluster) pair; once the
+    // cache is full the oldest pair is evicted first.
+    class PathfindingService
+    {
+    public:
+        PathfindingService(
+            std::shared_ptr<const HierarchicalGraph> graph,
+            Threading::ThreadPool& pool = Threading::ThreadPool::shared(),
+            const size_t cache_capacity = 4096);
+
+        std::future<PathResult> request(const PathRequest& path_request);
+        PathResult solve(const PathRequest& path_request);
+
+        void clear_cache();
+        size_t cache_size() const;
+        size_t cache_hits() const;
+
+    private:
+        struct State;
+        std::shared_ptr<State> m_state;
+        Threading::ThreadPool& m_pool;
+    };
+
+    // Feeds a path's steering chain into a KinematicObject one segment at a time.
+    // Call update() before the object's own update for the tick, so the next
+    // segment is added on the same tick the previous one expires.
+    struct PathFollower
+    {
+        void follow(PathResult&& path, const double current_tick);
+        void update(KinematicObject& object, const Event_NextTick& event);
+
+        inline bool is_finished() const { return m_next_segment >= m_path.steering.size(); }
+        inline const PathResult& path() const { return m_path; }
+
+    private:
+        PathResult m_path;
+        size_t m_next_segment{0};
+    };
+}
+}
+}
@@ -2,6 +2,7 @@
 #include "spdlog/spdlog.h"
 #include <glm/glm.hpp>
 #include <cmath>
+#include <vector>
 #include "./events.h"
 
 namespace SketchBook
@@ -62,6 +63,30 @@ namespace World
             const bool is_dynamic=false);
     };
 
+    // Steering and integration math shared by KinematicObject and the entt kinematic
+    // systems (kinematics.h), so both move an agent the same way.
+    namespace Motion
+    {
+        float wrap_heading(const float heading); // degrees into [-180, 180]
+        float heading_from_velocity(const glm::vec2& velocity);
+        void clamp_speed(glm::vec2& velocity, const float max_speed);
+
+        // non-dynamic handles change the velocity once, when added. The sum is kept
+        // unclamped so remove_steering takes back exactly what add_steering put in;
+        // max speed is applied to the velocity that gets integrated instead.
+        void add_steering(const SteeringOutputHandle& handle, glm::vec2& linear_velocity, float& angular_velocity);
+        void remove_steering(const SteeringOutputHandle& handle, const Event_NextTick& event, glm::vec2& linear_velocity, float& angular_velocity);
+        void apply_steering(const SteeringOutputHandle& handle, const Event_NextTick& event, glm::vec2& position, float& heading, glm::vec2& linear_velocity, float& angular_velocity);
+
+        // keeps handles ordered by time left
+        void sort_steering(std::vector<SteeringOutputHandle>& steering, const double current_tick);
+        // drops expired handles and takes their contribution back out of the velocity
+        void expire_steering(std::vector<SteeringOutputHandle>& steering, const Event_NextTick& event, glm::vec2& linear_velocity, float& angular_velocity);
+
+        // moves by velocity (the steering sum, or the avoidance override) for one tick
+        void integrate(const Event_NextTick& event, const glm::vec2& velocity, const float angular_velocity, glm::vec2& position, float& heading);
+    }
+
     struct KinematicObject
     {
         KinematicObject(const float x, const float y);
@@ -70,15 +95,19 @@ namespace World
         
         const float orientation_radians() const; // facing direction in radians
         const float get_heading() const; // facing direction in degrees [-180, 180] wrt 0=north
-        const glm::vec2 velocity_meter_per_second() const;
+        const glm::vec2 velocity_meter_per_second() const; // steering sum clamped to max speed
         glm::vec3 get_position_in_render_space();
         glm::vec2 get_position() const { return m_position; }
         const std::vector<SteeringOutputHandle>& get_current_steering() const { return current_steering; }
         const float get_max_speed() const { return m_max_speed; }
         const float get_max_acceleration() const { return m_max_acceleration; }
+        const float get_radius() const { return m_radius; }
+        const glm::vec2 effective_velocity() const { return m_effective_velocity; } // velocity actually moved with last tick
 
         // Setters
         void set_max_speed(const float max_speed);
+        void set_radius(const float radius);
+        void set_avoidance_velocity(const glm::vec2& velocity); // overrides the steering velocity for the next integrate()
         void set_heading(const float heading);
         void update_heading(glm::vec2 velocity);
         void update_heading(const float& heading_delta);
@@ -86,7 +115,9 @@ namespace World
         
 
        // World Update
-       void update(const Event_NextTick& event);
+       void update(const Event_NextTick& event); // steer() then integrate()
+       void steer(const Event_NextTick& event);
+       void integrate(const Event_NextTick& event);
        void halt();
 
     private:
@@ -97,12 +128,11 @@ namespace World
         std::vector<SteeringOutputHandle> current_steering;
         float m_max_speed{1.f}; // meters per second
         float m_max_acceleration{5.f}; // m^2 per second
+        float m_radius{0.5f}; // meters
+        glm::vec2 m_avoidance_velocity{0.f, 0.f};
+        glm::vec2 m_effective_velocity{0.f, 0.f};
+        bool b_has_avoidance_velocity{false};
 
-        void max_linear_velocity_guard(glm::vec2& velo);
-        void apply_steering_output(const SteeringOutputHandle& handle, const Event_NextTick& event);
-        void sort_steering(const double& in_current_tick);
-        void update_steering(const Event_NextTick& event);
-        void remove_steering(const SteeringOutputHandle& handle, const Event_NextTick& event);
     };
 
 }
@@ -3,9 +3,11 @@
 #include <glm/glm.hpp>
 #include <glm/vec3.hpp>
 #include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
 #include "sk_geometry.h"
 #include <unordered_map>
-#include <limits>
+#include <utility>
 #include <vector>
 
 namespace bg = boost::geometry;
@@ -17,12 +19,19 @@ namespace View
 {
 
     /* Specs:
-    - [ ] WorldObject struct with box and id values
-    - [ ] create r-tree pairs of <box,id> tuples
-    - [ ] store 
-    
+    - [x] WorldObject struct with box and id values
+    - [x] create r-tree pairs of <box,id> tuples
+    - [x] store
+
     */
 
+   inline WorldPoint to_world_point(const glm::vec3& v) { return WorldPoint{v.x, v.y, v.z}; }
+
+   inline WorldBox to_world_box(const glm::vec3& min_corner, const glm::vec3& max_corner)
+   {
+        return WorldBox{to_world_point(min_corner), to_world_point(max_corner)};
+   }
+
    struct WorldObject
    {
         glm::vec3 position = {};
@@ -30,13 +39,34 @@ namespace View
         glm::vec3 max_corner = {};
         int id;
         void* obj = nullptr;
-        
-        void update_position(const glm::vec3& delta)
+
+        // slack (fat) bounds stored in the spatial index; moving inside them needs no index update
+        glm::vec3 slack_min_corner = {};
+        glm::vec3 slack_max_corner = {};
+
+        // returns true once the object has left its slack box and must be re-inserted
+        bool update_position(const glm::vec3& delta)
         {
             position += delta;
             min_corner += delta;
             max_corner += delta;
+            return !inside_slack();
         };
+
+        bool inside_slack() const
+        {
+            return min_corner.x >= slack_min_corner.x && min_corner.y >= slack_min_corner.y && min_corner.z >= slack_min_corner.z
+                && max_corner.x <= slack_max_corner.x && max_corner.y <= slack_max_corner.y && max_corner.z <= slack_max_corner.z;
+        }
+
+        void reset_slack(const float margin)
+        {
+            slack_min_corner = min_corner - glm::vec3(margin);
+            slack_max_corner = max_corner + glm::vec3(margin);
+        }
+
+        WorldBox box() const { return to_world_box(min_corner, max_corner); }
+        WorldBox slack_box() const { return to_world_box(slack_min_corner, slack_max_corner); }
    };
 
    class World2dView
@@ -49,85 +79,70 @@ namespace View
 
    };
 
+    // Spatial index over WorldObjects, backed by a boost r-tree of <slack box, id> pairs.
+    // Queries write ids into caller-owned buffers and never allocate; they return the total
+    // number of matches, which may exceed the buffer capacity.
     class World2dModel
     {
-        glm::vec3 view_boundary = {1.f, 1.f, 1.f};
-        glm::vec3 world_origin = {0.f, 0.f, 0.f};
-        glm::vec3 corner_extent = {1.f, 1.f, 1.f};
+    public:
+        using IndexValue = std::pair<WorldBox, int>;
+        using RTree = bgi::rtree<IndexValue, bgi::rstar<16>>;
 
-        std::unordered_map<int, WorldObject> objects;
+        static constexpr size_t MAX_NEAREST = 64;
 
-        /*
-        Use boost to implement an r-tree for geo queries and item display (for infinite world)?
-        - https://stackoverflow.com/questions/42182537/how-can-i-use-the-rtree-of-the-boost-library-in-c
-        */
-    };
-}
-}
+        explicit World2dModel(const float slack_margin = 0.5f) : slack_margin{slack_margin} {}
 
-/*
+        // replaces the contents using the r-tree packing (STR) bulk load
+        void load(std::vector<WorldObject> in_objects);
 
-// https://stackoverflow.com/a/42253289
+        bool insert(const WorldObject& object);
+        bool remove(const int id);
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/register/point.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <iostream>
-#include <limits>
-#include <vector>
-
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-
-class LatLon
-{
-public:
-    LatLon(){}
-    explicit LatLon(float lat_, float lon_) : m_lat(lat_),m_lon(lon_){}
-
-    float lat() const { return m_lat; }
-    float lon() const { return m_lon; }
-
-private:
-    float m_lat = std::numeric_limits<float>::quiet_NaN();
-    float m_lon = std::numeric_limits<float>::quiet_NaN();
-};
-
-struct MyLatLon
-{
-    MyLatLon() {}
-    MyLatLon(float lat_, float lon_) : ll(lat_, lon_){}
+        // moves an object; returns true when it left its slack box and was re-inserted
+        bool move_object(const int id, const glm::vec3& delta);
 
-    float get_lat() const { return ll.lat(); }
-    float get_lon() const { return ll.lon(); }
-    void set_lat(float v) { ll = LatLon(v, ll.lon()); }
-    void set_lon(float v) { ll = LatLon(ll.lat(), v); }
+        WorldObject* get_object(const int id);
+        const WorldObject* get_object(const int id) const;
 
-    LatLon ll;
-};
+        inline size_t size() const { return objects.size(); }
+        inline float get_slack_margin() const { return slack_margin; }
 
-BOOST_GEOMETRY_REGISTER_POINT_2D_GET_SET(MyLatLon, float,
-                                         bg::cs::spherical_equatorial<bg::degree>,
-                                         get_lon, get_lat, set_lon, set_lat)
+        size_t query_box(const WorldBox& box, int* out_ids, const size_t capacity) const;
+        size_t query_point(const WorldPoint& point, int* out_ids, const size_t capacity) const;
+        // k nearest by distance to each object's bounds, closest first; k is clamped to MAX_NEAREST
+        size_t query_nearest(const WorldPoint& point, const size_t k, int* out_ids, const size_t capacity) const;
 
-int main()
-{
-    typedef std::pair<MyLatLon, unsigned> point_pair;
-
-    bgi::rtree<point_pair, bgi::quadratic<16>> intersectionRTree;
+        // f(const WorldObject&) for every object whose bounds intersect box
+        template<typename F>
+        void for_each_in_box(const WorldBox& box, F&& f) const
+        {
+            auto visit = [&](const IndexValue& value) {
+                const WorldObject& object = objects.find(value.second)->second;
+                if (bg::intersects(object.box(), box)) f(object);
+            };
+            rtree.query(bgi::intersects(box), boost::make_function_output_iterator(visit));
+        }
+
+        // f(const WorldObject&) for every object whose bounds are within radius of center
+        template<typename F>
+        void for_each_in_radius(const glm::vec3& center, const float radius, F&& f) const
+        {
+            const float radius_sq = radius * radius;
+            for_each_in_box(to_world_box(center - glm::vec3(radius), center + glm::vec3(radius)), [&](const WorldObject& object) {
+                if (distance_sq(center, object) <= radius_sq) f(object);
+            });
+        }
 
-    intersectionRTree.insert(std::make_pair(MyLatLon(0, 0), 0));
-    intersectionRTree.insert(std::make_pair(MyLatLon(2, 2), 1));
+        static float distance_sq(const glm::vec3& point, const WorldObject& object);
 
-    bg::model::box<MyLatLon> b(MyLatLon(1, 1), MyLatLon(3, 3));
-    std::vector<point_pair> result1;
-    intersectionRTree.query(bgi::intersects(b), std::back_inserter(result1));
-    if (! result1.empty())
-        std::cout << bg::wkt(result1[0].first) << std::endl;
+    private:
+        glm::vec3 view_boundary = {1.f, 1.f, 1.f};
+        glm::vec3 world_origin = {0.f, 0.f, 0.f};
+        glm::vec3 corner_extent = {1.f, 1.f, 1.f};
 
-    std::vector<point_pair> result2;
-    intersectionRTree.query(bgi::nearest(MyLatLon(0, 1), 1), std::back_inserter(result2));
-    if (! result2.empty())
-        std::cout << bg::wkt(result2[0].first) << std::endl;
+        float slack_margin;
+        std::unordered_map<int, WorldObject> objects;
+        RTree rtree;
+    };
+}
 }
-*/
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SketchBook
+{
+namespace World
+{
+    // Uniform grid rebuilt from scratch every tick.
+    // build() counting-sorts items by cell, so each cell is a contiguous run of
+    // item ids/positions and a neighbor query walks a handful of dense ranges.
+    // Queries are const and safe to run from many threads after a build.
+    class SpatialHashGrid
+    {
+    public:
+        explicit SpatialHashGrid(const float cell_size = 1.f) : m_cell_size{cell_size} {}
+
+        void set_cell_size(const float cell_size) { m_cell_size = std::max(cell_size, 1e-4f); }
+        inline float cell_size() const { return m_effective_cell_size; }
+        inline size_t size() const { return m_items.size(); }
+
+        void build(const glm::vec2* positions, const size_t count);
+        void build(const std::vector<glm::vec2>& positions) { build(positions.data(), positions.size()); }
+
+        // f(uint32_t item, const glm::vec2& position) for every item within radius of center
+        template<typename F>
+        void for_each_in_radius(const glm::vec2& center, const float radius, F&& f) const
+        {
+            const float radius_sq = radius * radius;
+            for_each_cell_range(center - glm::vec2(radius), center + glm::vec2(radius), [&](const uint32_t first, const uint32_t last) {
+                for (uint32_t i = first; i < last; i++)
+                {
+                    const glm::vec2 delta = m_positions[i] - center;
+                    if (glm::dot(delta, delta) <= radius_sq)
+                    {
+                        f(m_items[i], m_positions[i]);
+                    }
+                }
+            });
+        }
+
+        // f(uint32_t item, const glm::vec2& position) for every item inside [min_corner, max_corner]
+        template<typename F>
+        void for_each_in_box(const glm::vec2& min_corner, const glm::vec2& max_corner, F&& f) const
+        {
+            for_each_cell_range(min_corner, max_corner, [&](const uint32_t first, const uint32_t last) {
+                for (uint32_t i = first; i < last; i++)
+                {
+                    const glm::vec2& p = m_positions[i];
+                    if (p.x >= min_corner.x && p.y >= min_corner.y && p.x <= max_corner.x && p.y <= max_corner.y)
+                    {
+                        f(m_items[i], p);
+                    }
+                }
+            });
+        }
+
+    private:
+        template<typename F>
+        void for_each_cell_range(const glm::vec2& min_corner, const glm::vec2& max_corner, F&& f) const
+        {
+            if (m_items.empty()) return;
+
+            const int min_x = std::max(cell_coord(min_corner.x - m_origin.x), 0);
+            const int min_y = std::max(cell_coord(min_corner.y - m_origin.y), 0);
+            const int max_x = std::min(cell_coord(max_corner.x - m_origin.x), m_cells_x - 1);
+            const int max_y = std::min(cell_coord(max_corner.y - m_origin.y), m_cells_y - 1);
+            // boxes entirely outside the grid touch no cells
+            if (min_x > max_x || min_y > max_y) return;
+
+            for (int y = min_y; y <= max_y; y++)
+            {
+                // a row of cells is one contiguous run in the sorted layout
+                const size_t row = static_cast<size_t>(y) * static_cast<size_t>(m_cells_x);
+                const uint32_t first = m_cell_start[row + min_x];
+                const uint32_t last = m_cell_start[row + max_x + 1];
+                if (first < last) f(first, last);
+            }
+        }
+
+        inline int cell_coord(const float offset) const
+        {
+            // clamp before the int cast so far-away queries do not overflow
+            const float c = std::floor(offset * m_inv_cell_size);
+            return static_cast<int>(std::clamp(c, -1.f, static_cast<float>(1 << 30)));
+        }
+
+        float m_cell_size;
+        float m_effective_cell_size{1.f};
+        float m_inv_cell_size{1.f};
+        glm::vec2 m_origin{0.f, 0.f};
+        int m_cells_x{0};
+        int m_cells_y{0};
+
+        std::vector<uint32_t> m_cell_start;     // cells_x * cells_y + 1 offsets into m_items
+        std::vector<uint32_t> m_items;          // item ids sorted by cell
+        std::vector<glm::vec2> m_positions;     // positions in the same order as m_items
+        std::vector<uint32_t> m_item_cell;      // scratch: cell of each input item
+    };
+}
+}
@@ -141,6 +141,9 @@ namespace World
         const double current_tick() const {return m_world.current_tick(); }
         const bool is_paused() const { return m_world.is_running(); }
 
+        // tick and collision events share the world's dispatcher
+        entt::dispatcher& event_dispatcher() { return m_world.event_dispatcher(); }
+
         void connect_world_object(WorldObject* obj)
         {
             m_world.event_dispatcher().sink<Event_NextTick>().connect<&WorldObject::next_tick>(obj);
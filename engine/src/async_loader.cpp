@@ -0,0 +1,104 @@
+#include "async_loader.h"
+
+#include "spdlog/spdlog.h"
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        AsyncLoader::AsyncLoader(Threading::ThreadPool& pool)
+            : m_pool(pool)
+        {
+        }
+
+        AsyncLoader::~AsyncLoader()
+        {
+            cancel();
+        }
+
+        void AsyncLoader::start(std::shared_ptr<JobBase> job)
+        {
+            {
+                std::scoped_lock lock(m_mutex);
+                ++m_decoding;
+            }
+
+            m_pool.submit([this, job]() { run_decode(job); });
+        }
+
+        void AsyncLoader::run_decode(const std::shared_ptr<JobBase>& job)
+        {
+            bool b_decoded = false;
+            try
+            {
+                b_decoded = job->decode();
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::error("async load failed: {}", e.what());
+            }
+
+            std::scoped_lock lock(m_mutex);
+            job->b_decoded = b_decoded;
+            m_decoded.push_back(job);
+            --m_decoding;
+            m_cv.notify_all();
+        }
+
+        size_t AsyncLoader::pump(const size_t max_finishes)
+        {
+            size_t finished = 0;
+            while (finished < max_finishes)
+            {
+                std::shared_ptr<JobBase> job;
+                {
+                    std::scoped_lock lock(m_mutex);
+                    if (m_decoded.empty()) break;
+                    job = std::move(m_decoded.front());
+                    m_decoded.pop_front();
+                }
+
+                const bool b_ready = job->b_decoded && job->finish();
+                job->status->store(b_ready ? LoadStatus::Ready : LoadStatus::Failed, std::memory_order_release);
+                ++finished;
+            }
+            return finished;
+        }
+
+        void AsyncLoader::wait_decoded()
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_decoding == 0; });
+        }
+
+        void AsyncLoader::finish_all()
+        {
+            wait_decoded();
+            pump();
+        }
+
+        void AsyncLoader::cancel()
+        {
+            wait_decoded();
+
+            std::scoped_lock lock(m_mutex);
+            for (const std::shared_ptr<JobBase>& job : m_decoded)
+            {
+                job->status->store(LoadStatus::Failed, std::memory_order_release);
+            }
+            m_decoded.clear();
+        }
+
+        size_t AsyncLoader::pending() const
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_decoding + m_decoded.size();
+        }
+
+        bool AsyncLoader::has_decoded() const
+        {
+            std::scoped_lock lock(m_mutex);
+            return !m_decoded.empty();
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include "command_buffer.h"
+
+#include <algorithm>
+
+namespace SketchBook
+{
+    uint32_t EntityCommandBuffer::next_slot()
+    {
+        static std::atomic<uint32_t> slots{0};
+        return slots.fetch_add(1);
+    }
+
+    PendingEntity EntityCommandBuffer::create()
+    {
+        const PendingEntity entity{m_create_count++};
+        record(Op::Create, Target::of(entity), 0, 0);
+        return entity;
+    }
+
+    void EntityCommandBuffer::destroy(const entt::entity entity)
+    {
+        record(Op::Destroy, Target::of(entity), 0, 0);
+    }
+
+    void EntityCommandBuffer::destroy(const PendingEntity entity)
+    {
+        record(Op::Destroy, Target::of(entity), 0, 0);
+    }
+
+    void EntityCommandBuffer::clear()
+    {
+        m_order = 0;
+        m_commands.clear();
+        m_created.clear();
+        m_create_count = 0;
+        for (auto& pool : m_pools)
+        {
+            if (pool) pool->clear();
+        }
+    }
+
+    CommandBuffers::CommandBuffers(Threading::ThreadPool& pool)
+        : m_pool{pool}, m_buffers(pool.thread_count() + 1)
+    {
+    }
+
+    size_t CommandBuffers::size() const
+    {
+        size_t count = 0;
+        for (const EntityCommandBuffer& buffer : m_buffers)
+        {
+            count += buffer.size();
+        }
+        return count;
+    }
+
+    void CommandBuffers::playback(entt::registry& registry)
+    {
+        using Op = EntityCommandBuffer::Op;
+
+        // deterministic merge: by order key, then buffer, then recording order.
+        // Each buffer is already sorted by recording order, and in practice by key too.
+        m_merge.clear();
+        size_t create_count = 0;
+        for (uint32_t b = 0; b < m_buffers.size(); b++)
+        {
+            const EntityCommandBuffer& buffer = m_buffers[b];
+            for (uint32_t c = 0; c < buffer.m_commands.size(); c++)
+            {
+                m_merge.push_back(MergeEntry{buffer.m_commands[c].order, b, c});
+            }
+            create_count += buffer.m_create_count;
+        }
+        if (m_merge.empty()) return;
+
+        std::stable_sort(m_merge.begin(), m_merge.end(), [](const MergeEntry& l, const MergeEntry& r) {
+            return l.order < r.order || (l.order == r.order && l.buffer < r.buffer);
+        });
+
+        // batched growth: one range create, one reserve per touched storage
+        m_created.resize(create_count);
+        registry.create(m_created.begin(), m_created.end());
+
+        m_reserve.clear();
+        for (EntityCommandBuffer& buffer : m_buffers)
+        {
+            buffer.m_created.resize(buffer.m_create_count);
+            if (buffer.m_pools.size() > m_reserve.size()) m_reserve.resize(buffer.m_pools.size());
+            for (auto& pool : buffer.m_pools)
+            {
+                if (!pool || pool->pending_emplaces == 0) continue;
+                m_reserve[pool->slot].first = pool.get();
+                m_reserve[pool->slot].second += pool->pending_emplaces;
+            }
+        }
+        for (const auto& [pool, count] : m_reserve)
+        {
+            if (pool) pool->reserve(registry, count);
+        }
+
+        // hand out the new entities in merge order so ids do not depend on thread timing
+        size_t next_created = 0;
+        for (const MergeEntry& entry : m_merge)
+        {
+            EntityCommandBuffer& buffer = m_buffers[entry.buffer];
+            const EntityCommandBuffer::Command& command = buffer.m_commands[entry.command];
+            if (command.op == Op::Create)
+            {
+                buffer.m_created[command.target.pending] = m_created[next_created++];
+            }
+        }
+
+        for (const MergeEntry& entry : m_merge)
+        {
+            EntityCommandBuffer& buffer = m_buffers[entry.buffer];
+            const EntityCommandBuffer::Command& command = buffer.m_commands[entry.command];
+
+            const entt::entity entity = (command.target.pending == EntityCommandBuffer::Target::NOT_PENDING)
+                ? command.target.entity
+                : buffer.m_created[command.target.pending];
+            if (command.op == Op::Create || !registry.valid(entity)) continue;
+
+            switch (command.op)
+            {
+                case Op::Destroy:
+                    registry.destroy(entity);
+                    break;
+                case Op::Emplace:
+                    buffer.m_pools[command.slot]->emplace(registry, entity, command.payload);
+                    break;
+                case Op::Remove:
+                    buffer.m_pools[command.slot]->remove(registry, entity);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        for (EntityCommandBuffer& buffer : m_buffers)
+        {
+            buffer.clear();
+        }
+    }
+}
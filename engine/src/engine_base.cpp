@@ -3,9 +3,17 @@
 #include "sk_views.h"
 #include "spdlog/spdlog.h"
 #include "sk_io.h"
+#include "mesh_cache.h"
+#include "mesh_optimizer.h"
+#include "obj_parser.h"
+#include "texture_cache.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
 
 #include <SDL2/SDL.h>
 #include <SDL.h>
@@ -45,14 +53,34 @@ namespace Core
 
     void EngineVulkanBase::immediate_submit(std::function<void(VkCommandBuffer cmd)> && function)
     {
-        VkCommandBuffer cmd = upload_context._commandBuffer;
+        // inside a batch the commands are only recorded; end_upload_batch submits them all
+        if (b_upload_batch_open)
+        {
+            function(upload_context._commandBuffer);
+            return;
+        }
+
+        begin_upload_batch();
+        function(upload_context._commandBuffer);
+        end_upload_batch();
+    }
+
+    void EngineVulkanBase::begin_upload_batch()
+    {
+        if (b_upload_batch_open) return;
+
         //begin the command buffer recording. We will use this command buffer exactly once, so we want to let vulkan know that
         VkCommandBufferBeginInfo cmdBeginInfo = VkInit::command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        VK_CHECK(vkBeginCommandBuffer(upload_context._commandBuffer, &cmdBeginInfo));
+        b_upload_batch_open = true;
+    }
 
-        VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
-
-        function(cmd);
+    void EngineVulkanBase::end_upload_batch()
+    {
+        if (!b_upload_batch_open) return;
+        b_upload_batch_open = false;
 
+        VkCommandBuffer cmd = upload_context._commandBuffer;
         VK_CHECK(vkEndCommandBuffer(cmd));
 
         VkSubmitInfo submit = VkInit::submit_info(&cmd);
@@ -65,6 +93,12 @@ namespace Core
         vkResetFences(m_vk_init.device, 1, &upload_context._uploadFence);
 
         vkResetCommandPool(m_vk_init.device, upload_context._commandPool, 0);
+
+        for (const AllocatedBuffer& staging : m_upload_staging)
+        {
+            vmaDestroyBuffer(m_allocator, staging.buffer, staging.allocation);
+        }
+        m_upload_staging.clear();
     }
 
 
@@ -103,84 +137,232 @@ namespace Core
     {
         spdlog::info("Loading mesh[filename={},base_dir={}]", filename, base_dir);
 
-        //attrib will contain the vertex arrays of the file
-        tinyobj::attrib_t attrib;
-        //shapes contains the info for each separate object in the file
-        std::vector<tinyobj::shape_t> shapes;
-        //materials contains the information about the material of each shape, but we won't use it.
-        std::vector<tinyobj::material_t> materials;
-
-        //error and warning output from the load function
-        std::string warn;
-        std::string err;
-
-        //load the OBJ file
-        IO::LoadObj(&attrib, &shapes, &materials, &warn, &err, filename, base_dir);
-        if (!warn.empty()) {
-             spdlog::warn(warn);
-        }
-        //if we have any error, print it to the console, and break the mesh loading.
-        //This happens if the file can't be found or is malformed
-        if (!err.empty()) {
-            spdlog::error(err);
-            return;
-        }
+        // base_dir only mattered for tinyobj's material lookup; the engine uses geometry only
+        IO::ObjData obj;
+        if (!IO::load_obj(filename, obj)) return;
 
-        for (size_t s = 0; s < shapes.size(); s++) {
-            // Loop over faces(polygon)
-            size_t index_offset = 0;
-            for (size_t f = 0; f < shapes[s].mesh.num_face_vertices.size(); f++) {
+        mesh->indices.reserve(mesh->indices.size() + obj.indices.size());
 
-                //hardcode loading to triangles
-                int fv = 3;
+        // one vertex per distinct (position, normal, texcoord) index triple; equal triples are equal vertices
+        struct ObjIndexHash
+        {
+            size_t operator()(const IO::ObjIndex& idx) const
+            {
+                uint64_t h = static_cast<uint32_t>(idx.position);
+                h = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(idx.normal);
+                h = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(idx.texcoord);
+                return static_cast<size_t>(h ^ (h >> 29));
+            }
+        };
+        struct ObjIndexEqual
+        {
+            bool operator()(const IO::ObjIndex& a, const IO::ObjIndex& b) const
+            {
+                return a.position == b.position && a.normal == b.normal && a.texcoord == b.texcoord;
+            }
+        };
+        std::unordered_map<IO::ObjIndex, uint32_t, ObjIndexHash, ObjIndexEqual> unique_vertices;
+        unique_vertices.reserve(obj.positions.size() / 3 + 1);
+
+        // faces arrive fan triangulated, 3 corners per triangle
+        for (const IO::ObjIndex& idx : obj.indices) {
+            const auto [it, b_inserted] = unique_vertices.try_emplace(idx, static_cast<uint32_t>(mesh->vertices.size()));
+            mesh->indices.push_back(it->second);
+            if (!b_inserted) continue;
+
+            //copy it into our vertex
+            Vertex_RBG_Normal new_vert;
+            new_vert.position.x = obj.positions[3 * idx.position + 0];
+            new_vert.position.y = obj.positions[3 * idx.position + 1];
+            new_vert.position.z = obj.positions[3 * idx.position + 2];
+
+            if (idx.normal >= 0) {
+                new_vert.normal.x = obj.normals[3 * idx.normal + 0];
+                new_vert.normal.y = obj.normals[3 * idx.normal + 1];
+                new_vert.normal.z = obj.normals[3 * idx.normal + 2];
+            } else {
+                new_vert.normal.x = new_vert.normal.y = new_vert.normal.z = 0.f;
+            }
 
-                // Loop over vertices in the face.
-                for (size_t v = 0; v < fv; v++) {
-                    // access to vertex
-                    tinyobj::index_t idx = shapes[s].mesh.indices[index_offset + v];
+            //we are setting the vertex color as the vertex normal. This is just for display purposes
+            new_vert.color = new_vert.normal;
 
-                    //vertex position
-                    tinyobj::real_t vx = attrib.vertices[3 * idx.vertex_index + 0];
-                    tinyobj::real_t vy = attrib.vertices[3 * idx.vertex_index + 1];
-                    tinyobj::real_t vz = attrib.vertices[3 * idx.vertex_index + 2];
-                    //vertex normal
-                    tinyobj::real_t nx = attrib.normals[3 * idx.normal_index + 0];
-                    tinyobj::real_t ny = attrib.normals[3 * idx.normal_index + 1];
-                    tinyobj::real_t nz = attrib.normals[3 * idx.normal_index + 2];
+            mesh->vertices.push_back(new_vert);
+        }
 
-                    //copy it into our vertex
-                    Vertex_RBG_Normal new_vert;
-                    new_vert.position.x = vx;
-                    new_vert.position.y = vy;
-                    new_vert.position.z = vz;
+        spdlog::info("Loaded mesh[filename={},vertices={},indices={}]", filename, mesh->vertices.size(), mesh->indices.size());
+        if (mesh->vertices.empty()) return;
+
+        // import time only: the reordered mesh is what load_mesh caches
+        const size_t vertex_count = mesh->vertices.size();
+        const MeshOptimizer::VertexCacheStats before = MeshOptimizer::analyze_vertex_cache(mesh->indices, vertex_count);
+        MeshOptimizer::optimize_vertex_cache(mesh->indices, vertex_count);
+        MeshOptimizer::optimize_overdraw(mesh->indices, &mesh->vertices[0].position.x, sizeof(Vertex_RBG_Normal), vertex_count);
+        MeshOptimizer::optimize_vertex_fetch(mesh->vertices, mesh->indices);
+        const MeshOptimizer::VertexCacheStats after = MeshOptimizer::analyze_vertex_cache(mesh->indices, mesh->vertices.size());
+        spdlog::info("Optimized mesh[filename={},acmr={:.3f}->{:.3f},atvr={:.3f}->{:.3f}]", filename, before.acmr, after.acmr, before.atvr, after.atvr);
+    }
 
-                    new_vert.normal.x = nx;
-                    new_vert.normal.y = ny;
-                    new_vert.normal.z = nz;
+    // 16-bit indices whenever every vertex fits; returns the data to upload and its size in bytes
+    static const void* pack_indices(const Vertex_RBG_Normal_Mesh& mesh, std::vector<uint16_t>& packed, VkIndexType& out_type, size_t& out_bytes)
+    {
+        if (mesh.vertices.size() <= UINT16_MAX)
+        {
+            packed.assign(mesh.indices.begin(), mesh.indices.end());
+            out_type = VK_INDEX_TYPE_UINT16;
+            out_bytes = packed.size() * sizeof(uint16_t);
+            return packed.data();
+        }
+        out_type = VK_INDEX_TYPE_UINT32;
+        out_bytes = mesh.indices.size() * sizeof(uint32_t);
+        return mesh.indices.data();
+    }
 
-                    //we are setting the vertex color as the vertex normal. This is just for display purposes
-                    new_vert.color = new_vert.normal;
+    void EngineVulkanBase::load_mesh(const char* filename, Vertex_RBG_Normal_Mesh* mesh, const char* base_dir)
+    {
+        MeshSource source;
+        if (!decode_mesh(filename, source, base_dir)) return;
+        upload_mesh_source(source, mesh);
+    }
 
-                    mesh->vertices.push_back(new_vert);
-                }
-                index_offset += fv;
+    bool EngineVulkanBase::decode_mesh(const char* filename, MeshSource& out, const char* base_dir)
+    {
+        uint64_t source_hash = 0;
+        uint64_t source_size = 0;
+        {
+            IO::MappedFile source(filename);
+            if (!source.is_valid())
+            {
+                spdlog::error("failed to open mesh file: {}", filename);
+                return false;
             }
+            source_hash = IO::hash_bytes(source.data(), source.size());
+            source_size = source.size();
+        }
+
+        const std::string cache_path = IO::mesh_cache_path(filename);
+        if (out.cache.open(cache_path, source_hash, source_size, sizeof(Vertex_RBG_Normal)))
+        {
+            spdlog::info("Loading mesh[cache={}]", cache_path);
+            return true;
+        }
+
+        Vertex_RBG_Normal_Mesh* mesh = &out.mesh;
+        load_mesh_from_obj_file(filename, mesh, base_dir);
+        if (mesh->vertices.empty()) return false;
+        mesh->compute_bounds();
+
+        IO::MeshBlobs blobs;
+        blobs.vertices = mesh->vertices.data();
+        blobs.vertex_count = static_cast<uint32_t>(mesh->vertices.size());
+        blobs.vertex_stride = sizeof(Vertex_RBG_Normal);
+        for (int axis = 0; axis < 3; axis++)
+        {
+            blobs.bounds_min[axis] = mesh->bounds_min[axis];
+            blobs.bounds_max[axis] = mesh->bounds_max[axis];
+        }
+
+        std::vector<uint16_t> packed;
+        VkIndexType index_type;
+        size_t index_bytes;
+        blobs.indices = pack_indices(*mesh, packed, index_type, index_bytes);
+        blobs.index_count = static_cast<uint32_t>(mesh->indices.size());
+        blobs.index_size = (index_type == VK_INDEX_TYPE_UINT16) ? 2 : 4;
+
+        if (!IO::write_mesh_cache(cache_path, source_hash, source_size, blobs))
+        {
+            spdlog::warn("failed to write mesh cache: {}", cache_path);
         }
+        return true;
     }
 
-    bool EngineVulkanBase::load_image_from_file(const char *file, AllocatedImage &outImage)
+    void EngineVulkanBase::upload_mesh_source(MeshSource& source, Vertex_RBG_Normal_Mesh* mesh)
     {
-        int texWidth, texHeight, texChannels;
+        if (!source.cache.is_valid())
+        {
+            // parsed from the OBJ: upload_mesh builds the buffers from the CPU copy
+            *mesh = std::move(source.mesh);
+            upload_mesh(mesh);
+            return;
+        }
 
-	    stbi_uc* pixels = stbi_load(file, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+        const IO::MeshCacheFile& cache = source.cache;
+        const IO::SkMeshHeader& header = cache.header();
+        mesh->vertex_buffer = upload_buffer(cache.vertex_data(), cache.vertex_bytes(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        mesh->vertex_count = header.vertex_count;
+        mesh->index_buffer = upload_buffer(cache.index_data(), cache.index_bytes(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        mesh->index_count = header.index_count;
+        mesh->index_type = (header.index_size == 2) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        mesh->bounds_min = glm::vec3(header.bounds_min[0], header.bounds_min[1], header.bounds_min[2]);
+        mesh->bounds_max = glm::vec3(header.bounds_max[0], header.bounds_max[1], header.bounds_max[2]);
+    }
+
+    // an RGBA8 mip chain ready for upload, mapped from the .sktex or built from the source image
+    struct DecodedImage
+    {
+        IO::TextureCacheFile cache;
+        std::vector<uint8_t> chain;                 // when the cache missed
+        const uint8_t* pixels{nullptr};             // into cache or chain
+        size_t bytes{0};
+        std::vector<Imaging::MipLevel> levels;
+    };
+
+    // no Vulkan calls: safe on any thread. A fresh .sktex skips the PNG/JPG decoder and the mip filter.
+    static bool decode_image(const char* file, DecodedImage& out)
+    {
+        IO::MappedFile source(file);
+        if (!source.is_valid()) {
+            spdlog::error("Failed to load texture file: {}", file);
+            return false;
+        }
+        const uint64_t source_hash = IO::hash_bytes(source.data(), source.size());
+        const std::string cache_path = IO::texture_cache_path(file);
+        // the engine's textures are sRGB, see upload_image
+        const bool b_srgb = true;
 
+        if (out.cache.open(cache_path, source_hash, source.size(), b_srgb))
+        {
+            out.pixels = out.cache.pixels();
+            out.bytes = out.cache.pixel_bytes();
+            out.levels.assign(out.cache.levels(), out.cache.levels() + out.cache.level_count());
+            return true;
+        }
+
+        int texWidth, texHeight, texChannels;
+        stbi_uc* pixels = stbi_load_from_memory(source.data(), static_cast<int>(source.size()), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
         if (!pixels) {
             spdlog::error("Failed to load texture file: {}", file);
             return false;
         }
 
-        void* pixel_ptr = pixels;
-        VkDeviceSize imageSize = texWidth * texHeight * 4;
+        Imaging::build_mip_chain(pixels, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), b_srgb, out.chain, out.levels);
+        stbi_image_free(pixels);
+        out.pixels = out.chain.data();
+        out.bytes = out.chain.size();
+
+        if (!IO::write_texture_cache(cache_path, source_hash, source.size(), b_srgb, out.pixels, out.bytes, out.levels))
+        {
+            spdlog::warn("failed to write texture cache: {}", cache_path);
+        }
+        return true;
+    }
+
+    bool EngineVulkanBase::load_image_from_file(const char *file, AllocatedImage &outImage)
+    {
+        DecodedImage decoded;
+        if (!decode_image(file, decoded)) return false;
+        if (!upload_image(decoded.pixels, decoded.bytes, decoded.levels.data(), static_cast<uint32_t>(decoded.levels.size()), outImage)) return false;
+
+        spdlog::info("Texture loaded successfully from file: {}", file);
+        return true;
+    }
+
+    bool EngineVulkanBase::upload_image(const void* pixels, const size_t bytes, const Imaging::MipLevel* levels, const uint32_t level_count, AllocatedImage& outImage)
+    {
+        if (!pixels || bytes == 0 || level_count == 0 || level_count > Imaging::MAX_MIP_LEVELS) return false;
+
+        const void* pixel_ptr = pixels;
+        VkDeviceSize imageSize = bytes;
 
         //the format R8G8B8A8 matches exactly with the pixels loaded from stb_image lib
         VkFormat image_format = VK_FORMAT_R8G8B8A8_SRGB;
@@ -195,15 +377,16 @@ namespace Core
         memcpy(data, pixel_ptr, static_cast<size_t>(imageSize));
 
         vmaUnmapMemory(m_allocator, stagingBuffer.allocation);
-        //we no longer need the loaded data, so we can free the pixels as they are now in the staging buffer
-        stbi_image_free(pixels);
+        // freed once the copy has completed, which may be at the end of an upload batch
+        m_upload_staging.push_back(stagingBuffer);
 
         VkExtent3D imageExtent;
-        imageExtent.width = static_cast<uint32_t>(texWidth);
-        imageExtent.height = static_cast<uint32_t>(texHeight);
+        imageExtent.width = levels[0].width;
+        imageExtent.height = levels[0].height;
         imageExtent.depth = 1;
 
         VkImageCreateInfo dimg_info = VkInit::image_create_info(image_format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
+        dimg_info.mipLevels = level_count;
 
         AllocatedImage newImage;
 
@@ -217,7 +400,7 @@ namespace Core
             VkImageSubresourceRange range;
             range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
             range.baseMipLevel = 0;
-            range.levelCount = 1;
+            range.levelCount = level_count;
             range.baseArrayLayer = 0;
             range.layerCount = 1;
 
@@ -235,19 +418,24 @@ namespace Core
             //barrier the image into the transfer-receive layout
             vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier_toTransfer);
 
-            VkBufferImageCopy copyRegion = {};
-            copyRegion.bufferOffset = 0;
-            copyRegion.bufferRowLength = 0;
-            copyRegion.bufferImageHeight = 0;
-
-            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            copyRegion.imageSubresource.mipLevel = 0;
-            copyRegion.imageSubresource.baseArrayLayer = 0;
-            copyRegion.imageSubresource.layerCount = 1;
-            copyRegion.imageExtent = imageExtent;
+            // one region per mip level, all from the same staging buffer
+            VkBufferImageCopy copyRegions[Imaging::MAX_MIP_LEVELS] = {};
+            for (uint32_t level = 0; level < level_count; level++)
+            {
+                VkBufferImageCopy& copyRegion = copyRegions[level];
+                copyRegion.bufferOffset = levels[level].offset;
+                copyRegion.bufferRowLength = 0;
+                copyRegion.bufferImageHeight = 0;
+
+                copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                copyRegion.imageSubresource.mipLevel = level;
+                copyRegion.imageSubresource.baseArrayLayer = 0;
+                copyRegion.imageSubresource.layerCount = 1;
+                copyRegion.imageExtent = {levels[level].width, levels[level].height, 1};
+            }
 
             //copy the buffer into the image
-            vkCmdCopyBufferToImage(cmd, stagingBuffer.buffer, newImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+            vkCmdCopyBufferToImage(cmd, stagingBuffer.buffer, newImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, level_count, copyRegions);
         
             VkImageMemoryBarrier imageBarrier_toReadable = imageBarrier_toTransfer;
 
@@ -261,18 +449,111 @@ namespace Core
             vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier_toReadable);
         });
 
-        m_mainDeletionQueue.push([=]() {
-		    vmaDestroyImage(m_allocator, newImage.image, newImage.allocation);
-        });
-
-        vmaDestroyBuffer(m_allocator, stagingBuffer.buffer, stagingBuffer.allocation);
-
-        spdlog::info("Texture loaded successfully from file: {}", file);
         outImage = newImage;
 
         return true;
     }
 
+    ImageHandle EngineVulkanBase::load_image(const char* file)
+    {
+        AllocatedImage image;
+        if (!load_image_from_file(file, image)) return ImageHandle{};
+        return m_gpu.images.insert(image);
+    }
+
+    ImageHandle EngineVulkanBase::load_image_async(const std::string& file, IO::LoadTicket* out_ticket)
+    {
+        // the slot holds a copy of the placeholder until the upload replaces it
+        const AllocatedImage* placeholder = m_gpu.images.get(m_placeholders.image);
+        const ImageHandle handle = m_gpu.images.insert(placeholder ? *placeholder : AllocatedImage{});
+
+        IO::LoadTicket ticket = m_loader.load<DecodedImage>(
+            [file](DecodedImage& decoded) { return decode_image(file.c_str(), decoded); },
+            [this, handle, file](DecodedImage& decoded) {
+                // destroyed while loading
+                if (!m_gpu.images.contains(handle)) return false;
+
+                AllocatedImage image;
+                if (!upload_image(decoded.pixels, decoded.bytes, decoded.levels.data(), static_cast<uint32_t>(decoded.levels.size()), image)) return false;
+                *m_gpu.images.get(handle) = image;
+                spdlog::info("Texture loaded successfully from file: {}", file);
+                return true;
+            });
+
+        if (out_ticket) *out_ticket = ticket;
+        return handle;
+    }
+
+    IO::LoadTicket EngineVulkanBase::load_mesh_async(const entt::entity mesh_entity, const std::string& filename)
+    {
+        return m_loader.load<MeshSource>(
+            [this, filename](MeshSource& source) { return decode_mesh(filename.c_str(), source); },
+            [this, mesh_entity](MeshSource& source) {
+                entt::registry& assets = registry.get_assets();
+                Components::Mesh* mesh_comp = assets.valid(mesh_entity) ? assets.try_get<Components::Mesh>(mesh_entity) : nullptr;
+                // destroyed while loading
+                if (!mesh_comp) return false;
+
+                Vertex_RBG_Normal_Mesh mesh;
+                upload_mesh_source(source, &mesh);
+                if (!m_gpu.buffers.contains(mesh.vertex_buffer)) return false;
+
+                mesh_comp->mesh = std::move(mesh);
+                mesh_comp->b_placeholder = false;
+                // draw records hold the placeholder's buffers
+                registry.touch_assets();
+                return true;
+            });
+    }
+
+    void EngineVulkanBase::pump_loads(const size_t max_finishes)
+    {
+        if (!m_loader.has_decoded()) return;
+
+        begin_upload_batch();
+        const size_t finished = m_loader.pump(max_finishes);
+        end_upload_batch();
+        spdlog::debug("pump_loads[finished={},pending={}]", finished, m_loader.pending());
+    }
+
+    void EngineVulkanBase::init_placeholders()
+    {
+        // octahedron; like loaded meshes it is colored by its normals
+        const glm::vec3 axes[6] = {{1.f, 0.f, 0.f}, {-1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}};
+        Vertex_RBG_Normal_Mesh& mesh = m_placeholders.mesh;
+        for (const glm::vec3& axis : axes)
+        {
+            Vertex_RBG_Normal vertex;
+            vertex.position = axis * 0.5f;
+            vertex.normal = axis;
+            vertex.color = axis;
+            mesh.vertices.push_back(vertex);
+        }
+        for (uint32_t x = 0; x < 2; x++)
+        {
+            for (uint32_t y = 2; y < 4; y++)
+            {
+                for (uint32_t z = 4; z < 6; z++)
+                {
+                    // counter clockwise from outside: flip when an odd number of axes are negative
+                    const bool b_flip = ((x + y + z) % 2) == 1;
+                    mesh.indices.insert(mesh.indices.end(), {x, b_flip ? z : y, b_flip ? y : z});
+                }
+            }
+        }
+        upload_mesh(&mesh);
+        // copied into every placeholder Mesh component, so keep it to the buffers
+        mesh.vertices = {};
+        mesh.indices = {};
+
+        const uint32_t magenta = 0xFFFF00FF;
+        const uint32_t black = 0xFF000000;
+        const uint32_t checker[4] = {magenta, black, black, magenta};
+        AllocatedImage image;
+        const Imaging::MipLevel level{2, 2, 0, sizeof(checker)};
+        if (upload_image(checker, sizeof(checker), &level, 1, image)) m_placeholders.image = m_gpu.images.insert(image);
+    }
+
     void EngineVulkanBase::cleanup()
     {
         if (m_isInitialized) 
@@ -281,6 +562,14 @@ namespace Core
             vkDeviceWaitIdle(m_vk_init.device);
             vkWaitForFences(m_vk_init.device, 1, &get_current_frame().render_fence, true, 1000000000);
 
+            // decodes still running would finish into a destroyed device
+            m_loader.cancel();
+
+            // retires every remaining GPU asset through the listeners, then frees them all at once
+            registry.get_assets().clear<Components::Mesh, Components::Pipeline, Components::PipelineLayout>();
+            retire_gpu_resources();
+            m_frameDeletionQueue.flush();
+            save_pipeline_cache();
             m_mainDeletionQueue.flush();
             vmaDestroyAllocator(m_allocator);
             vkDestroyDevice(m_vk_init.device, nullptr);
@@ -436,6 +725,170 @@ namespace Core
         allocatorInfo.device = m_vk_init.device;
         allocatorInfo.instance = m_vk_init.instance;
         vmaCreateAllocator(&allocatorInfo, &m_allocator);
+
+        m_frameDeletionQueue.init(m_vk_init.device, m_allocator);
+        entt::registry& assets = registry.get_assets();
+        assets.on_destroy<Components::Mesh>().connect<&EngineVulkanBase::retire_mesh>(*this);
+        assets.on_destroy<Components::Pipeline>().connect<&EngineVulkanBase::retire_pipeline>(*this);
+        assets.on_destroy<Components::PipelineLayout>().connect<&EngineVulkanBase::retire_pipeline_layout>(*this);
+
+        init_pipeline_cache();
+    }
+
+    void EngineVulkanBase::init_pipeline_cache()
+    {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(m_vk_init.chosen_gpu, &properties);
+        m_pipeline_cache_key.vendor_id = properties.vendorID;
+        m_pipeline_cache_key.device_id = properties.deviceID;
+        m_pipeline_cache_key.driver_version = properties.driverVersion;
+        std::memcpy(m_pipeline_cache_key.cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+        // a cold start just begins with an empty cache
+        std::vector<uint8_t> data;
+        const bool b_warm = IO::read_pipeline_cache(m_pipeline_cache_path, m_pipeline_cache_key, data);
+
+        VkPipelineCacheCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        info.pNext = nullptr;
+        info.initialDataSize = data.size();
+        info.pInitialData = data.empty() ? nullptr : data.data();
+        VK_CHECK(vkCreatePipelineCache(m_vk_init.device, &info, nullptr, &m_pipeline_cache));
+
+        spdlog::info("Pipeline cache[path={},warm={},bytes={}]", m_pipeline_cache_path, b_warm, data.size());
+    }
+
+    void EngineVulkanBase::save_pipeline_cache()
+    {
+        if (m_pipeline_cache == VK_NULL_HANDLE) return;
+
+        size_t size = 0;
+        std::vector<uint8_t> data;
+        if (vkGetPipelineCacheData(m_vk_init.device, m_pipeline_cache, &size, nullptr) == VK_SUCCESS && size > 0)
+        {
+            data.resize(size);
+            if (vkGetPipelineCacheData(m_vk_init.device, m_pipeline_cache, &size, data.data()) != VK_SUCCESS) data.clear();
+            data.resize(std::min(size, data.size()));
+        }
+
+        if (data.empty() || !IO::write_pipeline_cache(m_pipeline_cache_path, m_pipeline_cache_key, data.data(), data.size()))
+        {
+            spdlog::warn("failed to save pipeline cache: {}", m_pipeline_cache_path);
+        }
+
+        vkDestroyPipelineCache(m_vk_init.device, m_pipeline_cache, nullptr);
+        m_pipeline_cache = VK_NULL_HANDLE;
+    }
+
+    void EngineVulkanBase::begin_pipeline_batch()
+    {
+        b_pipeline_batch_open = true;
+    }
+
+    void EngineVulkanBase::end_pipeline_batch()
+    {
+        b_pipeline_batch_open = false;
+        if (m_pending_pipelines.empty()) return;
+
+        // vkCreateGraphicsPipelines may run concurrently on one device and one pipeline cache
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<VkPipeline> built(m_pending_pipelines.size(), VK_NULL_HANDLE);
+        Threading::ThreadPool::shared().parallel_for(0, m_pending_pipelines.size(), 1, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                built[i] = m_pending_pipelines[i].builder.build_pipeline(m_vk_init.device, m_render_pass, m_pipeline_cache);
+            }
+        });
+        const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // the pool and the registry are only touched from this thread
+        entt::registry& assets = registry.get_assets();
+        for (size_t i = 0; i < m_pending_pipelines.size(); i++)
+        {
+            const entt::entity entity = m_pending_pipelines[i].entity;
+            if (Components::Pipeline* pipeline = assets.valid(entity) ? assets.try_get<Components::Pipeline>(entity) : nullptr)
+            {
+                pipeline->pipeline = m_gpu.pipelines.insert(built[i]);
+            }
+            else if (built[i] != VK_NULL_HANDLE)
+            {
+                vkDestroyPipeline(m_vk_init.device, built[i], nullptr);
+            }
+        }
+        spdlog::info("Built pipelines[count={},ms={:.1f}]", m_pending_pipelines.size(), build_ms);
+
+        m_pending_pipelines.clear();
+        // draw records resolved the pipelines while they were still unbuilt
+        registry.touch_assets();
+    }
+
+    // a frame still being recorded counts as in flight, so everything retires on the current frame
+    void EngineVulkanBase::retire_mesh(entt::registry& r, const entt::entity entity)
+    {
+        const Components::Mesh& mesh_comp = r.get<Components::Mesh>(entity);
+        // the placeholder's buffers are shared and live until shutdown
+        if (mesh_comp.b_placeholder) return;
+
+        const Vertex_RBG_Normal_Mesh& mesh = mesh_comp.mesh;
+        for (const BufferHandle handle : {mesh.vertex_buffer, mesh.index_buffer})
+        {
+            if (const AllocatedBuffer* buffer = m_gpu.buffers.get(handle))
+            {
+                m_frameDeletionQueue.retire_buffer(*buffer, m_frameNumber);
+                m_gpu.buffers.erase(handle);
+            }
+        }
+    }
+
+    void EngineVulkanBase::retire_pipeline(entt::registry& r, const entt::entity entity)
+    {
+        const PipelineHandle handle = r.get<Components::Pipeline>(entity).pipeline;
+        if (const VkPipeline* pipeline = m_gpu.pipelines.get(handle))
+        {
+            m_frameDeletionQueue.retire_pipeline(*pipeline, m_frameNumber);
+            m_gpu.pipelines.erase(handle);
+        }
+    }
+
+    void EngineVulkanBase::retire_pipeline_layout(entt::registry& r, const entt::entity entity)
+    {
+        const PipelineLayoutHandle handle = r.get<Components::PipelineLayout>(entity).pipeline_layout;
+        if (const VkPipelineLayout* layout = m_gpu.pipeline_layouts.get(handle))
+        {
+            m_frameDeletionQueue.retire_pipeline_layout(*layout, m_frameNumber);
+            m_gpu.pipeline_layouts.erase(handle);
+        }
+    }
+
+    void EngineVulkanBase::retire_gpu_resources()
+    {
+        for (const AllocatedBuffer& buffer : m_gpu.buffers) m_frameDeletionQueue.retire_buffer(buffer, m_frameNumber);
+        // images still loading hold copies of the placeholder, which is retired once
+        const AllocatedImage* placeholder = m_gpu.images.get(m_placeholders.image);
+        const VkImage placeholder_image = placeholder ? placeholder->image : VK_NULL_HANDLE;
+        for (const AllocatedImage& image : m_gpu.images)
+        {
+            if (image.image != placeholder_image) m_frameDeletionQueue.retire_image(image, m_frameNumber);
+        }
+        if (placeholder) m_frameDeletionQueue.retire_image(*placeholder, m_frameNumber);
+        for (const VkPipeline pipeline : m_gpu.pipelines) m_frameDeletionQueue.retire_pipeline(pipeline, m_frameNumber);
+        for (const VkPipelineLayout layout : m_gpu.pipeline_layouts) m_frameDeletionQueue.retire_pipeline_layout(layout, m_frameNumber);
+        m_gpu.buffers.clear();
+        m_gpu.images.clear();
+        m_gpu.pipelines.clear();
+        m_gpu.pipeline_layouts.clear();
+    }
+
+    void EngineVulkanBase::destroy_image(const ImageHandle handle)
+    {
+        if (const AllocatedImage* image = m_gpu.images.get(handle))
+        {
+            // an image still loading only holds a copy of the placeholder
+            const AllocatedImage* placeholder = m_gpu.images.get(m_placeholders.image);
+            const bool b_placeholder_copy = handle != m_placeholders.image && placeholder && image->image == placeholder->image;
+            if (!b_placeholder_copy) m_frameDeletionQueue.retire_image(*image, m_frameNumber);
+            m_gpu.images.erase(handle);
+        }
     }
 
     void EngineVulkanBase::init_default_renderpass()
@@ -622,72 +1075,108 @@ namespace Core
     {
         if (Vertex_RBG_Normal_Mesh* mesh = static_cast<Vertex_RBG_Normal_Mesh*>(mesh_ptr))
         {
-            const size_t bufferSize= mesh->vertices.size() * sizeof(Vertex_RBG_Normal);
-            //allocate staging buffer
-            VkBufferCreateInfo stagingBufferInfo = {};
-            stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            stagingBufferInfo.pNext = nullptr;
-
-            stagingBufferInfo.size = bufferSize;
-            stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-            //let the VMA library know that this data should be on CPU RAM
-            VmaAllocationCreateInfo vmaallocInfo = {};
-            vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-            AllocatedBuffer stagingBuffer;
-
-            //allocate the buffer
-            VK_CHECK(vmaCreateBuffer(m_allocator, &stagingBufferInfo, &vmaallocInfo,
-                &stagingBuffer.buffer,
-                &stagingBuffer.allocation,
-                nullptr));
-
-            void* data;
-            vmaMapMemory(m_allocator, stagingBuffer.allocation, &data);
-
-            memcpy(data, mesh->vertices.data(), mesh->vertices.size() * sizeof(Vertex_RBG_Normal));
-
-            vmaUnmapMemory(m_allocator, stagingBuffer.allocation);
-
-            //allocate vertex buffer
-            VkBufferCreateInfo vertexBufferInfo = {};
-            vertexBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            vertexBufferInfo.pNext = nullptr;
-            //this is the total size, in bytes, of the buffer we are allocating
-            vertexBufferInfo.size = bufferSize;
-            //this buffer is going to be used as a Vertex Buffer
-            vertexBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-
-            //let the VMA library know that this data should be GPU native
-            vmaallocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-
-            //allocate the buffer
-            VK_CHECK(vmaCreateBuffer(m_allocator, &vertexBufferInfo, &vmaallocInfo,
-                &mesh->vertex_buffer.buffer,
-                &mesh->vertex_buffer.allocation,
-                nullptr));
-
-            immediate_submit([=](VkCommandBuffer cmd) {
-                VkBufferCopy copy;
-                copy.dstOffset = 0;
-                copy.srcOffset = 0;
-                copy.size = bufferSize;
-                vkCmdCopyBuffer(cmd, stagingBuffer.buffer, mesh->vertex_buffer.buffer, 1, &copy);
-            });
+            // already uploaded, e.g. straight from the mesh cache
+            if (m_gpu.buffers.contains(mesh->vertex_buffer)) return;
+
+            mesh->compute_bounds();
+            mesh->vertex_count = static_cast<uint32_t>(mesh->vertices.size());
+            mesh->vertex_buffer = upload_buffer(mesh->vertices.data(), mesh->vertices.size() * sizeof(Vertex_RBG_Normal), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+
+            std::vector<uint16_t> packed;
+            size_t index_bytes;
+            const void* indices = pack_indices(*mesh, packed, mesh->index_type, index_bytes);
+            mesh->index_count = static_cast<uint32_t>(mesh->indices.size());
+            mesh->index_buffer = upload_buffer(indices, index_bytes, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        }
+        else
+        {
+            spdlog::error("failed to load mesh");
+        }
+        
+    }
 
-            m_mainDeletionQueue.push([=]() {
-                vmaDestroyBuffer(m_allocator, mesh->vertex_buffer.buffer, mesh->vertex_buffer.allocation);
-            });
+    BufferHandle EngineVulkanBase::upload_buffer(const void* source, const size_t bufferSize, const VkBufferUsageFlags usage)
+    {
+        if (bufferSize == 0) return BufferHandle{};
+
+        //allocate staging buffer
+        VkBufferCreateInfo stagingBufferInfo = {};
+        stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        stagingBufferInfo.pNext = nullptr;
+
+        stagingBufferInfo.size = bufferSize;
+        stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 
-            vmaDestroyBuffer(m_allocator, stagingBuffer.buffer, stagingBuffer.allocation);
+        //let the VMA library know that this data should be on CPU RAM
+        VmaAllocationCreateInfo vmaallocInfo = {};
+        vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+        AllocatedBuffer stagingBuffer;
 
+        //allocate the buffer
+        VK_CHECK(vmaCreateBuffer(m_allocator, &stagingBufferInfo, &vmaallocInfo,
+            &stagingBuffer.buffer,
+            &stagingBuffer.allocation,
+            nullptr));
+
+        void* data;
+        vmaMapMemory(m_allocator, stagingBuffer.allocation, &data);
+
+        memcpy(data, source, bufferSize);
+
+        vmaUnmapMemory(m_allocator, stagingBuffer.allocation);
+
+        //allocate the device buffer
+        VkBufferCreateInfo deviceBufferInfo = {};
+        deviceBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        deviceBufferInfo.pNext = nullptr;
+        //this is the total size, in bytes, of the buffer we are allocating
+        deviceBufferInfo.size = bufferSize;
+        //e.g. a vertex or index buffer, filled by a transfer
+        deviceBufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+        //let the VMA library know that this data should be GPU native
+        vmaallocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        AllocatedBuffer deviceBuffer;
+
+        //allocate the buffer
+        VK_CHECK(vmaCreateBuffer(m_allocator, &deviceBufferInfo, &vmaallocInfo,
+            &deviceBuffer.buffer,
+            &deviceBuffer.allocation,
+            nullptr));
+
+        // freed once the copy has completed, which may be at the end of an upload batch
+        m_upload_staging.push_back(stagingBuffer);
+        immediate_submit([=](VkCommandBuffer cmd) {
+            VkBufferCopy copy;
+            copy.dstOffset = 0;
+            copy.srcOffset = 0;
+            copy.size = bufferSize;
+            vkCmdCopyBuffer(cmd, stagingBuffer.buffer, deviceBuffer.buffer, 1, &copy);
+        });
+
+        return m_gpu.buffers.insert(deviceBuffer);
+    }
+
+    void EngineVulkanBase::draw_mesh(VkCommandBuffer cmd, const Vertex_RBG_Normal_Mesh& mesh, const uint32_t first_instance) const
+    {
+        const VkBuffer vertex_buffer = resolve(mesh.vertex_buffer);
+        if (vertex_buffer == VK_NULL_HANDLE) return;
+
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(cmd, 0, 1, &vertex_buffer, &offset);
+
+        const VkBuffer index_buffer = resolve(mesh.index_buffer);
+        if (index_buffer != VK_NULL_HANDLE && mesh.index_count > 0)
+        {
+            vkCmdBindIndexBuffer(cmd, index_buffer, 0, mesh.index_type);
+            vkCmdDrawIndexed(cmd, mesh.index_count, 1, 0, 0, first_instance);
         }
         else
         {
-            spdlog::error("failed to load mesh");
+            vkCmdDraw(cmd, mesh.vertex_count, 1, 0, first_instance);
         }
-        
     }
 
     void EngineVulkanBase::init_descriptors()
@@ -695,7 +1184,8 @@ namespace Core
         //create a descriptor pool that will hold 10 uniform buffers
         std::vector<VkDescriptorPoolSize> sizes =
         {
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10 }
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 10 }
         };
 
         VkDescriptorPoolCreateInfo pool_info = {};
@@ -717,16 +1207,25 @@ namespace Core
         // we use it from the vertex shader
         camBufferBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
+        // per object matrices, indexed by gl_InstanceIndex
+        VkDescriptorSetLayoutBinding instanceBufferBinding = {};
+        instanceBufferBinding.binding = 1;
+        instanceBufferBinding.descriptorCount = 1;
+        instanceBufferBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        instanceBufferBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+        VkDescriptorSetLayoutBinding bindings[] = { camBufferBinding, instanceBufferBinding };
+
         VkDescriptorSetLayoutCreateInfo setinfo = {};
         setinfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         setinfo.pNext = nullptr;
 
-        //we are going to have 1 binding
-        setinfo.bindingCount = 1;
+        //we are going to have 2 bindings
+        setinfo.bindingCount = 2;
         //no flags
         setinfo.flags = 0;
-        //point to the camera buffer binding
-        setinfo.pBindings = &camBufferBinding; 
+        //point to the camera and instance buffer bindings
+        setinfo.pBindings = bindings; 
 
         vkCreateDescriptorSetLayout(m_vk_init.device, &setinfo, nullptr, &m_global_set_layout);
 
@@ -739,6 +1238,14 @@ namespace Core
         for (int i = 0; i < FRAME_OVERLAP; i++)
         {
             m_frames[i].view_buffer = create_buffer(sizeof(GPUCameraData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+            m_frames[i].instance_buffer = create_buffer(sizeof(glm::mat4) * MAX_INSTANCES, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+            // draws that do not use the instance buffer read slot 0
+            void* instance_data;
+            vmaMapMemory(m_allocator, m_frames[i].instance_buffer.allocation, &instance_data);
+            const glm::mat4 identity(1.f);
+            memcpy(instance_data, &identity, sizeof(glm::mat4));
+            vmaUnmapMemory(m_allocator, m_frames[i].instance_buffer.allocation);
             
             VkDescriptorSetAllocateInfo allocInfo ={};
             allocInfo.pNext = nullptr;
@@ -774,10 +1281,22 @@ namespace Core
             setWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
             setWrite.pBufferInfo = &binfo;
 
-            vkUpdateDescriptorSets(m_vk_init.device, 1, &setWrite, 0, nullptr);
+            VkDescriptorBufferInfo instance_info;
+            instance_info.buffer = m_frames[i].instance_buffer.buffer;
+            instance_info.offset = 0;
+            instance_info.range = sizeof(glm::mat4) * MAX_INSTANCES;
+
+            VkWriteDescriptorSet instanceWrite = setWrite;
+            instanceWrite.dstBinding = 1;
+            instanceWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            instanceWrite.pBufferInfo = &instance_info;
+
+            VkWriteDescriptorSet writes[] = { setWrite, instanceWrite };
+            vkUpdateDescriptorSets(m_vk_init.device, 2, writes, 0, nullptr);
 
             m_mainDeletionQueue.push([=]() {
                 vmaDestroyBuffer(m_allocator, m_frames[i].view_buffer.buffer, m_frames[i].view_buffer.allocation);
+                vmaDestroyBuffer(m_allocator, m_frames[i].instance_buffer.buffer, m_frames[i].instance_buffer.allocation);
             });
         }
     }
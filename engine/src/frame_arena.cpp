@@ -0,0 +1,69 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+
+namespace SketchBook
+{
+namespace Memory
+{
+    FrameArena::FrameArena(const size_t initial_capacity)
+    {
+        add_block(initial_capacity);
+    }
+
+    void FrameArena::add_block(const size_t min_bytes)
+    {
+        const size_t last_size = m_blocks.empty() ? 0 : m_blocks.back().size;
+        const size_t size = std::max(min_bytes, last_size * 2);
+
+        if (!m_blocks.empty()) m_used_before += m_offset;
+        m_blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+        m_offset = 0;
+        m_capacity += size;
+    }
+
+    void* FrameArena::allocate(const size_t bytes, const size_t alignment)
+    {
+        auto aligned_offset = [&]() {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(m_blocks.back().data.get());
+            const uintptr_t aligned = (base + m_offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            return static_cast<size_t>(aligned - base);
+        };
+
+        size_t offset = aligned_offset();
+        if (offset + bytes > m_blocks.back().size)
+        {
+            add_block(bytes + alignment);
+            offset = aligned_offset();
+        }
+
+        m_offset = offset + bytes;
+        m_high_water = std::max(m_high_water, used());
+        return m_blocks.back().data.get() + offset;
+    }
+
+    void FrameArena::deallocate(void* ptr, const size_t bytes)
+    {
+        std::byte* const top = m_blocks.back().data.get() + m_offset;
+        if (static_cast<std::byte*>(ptr) + bytes == top)
+        {
+            m_offset -= bytes;
+        }
+    }
+
+    void FrameArena::reset()
+    {
+        if (m_blocks.size() > 1)
+        {
+            // one block big enough for the whole frame next time
+            const size_t size = m_capacity;
+            m_blocks.clear();
+            m_capacity = 0;
+            m_used_before = 0;
+            add_block(size);
+        }
+        m_offset = 0;
+        m_used_before = 0;
+    }
+}
+}
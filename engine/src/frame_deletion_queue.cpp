@@ -0,0 +1,54 @@
+#include "frame_deletion_queue.h"
+
+namespace SketchBook
+{
+namespace Core
+{
+    void FrameDeletionQueue::init(VkDevice device, VmaAllocator allocator)
+    {
+        m_device = device;
+        m_allocator = allocator;
+    }
+
+    size_t FrameDeletionQueue::release(const uint64_t completed_frame)
+    {
+        size_t released = 0;
+        released += m_buffers.release(completed_frame, [this](const AllocatedBuffer& buffer) {
+            vmaDestroyBuffer(m_allocator, buffer.buffer, buffer.allocation);
+        });
+        released += m_image_views.release(completed_frame, [this](const VkImageView view) {
+            vkDestroyImageView(m_device, view, nullptr);
+        });
+        released += m_images.release(completed_frame, [this](const AllocatedImage& image) {
+            vmaDestroyImage(m_allocator, image.image, image.allocation);
+        });
+        released += m_samplers.release(completed_frame, [this](const VkSampler sampler) {
+            vkDestroySampler(m_device, sampler, nullptr);
+        });
+        released += m_framebuffers.release(completed_frame, [this](const VkFramebuffer framebuffer) {
+            vkDestroyFramebuffer(m_device, framebuffer, nullptr);
+        });
+        released += m_pipelines.release(completed_frame, [this](const VkPipeline pipeline) {
+            vkDestroyPipeline(m_device, pipeline, nullptr);
+        });
+        released += m_pipeline_layouts.release(completed_frame, [this](const VkPipelineLayout layout) {
+            vkDestroyPipelineLayout(m_device, layout, nullptr);
+        });
+        released += m_descriptor_pools.release(completed_frame, [this](const VkDescriptorPool pool) {
+            vkDestroyDescriptorPool(m_device, pool, nullptr);
+        });
+        return released;
+    }
+
+    size_t FrameDeletionQueue::flush()
+    {
+        return release(UINT64_MAX);
+    }
+
+    size_t FrameDeletionQueue::size() const
+    {
+        return m_buffers.size() + m_image_views.size() + m_images.size() + m_samplers.size()
+            + m_framebuffers.size() + m_pipelines.size() + m_pipeline_layouts.size() + m_descriptor_pools.size();
+    }
+}
+}
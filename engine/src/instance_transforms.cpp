@@ -0,0 +1,185 @@
+#include "instance_transforms.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace SketchBook
+{
+    static inline uint32_t lowest_bit(const uint64_t bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+    }
+
+    void DirtyRanges::resize(const size_t slot_count)
+    {
+        const size_t old_count = m_slot_count;
+        m_slot_count = slot_count;
+        m_words.resize((slot_count + 63) / 64, 0);
+        m_summary.resize((m_words.size() + 63) / 64, 0);
+
+        if (slot_count >= old_count)
+        {
+            for (size_t slot = old_count; slot < slot_count; slot++)
+            {
+                mark(slot);
+            }
+            return;
+        }
+
+        // shrinking: drop bits past the end and rebuild the summary
+        if (slot_count % 64 != 0)
+        {
+            m_words.back() &= (uint64_t{1} << (slot_count % 64)) - 1;
+        }
+        std::fill(m_summary.begin(), m_summary.end(), 0);
+        m_dirty_words = 0;
+        for (size_t w = 0; w < m_words.size(); w++)
+        {
+            if (m_words[w] == 0) continue;
+            m_summary[w / 64] |= uint64_t{1} << (w % 64);
+            ++m_dirty_words;
+        }
+    }
+
+    void DirtyRanges::mark(const size_t slot)
+    {
+        uint64_t& word = m_words[slot / 64];
+        if (word == 0)
+        {
+            ++m_dirty_words;
+            m_summary[slot / 4096] |= uint64_t{1} << ((slot / 64) % 64);
+        }
+        word |= uint64_t{1} << (slot % 64);
+    }
+
+    void DirtyRanges::mark_all()
+    {
+        const size_t count = m_slot_count;
+        std::fill(m_words.begin(), m_words.end(), 0);
+        std::fill(m_summary.begin(), m_summary.end(), 0);
+        m_dirty_words = 0;
+        for (size_t slot = 0; slot < count; slot += 64)
+        {
+            const size_t bits = std::min<size_t>(64, count - slot);
+            m_words[slot / 64] = (bits == 64) ? ~uint64_t{0} : ((uint64_t{1} << bits) - 1);
+            m_summary[slot / 4096] |= uint64_t{1} << ((slot / 64) % 64);
+            ++m_dirty_words;
+        }
+    }
+
+    void DirtyRanges::take_ranges(std::vector<SlotRange>& out_ranges, const size_t max_gap)
+    {
+        if (m_dirty_words == 0) return;
+
+        bool b_open = false;
+        SlotRange current{0, 0};
+
+        for (size_t s = 0; s < m_summary.size(); s++)
+        {
+            uint64_t summary = m_summary[s];
+            m_summary[s] = 0;
+            while (summary)
+            {
+                const size_t w = s * 64 + lowest_bit(summary);
+                summary &= summary - 1;
+
+                uint64_t bits = m_words[w];
+                m_words[w] = 0;
+                while (bits)
+                {
+                    // take a whole run of set bits at once
+                    const uint32_t start = lowest_bit(bits);
+                    const uint64_t shifted = ~(bits >> start);
+                    const uint32_t length = (shifted == 0) ? 64 - start : lowest_bit(shifted);
+                    bits &= (length + start >= 64) ? ((uint64_t{1} << start) - 1) : ~(((uint64_t{1} << length) - 1) << start);
+
+                    const uint32_t first = static_cast<uint32_t>(w * 64) + start;
+                    const uint32_t last = first + length;
+                    if (b_open && first <= current.last + max_gap)
+                    {
+                        current.last = last;
+                    }
+                    else
+                    {
+                        if (b_open) out_ranges.push_back(current);
+                        current = SlotRange{first, last};
+                        b_open = true;
+                    }
+                }
+            }
+        }
+        if (b_open) out_ranges.push_back(current);
+        m_dirty_words = 0;
+    }
+
+    void InstanceTransforms::resize(const size_t object_count)
+    {
+        const size_t old_size = m_matrices.size();
+        m_matrices.resize(object_count + 1, glm::mat4(1.f));
+        if (old_size == 0) m_matrices[0] = glm::mat4(1.f);
+        for (DirtyRanges& frame : m_frames)
+        {
+            frame.resize(m_matrices.size());
+        }
+    }
+
+    void InstanceTransforms::set(const uint32_t slot, const glm::mat4& matrix)
+    {
+        m_matrices[slot] = matrix;
+        for (DirtyRanges& frame : m_frames)
+        {
+            frame.mark(slot);
+        }
+    }
+
+    void InstanceTransforms::mark_all_dirty()
+    {
+        for (DirtyRanges& frame : m_frames)
+        {
+            frame.mark_all();
+        }
+    }
+
+    bool InstanceTransforms::is_clean(const size_t frame_index, const size_t frame_count) const
+    {
+        return m_frames.size() == frame_count && !m_frames[frame_index].any();
+    }
+
+    size_t InstanceTransforms::upload(const size_t frame_index, const size_t frame_count, void* dst, const size_t capacity)
+    {
+        if (m_frames.size() != frame_count)
+        {
+            m_frames.assign(frame_count, DirtyRanges{});
+            for (DirtyRanges& frame : m_frames)
+            {
+                frame.resize(m_matrices.size());
+            }
+        }
+
+        m_ranges.clear();
+        m_frames[frame_index].take_ranges(m_ranges);
+
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        size_t written = 0;
+        for (SlotRange& range : m_ranges)
+        {
+            range.last = static_cast<uint32_t>(std::min<size_t>(range.last, capacity));
+            if (range.first >= range.last) continue;
+
+            const size_t bytes = (range.last - range.first) * sizeof(glm::mat4);
+            std::memcpy(out + range.first * sizeof(glm::mat4), &m_matrices[range.first], bytes);
+            written += bytes;
+        }
+        return written;
+    }
+}
@@ -0,0 +1,97 @@
+#include "mesh_cache.h"
+
+#include <cstring>
+#include <vector>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        static constexpr char SKMESH_MAGIC[4] = {'S', 'K', 'M', 'H'};
+
+        static inline uint64_t align_up(const uint64_t offset)
+        {
+            return (offset + SKMESH_ALIGNMENT - 1) & ~(SKMESH_ALIGNMENT - 1);
+        }
+
+        uint64_t hash_bytes(const void* data, const size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::string cache_path(const std::string& source_path, const char* extension)
+        {
+            const size_t slash = source_path.find_last_of("/\\");
+            const size_t dot = source_path.find_last_of('.');
+            const bool b_has_extension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+            return (b_has_extension ? source_path.substr(0, dot) : source_path) + extension;
+        }
+
+        std::string mesh_cache_path(const std::string& source_path)
+        {
+            return cache_path(source_path, ".skmesh");
+        }
+
+        bool write_mesh_cache(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const MeshBlobs& blobs)
+        {
+            SkMeshHeader header = {};
+            std::memcpy(header.magic, SKMESH_MAGIC, sizeof(header.magic));
+            header.version = SKMESH_VERSION;
+            header.source_hash = source_hash;
+            header.source_size = source_size;
+            header.vertex_stride = blobs.vertex_stride;
+            header.vertex_count = blobs.vertex_count;
+            header.index_count = blobs.index_count;
+            header.index_size = blobs.index_size;
+            std::memcpy(header.bounds_min, blobs.bounds_min, sizeof(header.bounds_min));
+            std::memcpy(header.bounds_max, blobs.bounds_max, sizeof(header.bounds_max));
+
+            const uint64_t vertex_bytes = uint64_t{blobs.vertex_count} * blobs.vertex_stride;
+            const uint64_t index_bytes = uint64_t{blobs.index_count} * blobs.index_size;
+            header.vertex_offset = align_up(sizeof(SkMeshHeader));
+            header.index_offset = align_up(header.vertex_offset + vertex_bytes);
+
+            std::vector<uint8_t> file(header.index_offset + index_bytes, 0);
+            std::memcpy(file.data(), &header, sizeof(header));
+            if (vertex_bytes) std::memcpy(file.data() + header.vertex_offset, blobs.vertices, vertex_bytes);
+            if (index_bytes) std::memcpy(file.data() + header.index_offset, blobs.indices, index_bytes);
+
+            return write_file(path, file.data(), file.size());
+        }
+
+        bool MeshCacheFile::open(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const uint32_t vertex_stride)
+        {
+            m_header = nullptr;
+            if (!m_file.open(path)) return false;
+
+            const SkMeshHeader* header = reinterpret_cast<const SkMeshHeader*>(m_file.data());
+            const uint64_t size = m_file.size();
+            const bool b_valid = size >= sizeof(SkMeshHeader)
+                && std::memcmp(header->magic, SKMESH_MAGIC, sizeof(SKMESH_MAGIC)) == 0
+                && header->version == SKMESH_VERSION
+                && header->source_hash == source_hash
+                && header->source_size == source_size
+                && header->vertex_stride == vertex_stride
+                && header->vertex_offset % SKMESH_ALIGNMENT == 0
+                && header->index_offset % SKMESH_ALIGNMENT == 0
+                && IO::range_fits(header->vertex_offset, header->vertex_count, vertex_stride, size)
+                && (header->index_size == 2 || header->index_size == 4)
+                && IO::range_fits(header->index_offset, header->index_count, header->index_size, size);
+
+            if (!b_valid)
+            {
+                m_file.close();
+                return false;
+            }
+            m_header = header;
+            return true;
+        }
+    }
+}
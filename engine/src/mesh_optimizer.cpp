@@ -0,0 +1,308 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace SketchBook
+{
+namespace MeshOptimizer
+{
+    namespace
+    {
+        // Forsyth's published constants
+        constexpr uint32_t CACHE_SIZE = 32;
+        constexpr float CACHE_DECAY_POWER = 1.5f;
+        constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+        constexpr uint32_t VALENCE_TABLE_SIZE = 64;
+
+        // pow is too slow for the inner loop; scores only depend on small integers
+        struct ScoreTables
+        {
+            float cache[CACHE_SIZE];
+            float valence[VALENCE_TABLE_SIZE];
+
+            ScoreTables()
+            {
+                for (uint32_t i = 0; i < CACHE_SIZE; i++)
+                {
+                    // the last triangle's vertices get a fixed score so strips are not favoured
+                    const float scaler = 1.f / (CACHE_SIZE - 3);
+                    cache[i] = (i < 3) ? LAST_TRIANGLE_SCORE : std::pow(1.f - (i - 3) * scaler, CACHE_DECAY_POWER);
+                }
+                valence[0] = 0.f;
+                for (uint32_t i = 1; i < VALENCE_TABLE_SIZE; i++)
+                {
+                    valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+                }
+            }
+        };
+
+        float vertex_score(const ScoreTables& tables, const int cache_position, const uint32_t remaining)
+        {
+            // no triangles left to emit, so the vertex is of no use to anyone
+            if (remaining == 0) return -1.f;
+
+            const float cache_score = (cache_position >= 0) ? tables.cache[cache_position] : 0.f;
+            // vertices with few triangles left are finished off first
+            const float valence_score = (remaining < VALENCE_TABLE_SIZE)
+                ? tables.valence[remaining]
+                : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+            return cache_score + valence_score;
+        }
+
+        struct Vec3
+        {
+            float x, y, z;
+
+            Vec3 operator-(const Vec3& o) const { return {x - o.x, y - o.y, z - o.z}; }
+            Vec3 operator+(const Vec3& o) const { return {x + o.x, y + o.y, z + o.z}; }
+            Vec3 operator*(const float s) const { return {x * s, y * s, z * s}; }
+            float dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+            Vec3 cross(const Vec3& o) const { return {y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x}; }
+        };
+    }
+
+    VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t>& indices, const size_t vertex_count, const uint32_t cache_size)
+    {
+        // no whole triangle or no vertices: zeroed stats rather than divisions by zero
+        VertexCacheStats stats;
+        if (indices.size() < 3 || vertex_count == 0) return stats;
+
+        // FIFO by timestamp: a vertex is cached while fewer than cache_size misses happened since its own
+        std::vector<uint32_t> timestamps(vertex_count, 0);
+        std::vector<uint8_t> referenced(vertex_count, 0);
+        uint32_t time = cache_size + 1;
+        uint32_t unique = 0;
+
+        for (const uint32_t index : indices)
+        {
+            if (time - timestamps[index] > cache_size)
+            {
+                timestamps[index] = time++;
+                ++stats.transformed;
+            }
+            if (!referenced[index])
+            {
+                referenced[index] = 1;
+                ++unique;
+            }
+        }
+
+        stats.acmr = static_cast<float>(stats.transformed) / static_cast<float>(indices.size() / 3);
+        stats.atvr = static_cast<float>(stats.transformed) / static_cast<float>(unique);
+        return stats;
+    }
+
+    void optimize_vertex_cache(std::vector<uint32_t>& indices, const size_t vertex_count)
+    {
+        const size_t triangle_count = indices.size() / 3;
+        if (triangle_count < 2) return;
+
+        // triangles of each vertex; the live ones are adjacency[offsets[v], offsets[v] + remaining[v])
+        std::vector<uint32_t> remaining(vertex_count, 0);
+        for (const uint32_t index : indices) ++remaining[index];
+
+        std::vector<uint32_t> offsets(vertex_count + 1, 0);
+        std::partial_sum(remaining.begin(), remaining.end(), offsets.begin() + 1);
+
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        static const ScoreTables tables;
+        std::vector<int> cache_position(vertex_count, -1);
+        std::vector<float> scores(vertex_count);
+        for (size_t v = 0; v < vertex_count; v++) scores[v] = vertex_score(tables, -1, remaining[v]);
+
+        std::vector<float> triangle_scores(triangle_count);
+        std::vector<uint8_t> emitted(triangle_count, 0);
+        uint32_t best = 0;
+        for (size_t t = 0; t < triangle_count; t++)
+        {
+            triangle_scores[t] = scores[indices[3 * t]] + scores[indices[3 * t + 1]] + scores[indices[3 * t + 2]];
+            if (triangle_scores[t] > triangle_scores[best]) best = static_cast<uint32_t>(t);
+        }
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> next_cache;
+        cache.reserve(CACHE_SIZE + 3);
+        next_cache.reserve(CACHE_SIZE + 3);
+        size_t scan_cursor = 0;
+
+        for (size_t emitted_count = 0; emitted_count < triangle_count; emitted_count++)
+        {
+            if (best == UINT32_MAX)
+            {
+                // nothing in the cache has triangles left: continue with the next one in input order
+                while (emitted[scan_cursor]) ++scan_cursor;
+                best = static_cast<uint32_t>(scan_cursor);
+            }
+
+            const uint32_t* corners = &indices[3 * best];
+            emitted[best] = 1;
+            output.insert(output.end(), corners, corners + 3);
+
+            next_cache.clear();
+            for (int c = 0; c < 3; c++)
+            {
+                const uint32_t v = corners[c];
+                uint32_t* live = &adjacency[offsets[v]];
+                uint32_t* last = live + remaining[v] - 1;
+                *std::find(live, last + 1, best) = *last;
+                --remaining[v];
+
+                if (std::find(next_cache.begin(), next_cache.end(), v) == next_cache.end()) next_cache.push_back(v);
+            }
+            const size_t corner_count = next_cache.size();
+            for (const uint32_t v : cache)
+            {
+                if (std::find(next_cache.begin(), next_cache.begin() + corner_count, v) == next_cache.begin() + corner_count) next_cache.push_back(v);
+            }
+
+            // entries pushed past the end leave the cache and lose their cache score
+            for (size_t i = 0; i < next_cache.size(); i++)
+            {
+                const uint32_t v = next_cache[i];
+                cache_position[v] = (i < CACHE_SIZE) ? static_cast<int>(i) : -1;
+                scores[v] = vertex_score(tables, cache_position[v], remaining[v]);
+            }
+
+            best = UINT32_MAX;
+            float best_score = -1.f;
+            for (const uint32_t v : next_cache)
+            {
+                for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; a++)
+                {
+                    const uint32_t t = adjacency[a];
+                    const float score = scores[indices[3 * t]] + scores[indices[3 * t + 1]] + scores[indices[3 * t + 2]];
+                    triangle_scores[t] = score;
+                    if (score > best_score)
+                    {
+                        best_score = score;
+                        best = t;
+                    }
+                }
+            }
+
+            if (next_cache.size() > CACHE_SIZE) next_cache.resize(CACHE_SIZE);
+            cache.swap(next_cache);
+        }
+
+        indices.swap(output);
+    }
+
+    void optimize_overdraw(std::vector<uint32_t>& indices, const float* positions, const size_t stride, const size_t vertex_count, const float threshold)
+    {
+        const size_t triangle_count = indices.size() / 3;
+        if (triangle_count < 2) return;
+
+        auto position = [&](const uint32_t v) {
+            const float* p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + v * stride);
+            return Vec3{p[0], p[1], p[2]};
+        };
+
+        // a cluster starts wherever a triangle misses on all three vertices: the cache restarts
+        // there anyway, so reordering whole clusters barely changes ACMR
+        constexpr uint32_t cache_size = 16;
+        std::vector<uint32_t> clusters;
+        {
+            std::vector<uint32_t> timestamps(vertex_count, 0);
+            uint32_t time = cache_size + 1;
+            for (size_t t = 0; t < triangle_count; t++)
+            {
+                int misses = 0;
+                for (int c = 0; c < 3; c++)
+                {
+                    const uint32_t v = indices[3 * t + c];
+                    if (time - timestamps[v] > cache_size)
+                    {
+                        timestamps[v] = time++;
+                        ++misses;
+                    }
+                }
+                if (t == 0 || misses == 3) clusters.push_back(static_cast<uint32_t>(t));
+            }
+        }
+        if (clusters.size() < 2) return;
+        clusters.push_back(static_cast<uint32_t>(triangle_count));
+
+        // area weighted centroid and normal per cluster
+        const size_t cluster_count = clusters.size() - 1;
+        std::vector<Vec3> centroids(cluster_count, Vec3{0.f, 0.f, 0.f});
+        std::vector<Vec3> normals(cluster_count, Vec3{0.f, 0.f, 0.f});
+        std::vector<float> areas(cluster_count, 0.f);
+        Vec3 mesh_centroid{0.f, 0.f, 0.f};
+        float mesh_area = 0.f;
+
+        for (size_t c = 0; c < cluster_count; c++)
+        {
+            for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+            {
+                const Vec3 a = position(indices[3 * t]);
+                const Vec3 b = position(indices[3 * t + 1]);
+                const Vec3 d = position(indices[3 * t + 2]);
+                const Vec3 normal = (b - a).cross(d - a);
+                const float area = std::sqrt(normal.dot(normal));
+                const Vec3 center = (a + b + d) * (1.f / 3.f);
+
+                centroids[c] = centroids[c] + center * area;
+                normals[c] = normals[c] + normal;
+                areas[c] += area;
+            }
+            mesh_centroid = mesh_centroid + centroids[c];
+            mesh_area += areas[c];
+        }
+        if (mesh_area <= 0.f) return;
+        mesh_centroid = mesh_centroid * (1.f / mesh_area);
+
+        std::vector<float> sort_keys(cluster_count, 0.f);
+        for (size_t c = 0; c < cluster_count; c++)
+        {
+            const float length = std::sqrt(normals[c].dot(normals[c]));
+            if (areas[c] <= 0.f || length <= 0.f) continue;
+            const Vec3 centroid = centroids[c] * (1.f / areas[c]);
+            sort_keys[c] = (centroid - mesh_centroid).dot(normals[c] * (1.f / length));
+        }
+
+        std::vector<uint32_t> order(cluster_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+            return sort_keys[a] > sort_keys[b];
+        });
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        for (const uint32_t c : order)
+        {
+            output.insert(output.end(), indices.begin() + 3 * clusters[c], indices.begin() + 3 * clusters[c + 1]);
+        }
+
+        const float acmr_before = analyze_vertex_cache(indices, vertex_count, cache_size).acmr;
+        const float acmr_after = analyze_vertex_cache(output, vertex_count, cache_size).acmr;
+        if (acmr_after <= acmr_before * threshold) indices.swap(output);
+    }
+
+    size_t build_fetch_remap(std::vector<uint32_t>& indices, const size_t vertex_count, std::vector<uint32_t>& remap)
+    {
+        remap.assign(vertex_count, UINT32_MAX);
+        uint32_t next = 0;
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == UINT32_MAX) remap[index] = next++;
+            index = remap[index];
+        }
+        return next;
+    }
+}
+}
@@ -0,0 +1,140 @@
+#include "mipmaps.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace SketchBook
+{
+    namespace Imaging
+    {
+        // output texels per parallel_for chunk, below which a level is not worth splitting
+        static constexpr size_t TEXELS_PER_CHUNK = 16384;
+
+        static constexpr int LINEAR_BUCKETS = 4096;
+
+        struct SrgbTables
+        {
+            std::array<float, 256> to_linear;
+            std::array<float, 256> thresholds;  // linear midpoints between neighbouring sRGB values, then +inf
+            std::array<uint8_t, LINEAR_BUCKETS + 1> bucket_start;   // sRGB value at the bottom of each linear bucket
+
+            SrgbTables()
+            {
+                for (int i = 0; i < 256; i++)
+                {
+                    const float c = i / 255.f;
+                    to_linear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                for (int i = 0; i < 255; i++)
+                {
+                    thresholds[i] = 0.5f * (to_linear[i] + to_linear[i + 1]);
+                }
+                thresholds[255] = INFINITY;
+                for (int bucket = 0; bucket <= LINEAR_BUCKETS; bucket++)
+                {
+                    const float linear = static_cast<float>(bucket) / LINEAR_BUCKETS;
+                    bucket_start[bucket] = static_cast<uint8_t>(std::upper_bound(thresholds.begin(), thresholds.end(), linear) - thresholds.begin());
+                }
+            }
+
+            // nearest sRGB value in linear light; exact for values that came from to_linear.
+            // The bucket gets within a step or two, the thresholds settle it.
+            inline uint8_t to_srgb(const float linear) const
+            {
+                uint32_t value = bucket_start[static_cast<uint32_t>(linear * LINEAR_BUCKETS)];
+                while (thresholds[value] <= linear) ++value;
+                return static_cast<uint8_t>(value);
+            }
+        };
+
+        static const SrgbTables& srgb_tables()
+        {
+            static const SrgbTables tables;
+            return tables;
+        }
+
+        uint32_t mip_level_count(const uint32_t width, const uint32_t height)
+        {
+            uint32_t size = std::max(width, height);
+            uint32_t count = 1;
+            while (size > 1 && count < MAX_MIP_LEVELS)
+            {
+                size >>= 1;
+                ++count;
+            }
+            return count;
+        }
+
+        void downsample(const uint8_t* src, const uint32_t src_width, const uint32_t src_height,
+            uint8_t* dst, const uint32_t dst_width, const bool b_srgb, const uint32_t first_row, const uint32_t last_row)
+        {
+            const SrgbTables& tables = srgb_tables();
+            const size_t src_pitch = size_t{src_width} * 4;
+
+            for (uint32_t y = first_row; y < last_row; y++)
+            {
+                const uint8_t* row0 = src + std::min(2 * y, src_height - 1) * src_pitch;
+                const uint8_t* row1 = src + std::min(2 * y + 1, src_height - 1) * src_pitch;
+                uint8_t* out = dst + size_t{y} * dst_width * 4;
+
+                for (uint32_t x = 0; x < dst_width; x++)
+                {
+                    const size_t x0 = size_t{std::min(2 * x, src_width - 1)} * 4;
+                    const size_t x1 = size_t{std::min(2 * x + 1, src_width - 1)} * 4;
+
+                    // alpha, and every channel of linear data, averages as stored
+                    const int first_plain = b_srgb ? 3 : 0;
+                    for (int c = 0; c < first_plain; c++)
+                    {
+                        const float sum = tables.to_linear[row0[x0 + c]] + tables.to_linear[row0[x1 + c]]
+                            + tables.to_linear[row1[x0 + c]] + tables.to_linear[row1[x1 + c]];
+                        out[c] = tables.to_srgb(sum * 0.25f);
+                    }
+                    for (int c = first_plain; c < 4; c++)
+                    {
+                        const uint32_t sum = uint32_t{row0[x0 + c]} + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                        out[c] = static_cast<uint8_t>((sum + 2) >> 2);
+                    }
+                    out += 4;
+                }
+            }
+        }
+
+        void build_mip_chain(const uint8_t* rgba, const uint32_t width, const uint32_t height, const bool b_srgb,
+            std::vector<uint8_t>& out_pixels, std::vector<MipLevel>& out_levels, Threading::ThreadPool& pool)
+        {
+            out_levels.clear();
+            const uint32_t level_count = mip_level_count(width, height);
+
+            uint64_t total = 0;
+            uint32_t level_width = width;
+            uint32_t level_height = height;
+            for (uint32_t level = 0; level < level_count; level++)
+            {
+                const uint64_t bytes = uint64_t{level_width} * level_height * 4;
+                out_levels.push_back(MipLevel{level_width, level_height, total, bytes});
+                total += bytes;
+                level_width = std::max(level_width / 2, 1u);
+                level_height = std::max(level_height / 2, 1u);
+            }
+
+            out_pixels.resize(total);
+            std::memcpy(out_pixels.data(), rgba, out_levels[0].bytes);
+
+            for (uint32_t level = 1; level < level_count; level++)
+            {
+                const MipLevel& above = out_levels[level - 1];
+                const MipLevel& current = out_levels[level];
+                const uint8_t* src = out_pixels.data() + above.offset;
+                uint8_t* dst = out_pixels.data() + current.offset;
+
+                const size_t grain = std::max<size_t>(1, TEXELS_PER_CHUNK / current.width);
+                pool.parallel_for(0, current.height, grain, [&](const size_t first, const size_t last) {
+                    downsample(src, above.width, above.height, dst, current.width, b_srgb, static_cast<uint32_t>(first), static_cast<uint32_t>(last));
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,269 @@
+#include "obj_parser.h"
+#include "sk_io.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        namespace
+        {
+            // below this a chunk costs more to schedule than to parse
+            constexpr size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+            struct ObjChunk
+            {
+                std::vector<float> positions;
+                std::vector<float> texcoords;
+                std::vector<float> normals;
+                std::vector<ObjIndex> indices;
+                std::vector<uint32_t> relative;     // index * 3 + component, resolved against this chunk's counts
+                size_t bad_lines{0};
+            };
+
+            inline bool is_space(const char c) { return c == ' ' || c == '\t'; }
+
+            inline const char* skip_space(const char* p, const char* end)
+            {
+                while (p < end && is_space(*p)) ++p;
+                return p;
+            }
+
+            inline const char* parse_float(const char* p, const char* end, float& out, bool& b_ok)
+            {
+                p = skip_space(p, end);
+                if (p < end && *p == '+') ++p;
+                const std::from_chars_result result = std::from_chars(p, end, out);
+                b_ok = b_ok && result.ec == std::errc();
+                return result.ptr;
+            }
+
+            // 0 when there is no number
+            inline const char* parse_int(const char* p, const char* end, int32_t& out)
+            {
+                out = 0;
+                bool b_negative = false;
+                if (p < end && (*p == '-' || *p == '+'))
+                {
+                    b_negative = *p == '-';
+                    ++p;
+                }
+                int32_t value = 0;
+                while (p < end && *p >= '0' && *p <= '9')
+                {
+                    value = value * 10 + (*p - '0');
+                    ++p;
+                }
+                out = b_negative ? -value : value;
+                return p;
+            }
+
+            // OBJ indices are 1-based, negative ones count back from the latest attribute
+            inline int32_t resolve(const int32_t value, const size_t local_count, ObjChunk& chunk, const size_t component)
+            {
+                if (value > 0) return value - 1;
+                if (value == 0) return -1;
+                chunk.relative.push_back(static_cast<uint32_t>(chunk.indices.size() * 3 + component));
+                return static_cast<int32_t>(local_count) + value;
+            }
+
+            void parse_face(const char* p, const char* end, ObjChunk& chunk, std::vector<ObjIndex>& polygon)
+            {
+                polygon.clear();
+                while (true)
+                {
+                    p = skip_space(p, end);
+                    if (p >= end) break;
+
+                    int32_t values[3] = {0, 0, 0};
+                    p = parse_int(p, end, values[0]);
+                    for (int component = 1; component < 3 && p < end && *p == '/'; component++)
+                    {
+                        p = parse_int(p + 1, end, values[component]);
+                    }
+                    while (p < end && !is_space(*p)) ++p;
+
+                    // resolved when the corner is emitted, so relative fixups point at the right slot
+                    polygon.push_back(ObjIndex{values[0], values[1], values[2]});
+                }
+
+                if (polygon.size() < 3)
+                {
+                    ++chunk.bad_lines;
+                    return;
+                }
+
+                auto emit = [&](const ObjIndex& corner) {
+                    ObjIndex index;
+                    index.position = resolve(corner.position, chunk.positions.size() / 3, chunk, 0);
+                    index.texcoord = resolve(corner.texcoord, chunk.texcoords.size() / 2, chunk, 1);
+                    index.normal = resolve(corner.normal, chunk.normals.size() / 3, chunk, 2);
+                    chunk.indices.push_back(index);
+                };
+                for (size_t i = 1; i + 1 < polygon.size(); i++)
+                {
+                    emit(polygon[0]);
+                    emit(polygon[i]);
+                    emit(polygon[i + 1]);
+                }
+            }
+
+            void parse_chunk(const char* p, const char* end, ObjChunk& chunk)
+            {
+                std::vector<ObjIndex> polygon;
+                while (p < end)
+                {
+                    const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                    if (!line_end) line_end = end;
+                    const char* stop = (line_end > p && line_end[-1] == '\r') ? line_end - 1 : line_end;
+
+                    p = skip_space(p, stop);
+                    if (stop - p >= 2 && p[0] == 'v')
+                    {
+                        bool b_ok = true;
+                        float x, y, z;
+                        if (is_space(p[1]))
+                        {
+                            const char* q = parse_float(p + 1, stop, x, b_ok);
+                            q = parse_float(q, stop, y, b_ok);
+                            parse_float(q, stop, z, b_ok);
+                            if (b_ok) chunk.positions.insert(chunk.positions.end(), {x, y, z});
+                        }
+                        else if (p[1] == 'n' && stop - p >= 3 && is_space(p[2]))
+                        {
+                            const char* q = parse_float(p + 2, stop, x, b_ok);
+                            q = parse_float(q, stop, y, b_ok);
+                            parse_float(q, stop, z, b_ok);
+                            if (b_ok) chunk.normals.insert(chunk.normals.end(), {x, y, z});
+                        }
+                        else if (p[1] == 't' && stop - p >= 3 && is_space(p[2]))
+                        {
+                            const char* q = parse_float(p + 2, stop, x, b_ok);
+                            parse_float(q, stop, y, b_ok);
+                            if (b_ok) chunk.texcoords.insert(chunk.texcoords.end(), {x, y});
+                        }
+                        if (!b_ok) ++chunk.bad_lines;
+                    }
+                    else if (stop - p >= 2 && p[0] == 'f' && is_space(p[1]))
+                    {
+                        parse_face(p + 1, stop, chunk, polygon);
+                    }
+
+                    p = line_end + 1;
+                }
+            }
+
+            template<typename T>
+            void copy_into(std::vector<T>& dst, const size_t offset, const std::vector<T>& src)
+            {
+                if (!src.empty()) std::memcpy(dst.data() + offset, src.data(), src.size() * sizeof(T));
+            }
+        }
+
+        bool parse_obj(const char* text, const size_t size, ObjData& out, Threading::ThreadPool& pool)
+        {
+            out = ObjData{};
+            if (size == 0) return true;
+
+            // chunk boundaries just after a newline
+            const size_t chunk_count = std::max<size_t>(1, std::min(pool.thread_count() + 1, size / MIN_CHUNK_BYTES));
+            std::vector<size_t> starts(chunk_count + 1, size);
+            starts[0] = 0;
+            for (size_t c = 1; c < chunk_count; c++)
+            {
+                size_t split = std::max(starts[c - 1], size * c / chunk_count);
+                const void* newline = (split < size) ? std::memchr(text + split, '\n', size - split) : nullptr;
+                starts[c] = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text) + 1 : size;
+            }
+
+            std::vector<ObjChunk> chunks(chunk_count);
+            pool.parallel_for(0, chunk_count, 1, [&](const size_t first, const size_t last) {
+                for (size_t c = first; c < last; c++)
+                {
+                    parse_chunk(text + starts[c], text + starts[c + 1], chunks[c]);
+                }
+            });
+
+            // exclusive prefix sums: where each chunk lands in the output
+            struct Offsets { size_t positions, texcoords, normals, indices; };
+            std::vector<Offsets> offsets(chunk_count + 1, Offsets{0, 0, 0, 0});
+            size_t bad_lines = 0;
+            for (size_t c = 0; c < chunk_count; c++)
+            {
+                offsets[c + 1].positions = offsets[c].positions + chunks[c].positions.size();
+                offsets[c + 1].texcoords = offsets[c].texcoords + chunks[c].texcoords.size();
+                offsets[c + 1].normals = offsets[c].normals + chunks[c].normals.size();
+                offsets[c + 1].indices = offsets[c].indices + chunks[c].indices.size();
+                bad_lines += chunks[c].bad_lines;
+            }
+            if (bad_lines > 0) spdlog::warn("obj: skipped {} malformed lines", bad_lines);
+
+            out.positions.resize(offsets[chunk_count].positions);
+            out.texcoords.resize(offsets[chunk_count].texcoords);
+            out.normals.resize(offsets[chunk_count].normals);
+            out.indices.resize(offsets[chunk_count].indices);
+
+            const int32_t position_count = static_cast<int32_t>(out.positions.size() / 3);
+            const int32_t texcoord_count = static_cast<int32_t>(out.texcoords.size() / 2);
+            const int32_t normal_count = static_cast<int32_t>(out.normals.size() / 3);
+            std::atomic<size_t> bad_indices{0};
+
+            pool.parallel_for(0, chunk_count, 1, [&](const size_t first, const size_t last) {
+                for (size_t c = first; c < last; c++)
+                {
+                    ObjChunk& chunk = chunks[c];
+                    const Offsets& at = offsets[c];
+
+                    // relative indices were resolved against this chunk's own counts
+                    const int32_t bases[3] = {
+                        static_cast<int32_t>(at.positions / 3),
+                        static_cast<int32_t>(at.texcoords / 2),
+                        static_cast<int32_t>(at.normals / 3)};
+                    for (const uint32_t fixup : chunk.relative)
+                    {
+                        int32_t* corner = &chunk.indices[fixup / 3].position;
+                        corner[fixup % 3] += bases[fixup % 3];
+                    }
+
+                    size_t bad = 0;
+                    for (ObjIndex& index : chunk.indices)
+                    {
+                        if (index.position < 0 || index.position >= position_count) ++bad;
+                        if (index.texcoord >= texcoord_count || index.texcoord < -1) index.texcoord = -1;
+                        if (index.normal >= normal_count || index.normal < -1) index.normal = -1;
+                    }
+                    bad_indices += bad;
+
+                    copy_into(out.positions, at.positions, chunk.positions);
+                    copy_into(out.texcoords, at.texcoords, chunk.texcoords);
+                    copy_into(out.normals, at.normals, chunk.normals);
+                    copy_into(out.indices, at.indices, chunk.indices);
+                }
+            });
+
+            if (bad_indices > 0)
+            {
+                spdlog::error("obj: {} face corners reference missing positions", bad_indices.load());
+                return false;
+            }
+            return true;
+        }
+
+        bool load_obj(const std::string& path, ObjData& out, Threading::ThreadPool& pool)
+        {
+            MappedFile file(path);
+            if (!file.is_valid())
+            {
+                spdlog::error("obj: failed to open {}", path);
+                return false;
+            }
+            return parse_obj(reinterpret_cast<const char*>(file.data()), file.size(), out, pool);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include "pipeline_cache.h"
+#include "mesh_cache.h"
+
+#include <cstring>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        static constexpr char SKPC_MAGIC[4] = {'S', 'K', 'P', 'C'};
+
+        static bool same_key(const PipelineCacheKey& a, const PipelineCacheKey& b)
+        {
+            return a.vendor_id == b.vendor_id
+                && a.device_id == b.device_id
+                && a.driver_version == b.driver_version
+                && std::memcmp(a.cache_uuid, b.cache_uuid, sizeof(a.cache_uuid)) == 0;
+        }
+
+        bool write_pipeline_cache(const std::string& path, const PipelineCacheKey& key, const void* data, const size_t size)
+        {
+            SkPipelineCacheHeader header = {};
+            std::memcpy(header.magic, SKPC_MAGIC, sizeof(header.magic));
+            header.version = SKPC_VERSION;
+            header.key = key;
+            header.data_size = size;
+            header.data_hash = hash_bytes(data, size);
+
+            std::vector<uint8_t> file(sizeof(header) + size);
+            std::memcpy(file.data(), &header, sizeof(header));
+            if (size) std::memcpy(file.data() + sizeof(header), data, size);
+
+            return write_file(path, file.data(), file.size());
+        }
+
+        bool read_pipeline_cache(const std::string& path, const PipelineCacheKey& key, std::vector<uint8_t>& out_data)
+        {
+            out_data.clear();
+            MappedFile file(path);
+            if (!file.is_valid() || file.size() < sizeof(SkPipelineCacheHeader)) return false;
+
+            const SkPipelineCacheHeader* header = reinterpret_cast<const SkPipelineCacheHeader*>(file.data());
+            const uint8_t* data = file.data() + sizeof(SkPipelineCacheHeader);
+            const bool b_valid = std::memcmp(header->magic, SKPC_MAGIC, sizeof(SKPC_MAGIC)) == 0
+                && header->version == SKPC_VERSION
+                && same_key(header->key, key)
+                && header->data_size == file.size() - sizeof(SkPipelineCacheHeader)
+                && header->data_hash == hash_bytes(data, header->data_size);
+            if (!b_valid) return false;
+
+            out_data.assign(data, data + header->data_size);
+            return true;
+        }
+    }
+}
@@ -1,3 +1,160 @@
 #include "sk_io.h"
 
 #define TINYOBJLOADER_IMPLEMENTATION
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+        {
+            if (this == &other) return *this;
+            close();
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+#ifdef _WIN32
+            std::swap(m_file, other.m_file);
+            std::swap(m_mapping, other.m_mapping);
+#else
+            std::swap(m_fd, other.m_fd);
+#endif
+            return *this;
+        }
+
+        bool MappedFile::open(const std::string& path)
+        {
+            close();
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return false;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr)
+            {
+                CloseHandle(file);
+                return false;
+            }
+
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view == nullptr)
+            {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                return false;
+            }
+
+            m_file = file;
+            m_mapping = mapping;
+            m_data = static_cast<const uint8_t*>(view);
+            m_size = static_cast<size_t>(size.QuadPart);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+
+            struct stat info;
+            if (fstat(fd, &info) != 0 || info.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            m_fd = fd;
+            m_data = static_cast<const uint8_t*>(view);
+            m_size = static_cast<size_t>(info.st_size);
+#endif
+            return true;
+        }
+
+        void MappedFile::close()
+        {
+#ifdef _WIN32
+            if (m_data) UnmapViewOfFile(m_data);
+            if (m_mapping) CloseHandle(m_mapping);
+            if (m_file) CloseHandle(m_file);
+            m_file = nullptr;
+            m_mapping = nullptr;
+#else
+            if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+            if (m_fd >= 0) ::close(m_fd);
+            m_fd = -1;
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        void MappedFile::prefault() const
+        {
+            volatile uint8_t sink = 0;
+            for (size_t offset = 0; offset < m_size; offset += 4096)
+            {
+                sink += m_data[offset];
+            }
+            (void)sink;
+        }
+
+        bool write_file(const std::string& path, const void* data, const size_t size)
+        {
+            // unique per process and call, so concurrent writers of one target never share a temp file
+            static std::atomic<uint64_t> s_write_counter{0};
+#ifdef _WIN32
+            const unsigned long pid = GetCurrentProcessId();
+#else
+            const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+            const std::string tmp_path = path + "." + std::to_string(pid) + "." + std::to_string(s_write_counter.fetch_add(1)) + ".tmp";
+
+            FILE* file = std::fopen(tmp_path.c_str(), "wb");
+            if (!file) return false;
+
+            const bool b_written = std::fwrite(data, 1, size, file) == size;
+            if (std::fclose(file) != 0 || !b_written)
+            {
+                std::remove(tmp_path.c_str());
+                return false;
+            }
+
+            // both replace an existing target in one step, so it is never missing
+#ifdef _WIN32
+            const bool b_replaced = MoveFileExA(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+            const bool b_replaced = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+#endif
+            if (!b_replaced)
+            {
+                std::remove(tmp_path.c_str());
+            }
+            return b_replaced;
+        }
+    }
+}
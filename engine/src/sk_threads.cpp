@@ -0,0 +1,82 @@
+#include "sk_threads.h"
+
+namespace SketchBook
+{
+namespace Threading
+{
+    static thread_local const ThreadPool* t_worker_pool = nullptr;
+    static thread_local size_t t_worker_index = 0;
+
+    ThreadPool::ThreadPool(size_t thread_count)
+    {
+        m_workers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            m_workers.emplace_back(&ThreadPool::worker_loop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            b_stopping = true;
+        }
+        m_cv.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t ThreadPool::default_thread_count()
+    {
+        // leave one hardware thread for the render loop
+        const size_t hardware_threads = std::thread::hardware_concurrency();
+        return (hardware_threads > 1) ? hardware_threads - 1 : 1;
+    }
+
+    void ThreadPool::enqueue(std::function<void()>&& task)
+    {
+        {
+            std::scoped_lock guard(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_cv.notify_one();
+    }
+
+    size_t ThreadPool::worker_slot() const
+    {
+        return (t_worker_pool == this) ? t_worker_index + 1 : 0;
+    }
+
+    void ThreadPool::worker_loop(const size_t index)
+    {
+        t_worker_pool = this;
+        t_worker_index = index;
+
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this]() { return b_stopping || !m_tasks.empty(); });
+
+                // drain remaining work before exiting so no future is left dangling
+                if (m_tasks.empty()) return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
+}
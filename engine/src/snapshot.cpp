@@ -0,0 +1,51 @@
+#include "snapshot.h"
+
+namespace SketchBook
+{
+    bool is_little_endian_host()
+    {
+        const uint32_t probe = 1;
+        uint8_t first_byte;
+        std::memcpy(&first_byte, &probe, 1);
+        return first_byte == 1;
+    }
+
+    void SnapshotWriter::field(const std::string& value)
+    {
+        field(static_cast<uint64_t>(value.size()));
+        write(value.data(), value.size());
+    }
+
+    void SnapshotWriter::write(const void* data, const size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    void SnapshotReader::field(std::string& value)
+    {
+        uint64_t size{0};
+        field(size);
+        if (size > remaining())
+        {
+            b_failed = true;
+            value.clear();
+            return;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data), size);
+        m_data += size;
+    }
+
+    void SnapshotReader::read(void* data, const size_t size)
+    {
+        if (size > remaining())
+        {
+            b_failed = true;
+            m_data = m_end;
+            std::memset(data, 0, size);
+            return;
+        }
+        std::memcpy(data, m_data, size);
+        m_data += size;
+    }
+}
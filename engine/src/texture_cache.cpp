@@ -0,0 +1,78 @@
+#include "texture_cache.h"
+
+#include <cstring>
+
+namespace SketchBook
+{
+    namespace IO
+    {
+        static constexpr char SKTEX_MAGIC[4] = {'S', 'K', 'T', 'X'};
+
+        static inline uint64_t align_up(const uint64_t offset)
+        {
+            return (offset + SKTEX_ALIGNMENT - 1) & ~(SKTEX_ALIGNMENT - 1);
+        }
+
+        std::string texture_cache_path(const std::string& source_path)
+        {
+            return cache_path(source_path, ".sktex");
+        }
+
+        bool write_texture_cache(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const bool b_srgb,
+            const void* pixels, const size_t pixel_bytes, const std::vector<Imaging::MipLevel>& levels)
+        {
+            if (levels.empty() || levels.size() > Imaging::MAX_MIP_LEVELS) return false;
+
+            SkTexHeader header = {};
+            std::memcpy(header.magic, SKTEX_MAGIC, sizeof(header.magic));
+            header.version = SKTEX_VERSION;
+            header.source_hash = source_hash;
+            header.source_size = source_size;
+            header.b_srgb = b_srgb ? 1 : 0;
+            header.level_count = static_cast<uint32_t>(levels.size());
+            header.pixel_offset = align_up(sizeof(SkTexHeader));
+            header.pixel_bytes = pixel_bytes;
+            std::memcpy(header.levels, levels.data(), levels.size() * sizeof(Imaging::MipLevel));
+
+            std::vector<uint8_t> file(header.pixel_offset + pixel_bytes, 0);
+            std::memcpy(file.data(), &header, sizeof(header));
+            if (pixel_bytes) std::memcpy(file.data() + header.pixel_offset, pixels, pixel_bytes);
+
+            return write_file(path, file.data(), file.size());
+        }
+
+        bool TextureCacheFile::open(const std::string& path, const uint64_t source_hash, const uint64_t source_size, const bool b_srgb)
+        {
+            m_header = nullptr;
+            if (!m_file.open(path)) return false;
+
+            const SkTexHeader* header = reinterpret_cast<const SkTexHeader*>(m_file.data());
+            const uint64_t size = m_file.size();
+            bool b_valid = size >= sizeof(SkTexHeader)
+                && std::memcmp(header->magic, SKTEX_MAGIC, sizeof(SKTEX_MAGIC)) == 0
+                && header->version == SKTEX_VERSION
+                && header->source_hash == source_hash
+                && header->source_size == source_size
+                && header->b_srgb == (b_srgb ? 1u : 0u)
+                && header->level_count >= 1 && header->level_count <= Imaging::MAX_MIP_LEVELS
+                && header->pixel_offset % SKTEX_ALIGNMENT == 0
+                && range_fits(header->pixel_offset, header->pixel_bytes, 1, size);
+
+            for (uint32_t level = 0; b_valid && level < header->level_count; level++)
+            {
+                const Imaging::MipLevel& mip = header->levels[level];
+                b_valid = mip.bytes == uint64_t{mip.width} * mip.height * 4
+                    && mip.offset % 4 == 0
+                    && range_fits(mip.offset, mip.bytes, 1, header->pixel_bytes);
+            }
+
+            if (!b_valid)
+            {
+                m_file.close();
+                return false;
+            }
+            m_header = header;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,340 @@
+#include "world/avoidance.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Avoidance
+{
+    namespace
+    {
+        constexpr float LP_EPSILON = 1e-5f;
+
+        inline float det(const glm::vec2& a, const glm::vec2& b)
+        {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        inline float length_sq(const glm::vec2& v)
+        {
+            return glm::dot(v, v);
+        }
+
+        // optimum on line `line_no`, subject to lines [0, line_no) and the max-speed circle
+        bool linear_program_1(
+            const OrcaLine* lines, const size_t line_no, const float radius,
+            const glm::vec2& opt_velocity, const bool direction_opt, glm::vec2& result)
+        {
+            const OrcaLine& line = lines[line_no];
+            const float dot_product = glm::dot(line.point, line.direction);
+            const float discriminant = dot_product * dot_product + radius * radius - length_sq(line.point);
+
+            // the max-speed circle fully invalidates this line
+            if (discriminant < 0.f) return false;
+
+            const float sqrt_discriminant = std::sqrt(discriminant);
+            float t_left = -dot_product - sqrt_discriminant;
+            float t_right = -dot_product + sqrt_discriminant;
+
+            for (size_t i = 0; i < line_no; i++)
+            {
+                const float denominator = det(line.direction, lines[i].direction);
+                const float numerator = det(lines[i].direction, line.point - lines[i].point);
+
+                if (std::fabs(denominator) <= LP_EPSILON)
+                {
+                    // parallel lines
+                    if (numerator < 0.f) return false;
+                    continue;
+                }
+
+                const float t = numerator / denominator;
+                if (denominator >= 0.f)
+                {
+                    t_right = std::min(t_right, t);
+                }
+                else
+                {
+                    t_left = std::max(t_left, t);
+                }
+
+                if (t_left > t_right) return false;
+            }
+
+            if (direction_opt)
+            {
+                result = line.point + line.direction * ((glm::dot(opt_velocity, line.direction) > 0.f) ? t_right : t_left);
+            }
+            else
+            {
+                const float t = std::clamp(glm::dot(line.direction, opt_velocity - line.point), t_left, t_right);
+                result = line.point + line.direction * t;
+            }
+            return true;
+        }
+
+        // returns line_count on success, otherwise the index of the first line that failed
+        size_t linear_program_2(
+            const OrcaLine* lines, const size_t line_count, const float radius,
+            const glm::vec2& opt_velocity, const bool direction_opt, glm::vec2& result)
+        {
+            if (direction_opt)
+            {
+                // opt_velocity is a unit direction here
+                result = opt_velocity * radius;
+            }
+            else if (length_sq(opt_velocity) > radius * radius)
+            {
+                result = glm::normalize(opt_velocity) * radius;
+            }
+            else
+            {
+                result = opt_velocity;
+            }
+
+            for (size_t i = 0; i < line_count; i++)
+            {
+                if (det(lines[i].direction, lines[i].point - result) > 0.f)
+                {
+                    const glm::vec2 previous = result;
+                    if (!linear_program_1(lines, i, radius, opt_velocity, direction_opt, result))
+                    {
+                        result = previous;
+                        return i;
+                    }
+                }
+            }
+            return line_count;
+        }
+
+        // infeasible case: minimize the maximum penetration into the violated half-planes
+        void linear_program_3(
+            const OrcaLine* lines, const size_t line_count, const size_t begin_line,
+            const float radius, glm::vec2& result)
+        {
+            std::array<OrcaLine, MAX_NEIGHBORS> projected;
+            float distance = 0.f;
+
+            for (size_t i = begin_line; i < line_count; i++)
+            {
+                if (det(lines[i].direction, lines[i].point - result) <= distance) continue;
+
+                size_t projected_count = 0;
+                for (size_t j = 0; j < i; j++)
+                {
+                    OrcaLine line;
+                    const float determinant = det(lines[i].direction, lines[j].direction);
+
+                    if (std::fabs(determinant) <= LP_EPSILON)
+                    {
+                        // same direction: j is already covered by i
+                        if (glm::dot(lines[i].direction, lines[j].direction) > 0.f) continue;
+                        line.point = 0.5f * (lines[i].point + lines[j].point);
+                    }
+                    else
+                    {
+                        line.point = lines[i].point + lines[i].direction * (det(lines[j].direction, lines[i].point - lines[j].point) / determinant);
+                    }
+
+                    line.direction = glm::normalize(lines[j].direction - lines[i].direction);
+                    projected[projected_count++] = line;
+                }
+
+                const glm::vec2 previous = result;
+                const glm::vec2 opt_direction(-lines[i].direction.y, lines[i].direction.x);
+                if (linear_program_2(projected.data(), projected_count, radius, opt_direction, true, result) < projected_count)
+                {
+                    // only fails from float rounding; keep the previous result
+                    result = previous;
+                }
+
+                distance = det(lines[i].direction, lines[i].point - result);
+            }
+        }
+    }
+
+    CrowdAvoidance::CrowdAvoidance(const AvoidanceParams& params, Threading::ThreadPool& pool)
+        : m_params{params}, m_pool{pool}
+    {
+    }
+
+    void CrowdAvoidance::update(const std::vector<KinematicObject*>& agents, const Event_NextTick& event)
+    {
+        // steering stays serial: wandering handles draw from the shared random engine
+        for (KinematicObject* agent : agents)
+        {
+            agent->steer(event);
+        }
+
+        solve(agents, event.seconds_per_tick);
+
+        m_pool.parallel_for(0, agents.size(), 1024, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                agents[i]->integrate(event);
+            }
+        });
+    }
+
+    void CrowdAvoidance::gather(const std::vector<KinematicObject*>& agents)
+    {
+        const size_t count = agents.size();
+        m_positions.resize(count);
+        m_velocities.resize(count);
+        m_preferred_velocities.resize(count);
+        m_radii.resize(count);
+        m_max_speeds.resize(count);
+        m_new_velocities.resize(count);
+        m_max_radius = 0.f;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const KinematicObject& agent = *agents[i];
+            m_positions[i] = agent.get_position();
+            m_velocities[i] = agent.effective_velocity();
+            m_preferred_velocities[i] = agent.velocity_meter_per_second();
+            m_radii[i] = agent.get_radius();
+            m_max_speeds[i] = agent.get_max_speed();
+            m_max_radius = std::max(m_max_radius, m_radii[i]);
+        }
+    }
+
+    void CrowdAvoidance::solve(const std::vector<KinematicObject*>& agents, const float seconds_per_tick)
+    {
+        if (agents.empty() || seconds_per_tick <= 0.f) return;
+
+        gather(agents);
+
+        m_grid.set_cell_size(m_params.neighbor_distance);
+        m_grid.build(m_positions);
+
+        m_pool.parallel_for(0, agents.size(), 256, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                m_new_velocities[i] = solve_agent(i, seconds_per_tick);
+            }
+        });
+
+        for (size_t i = 0; i < agents.size(); i++)
+        {
+            agents[i]->set_avoidance_velocity(m_new_velocities[i]);
+        }
+    }
+
+    glm::vec2 CrowdAvoidance::solve_agent(const size_t agent, const float seconds_per_tick) const
+    {
+        const int max_neighbors = std::clamp(m_params.max_neighbors, 0, MAX_NEIGHBORS);
+        const glm::vec2 position = m_positions[agent];
+        const glm::vec2 velocity = m_velocities[agent];
+        const float radius = m_radii[agent];
+        const float max_speed = m_max_speeds[agent];
+
+        // k nearest neighbors by insertion into a small sorted array
+        std::array<uint32_t, MAX_NEIGHBORS> neighbors;
+        std::array<float, MAX_NEIGHBORS> neighbor_dist_sq;
+        int neighbor_count = 0;
+
+        if (max_neighbors > 0)
+        {
+            const float query_radius = m_params.neighbor_distance + radius + m_max_radius;
+            m_grid.for_each_in_radius(position, query_radius, [&](const uint32_t other, const glm::vec2& other_position) {
+                if (other == agent) return;
+
+                const float dist_sq = length_sq(other_position - position);
+                const float reach = m_params.neighbor_distance + radius + m_radii[other];
+                if (dist_sq > reach * reach) return;
+
+                if (neighbor_count == max_neighbors && dist_sq >= neighbor_dist_sq[neighbor_count - 1]) return;
+
+                int slot = (neighbor_count < max_neighbors) ? neighbor_count++ : neighbor_count - 1;
+                while (slot > 0 && neighbor_dist_sq[slot - 1] > dist_sq)
+                {
+                    neighbors[slot] = neighbors[slot - 1];
+                    neighbor_dist_sq[slot] = neighbor_dist_sq[slot - 1];
+                    slot--;
+                }
+                neighbors[slot] = other;
+                neighbor_dist_sq[slot] = dist_sq;
+            });
+        }
+
+        std::array<OrcaLine, MAX_NEIGHBORS> lines;
+        const float inv_time_horizon = 1.f / std::max(m_params.time_horizon, 1e-3f);
+        const float inv_time_step = 1.f / seconds_per_tick;
+
+        for (int n = 0; n < neighbor_count; n++)
+        {
+            const uint32_t other = neighbors[n];
+            const glm::vec2 relative_position = m_positions[other] - position;
+            const glm::vec2 relative_velocity = velocity - m_velocities[other];
+            const float dist_sq = length_sq(relative_position);
+            const float combined_radius = radius + m_radii[other];
+            const float combined_radius_sq = combined_radius * combined_radius;
+
+            OrcaLine& line = lines[n];
+            glm::vec2 u;
+
+            if (dist_sq > combined_radius_sq)
+            {
+                // no collision yet; w is the vector from the truncated cone's cutoff center to the relative velocity
+                const glm::vec2 w = relative_velocity - relative_position * inv_time_horizon;
+                const float w_length_sq = length_sq(w);
+                const float dot_product = glm::dot(w, relative_position);
+
+                if (dot_product < 0.f && dot_product * dot_product > combined_radius_sq * w_length_sq)
+                {
+                    // project on the cutoff circle
+                    const float w_length = std::sqrt(w_length_sq);
+                    const glm::vec2 unit_w = w / w_length;
+                    line.direction = glm::vec2(unit_w.y, -unit_w.x);
+                    u = unit_w * (combined_radius * inv_time_horizon - w_length);
+                }
+                else
+                {
+                    // project on the cone legs
+                    const float leg = std::sqrt(dist_sq - combined_radius_sq);
+                    if (det(relative_position, w) > 0.f)
+                    {
+                        line.direction = glm::vec2(
+                            relative_position.x * leg - relative_position.y * combined_radius,
+                            relative_position.x * combined_radius + relative_position.y * leg) / dist_sq;
+                    }
+                    else
+                    {
+                        line.direction = -glm::vec2(
+                            relative_position.x * leg + relative_position.y * combined_radius,
+                            -relative_position.x * combined_radius + relative_position.y * leg) / dist_sq;
+                    }
+                    u = line.direction * glm::dot(relative_velocity, line.direction) - relative_velocity;
+                }
+            }
+            else
+            {
+                // already overlapping: resolve within one tick
+                const glm::vec2 w = relative_velocity - relative_position * inv_time_step;
+                const float w_length = std::sqrt(length_sq(w));
+                const glm::vec2 unit_w = (w_length > 0.f) ? w / w_length : glm::vec2(1.f, 0.f);
+                line.direction = glm::vec2(unit_w.y, -unit_w.x);
+                u = unit_w * (combined_radius * inv_time_step - w_length);
+            }
+
+            // each side takes half of the responsibility
+            line.point = velocity + 0.5f * u;
+        }
+
+        glm::vec2 result;
+        const size_t line_count = static_cast<size_t>(neighbor_count);
+        const size_t failed_line = linear_program_2(lines.data(), line_count, max_speed, m_preferred_velocities[agent], false, result);
+        if (failed_line < line_count)
+        {
+            linear_program_3(lines.data(), line_count, failed_line, max_speed, result);
+        }
+        return result;
+    }
+}
+}
+}
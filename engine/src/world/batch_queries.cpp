@@ -0,0 +1,93 @@
+#include "world/batch_queries.h"
+
+#include <cmath>
+
+namespace SketchBook
+{
+namespace World
+{
+    // spreads the low 16 bits of v over the even bits
+    static inline uint32_t part_1_by_1(uint32_t v)
+    {
+        v &= 0x0000ffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+
+    size_t nearest_ids(const SpatialHashGrid& grid, const glm::vec2& center, const size_t k, uint32_t* out_ids)
+    {
+        const size_t wanted = std::min({k, BatchQuery::MAX_NEAREST, grid.size()});
+        if (wanted == 0) return 0;
+
+        struct Candidate { float distance_sq; uint32_t id; };
+        Candidate best[BatchQuery::MAX_NEAREST];
+
+        // grow the radius until it holds k items; everything closer is inside it, so the result is exact
+        float radius = grid.cell_size();
+        while (true)
+        {
+            size_t found = 0;
+            grid.for_each_in_radius(center, radius, [&](const uint32_t item, const glm::vec2& position) {
+                const glm::vec2 offset = position - center;
+                const float distance = glm::dot(offset, offset);
+                if (found == wanted && distance >= best[found - 1].distance_sq) return;
+
+                size_t slot = (found < wanted) ? found++ : found - 1;
+                while (slot > 0 && best[slot - 1].distance_sq > distance)
+                {
+                    best[slot] = best[slot - 1];
+                    --slot;
+                }
+                best[slot] = Candidate{distance, item};
+            });
+
+            if (found == wanted)
+            {
+                for (size_t i = 0; i < found; i++)
+                {
+                    out_ids[i] = best[i].id;
+                }
+                return found;
+            }
+            radius *= 2.f;
+        }
+    }
+
+    void BatchQuery::sort_points(const glm::vec2* points, const size_t count)
+    {
+        m_keys.resize(count);
+        m_order.resize(count);
+        if (count == 0) return;
+
+        glm::vec2 lo = points[0];
+        glm::vec2 hi = points[0];
+        for (size_t i = 1; i < count; i++)
+        {
+            lo = glm::min(lo, points[i]);
+            hi = glm::max(hi, points[i]);
+        }
+
+        const glm::vec2 extent = glm::max(hi - lo, glm::vec2(1e-6f));
+        const float scale_x = 65535.f / extent.x;
+        const float scale_y = 65535.f / extent.y;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint32_t qx = static_cast<uint32_t>((points[i].x - lo.x) * scale_x);
+            const uint32_t qy = static_cast<uint32_t>((points[i].y - lo.y) * scale_y);
+            const uint64_t code = part_1_by_1(qx) | (part_1_by_1(qy) << 1);
+            m_keys[i] = (code << 32) | static_cast<uint64_t>(i);
+        }
+
+        std::sort(m_keys.begin(), m_keys.end());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            m_order[i] = static_cast<uint32_t>(m_keys[i] & 0xffffffffu);
+        }
+    }
+}
+}
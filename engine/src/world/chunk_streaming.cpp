@@ -0,0 +1,210 @@
+#include "world/chunk_streaming.h"
+
+#include "spdlog/spdlog.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Streaming
+{
+    std::string chunk_file_name(const ChunkCoord& coord)
+    {
+        return "chunk_" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + ".skchunk";
+    }
+
+    bool write_chunk(const std::string& path, const ChunkCoord& coord, const std::vector<ChunkObjectRecord>& objects,
+        const std::vector<float>& heights, const uint32_t terrain_resolution)
+    {
+        if (heights.size() != static_cast<size_t>(terrain_resolution) * terrain_resolution)
+        {
+            spdlog::error("write_chunk: expected {} heights, got {}", terrain_resolution * terrain_resolution, heights.size());
+            return false;
+        }
+
+        ChunkHeader header;
+        header.x = coord.x;
+        header.y = coord.y;
+        header.object_count = static_cast<uint32_t>(objects.size());
+        header.terrain_resolution = terrain_resolution;
+        header.objects_offset = sizeof(ChunkHeader);
+        header.terrain_offset = header.objects_offset + objects.size() * sizeof(ChunkObjectRecord);
+
+        std::vector<uint8_t> buffer(header.terrain_offset + heights.size() * sizeof(float));
+        std::memcpy(buffer.data(), &header, sizeof(ChunkHeader));
+        if (!objects.empty()) std::memcpy(buffer.data() + header.objects_offset, objects.data(), objects.size() * sizeof(ChunkObjectRecord));
+        if (!heights.empty()) std::memcpy(buffer.data() + header.terrain_offset, heights.data(), heights.size() * sizeof(float));
+
+        return IO::write_file(path, buffer.data(), buffer.size());
+    }
+
+    std::shared_ptr<ChunkData> load_chunk(const std::string& path, const ChunkCoord& coord)
+    {
+        auto chunk = std::make_shared<ChunkData>();
+        chunk->coord = coord;
+
+        if (!chunk->file.open(path)) return chunk;
+
+        const uint8_t* base = chunk->file.data();
+        const size_t size = chunk->file.size();
+        const ChunkHeader* header = reinterpret_cast<const ChunkHeader*>(base);
+
+        const bool b_valid = size >= sizeof(ChunkHeader)
+            && header->magic == CHUNK_MAGIC
+            && header->version == CHUNK_VERSION
+            && header->x == coord.x && header->y == coord.y
+            && header->objects_offset % alignof(ChunkObjectRecord) == 0
+            && header->terrain_offset % alignof(float) == 0
+            && IO::range_fits(header->objects_offset, header->object_count, sizeof(ChunkObjectRecord), size)
+            && IO::range_fits(header->terrain_offset, static_cast<uint64_t>(header->terrain_resolution) * header->terrain_resolution, sizeof(float), size);
+
+        if (!b_valid)
+        {
+            spdlog::warn("load_chunk: {} is not a valid chunk ({}, {}), treating it as empty", path, coord.x, coord.y);
+            chunk->file.close();
+            return chunk;
+        }
+
+        // fault the pages in here, on the loading thread, instead of on first use
+        chunk->file.prefault();
+
+        chunk->header = header;
+        chunk->objects = reinterpret_cast<const ChunkObjectRecord*>(base + header->objects_offset);
+        chunk->heights = reinterpret_cast<const float*>(base + header->terrain_offset);
+        return chunk;
+    }
+
+    ChunkStreamer::ChunkStreamer(const std::string& directory, const ChunkStreamingParams& params, Threading::ThreadPool& pool)
+        : m_directory{directory}, m_params{params}, m_pool{pool}
+    {
+        if (!m_directory.empty() && m_directory.back() != '/' && m_directory.back() != '\\') m_directory += '/';
+    }
+
+    ChunkStreamer::~ChunkStreamer()
+    {
+        // loads only capture their path, but do not leave them running past the streamer
+        for (auto& [coord, future] : m_pending)
+        {
+            future.wait();
+        }
+    }
+
+    ChunkCoord ChunkStreamer::chunk_at(const glm::vec2& position) const
+    {
+        return ChunkCoord{
+            static_cast<int32_t>(std::floor(position.x / m_params.chunk_size)),
+            static_cast<int32_t>(std::floor(position.y / m_params.chunk_size))};
+    }
+
+    void ChunkStreamer::update(const std::vector<glm::vec2>& focus_points)
+    {
+        collect_finished(false);
+
+        m_wanted.clear();
+        std::vector<ChunkCoord> centers;
+        centers.reserve(focus_points.size());
+        for (const glm::vec2& point : focus_points)
+        {
+            centers.push_back(chunk_at(point));
+        }
+
+        // walk rings outward so the closest chunks are scheduled first
+        for (int ring = 0; ring <= m_params.load_radius; ring++)
+        {
+            for (const ChunkCoord& center : centers)
+            {
+                for (int dy = -ring; dy <= ring; dy++)
+                {
+                    for (int dx = -ring; dx <= ring; dx++)
+                    {
+                        if (std::max(std::abs(dx), std::abs(dy)) != ring) continue;
+
+                        const ChunkCoord coord{center.x + dx, center.y + dy};
+                        if (!m_wanted.insert(coord).second) continue;
+
+                        auto resident = m_resident.find(coord);
+                        if (resident != m_resident.end())
+                        {
+                            m_lru.splice(m_lru.begin(), m_lru, resident->second.lru);
+                            continue;
+                        }
+
+                        if (m_pending.count(coord) || m_pending.size() >= m_params.max_loads_in_flight) continue;
+
+                        const std::string path = m_directory + chunk_file_name(coord);
+                        m_pending.emplace(coord, m_pool.submit([path, coord]() { return load_chunk(path, coord); }));
+                    }
+                }
+            }
+        }
+
+        evict_over_budget();
+    }
+
+    void ChunkStreamer::flush()
+    {
+        collect_finished(true);
+        evict_over_budget();
+    }
+
+    std::shared_ptr<const ChunkData> ChunkStreamer::acquire(const ChunkCoord& coord) const
+    {
+        auto it = m_resident.find(coord);
+        return (it == m_resident.end()) ? nullptr : it->second.chunk;
+    }
+
+    void ChunkStreamer::collect_finished(const bool b_wait)
+    {
+        for (auto it = m_pending.begin(); it != m_pending.end();)
+        {
+            if (!b_wait && it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            make_resident(it->second.get());
+            it = m_pending.erase(it);
+        }
+    }
+
+    void ChunkStreamer::make_resident(std::shared_ptr<const ChunkData> chunk)
+    {
+        m_lru.push_front(chunk->coord);
+        m_resident_bytes += chunk->bytes();
+        m_resident.emplace(chunk->coord, Resident{chunk, m_lru.begin()});
+
+        if (on_chunk_loaded) on_chunk_loaded(chunk);
+    }
+
+    void ChunkStreamer::evict_over_budget()
+    {
+        // oldest first, never a chunk that a focus point still wants
+        auto it = m_lru.end();
+        while (m_resident_bytes > m_params.memory_budget && it != m_lru.begin())
+        {
+            --it;
+            if (m_wanted.count(*it)) continue;
+
+            auto resident = m_resident.find(*it);
+            std::shared_ptr<const ChunkData> chunk = std::move(resident->second.chunk);
+            m_resident_bytes -= chunk->bytes();
+            m_resident.erase(resident);
+            it = m_lru.erase(it);
+
+            if (on_chunk_evicted) on_chunk_evicted(chunk);
+        }
+
+        if (m_resident_bytes > m_params.memory_budget && !b_warned_budget)
+        {
+            spdlog::warn("chunk streaming: wanted chunks need {} bytes, over the {} byte budget", m_resident_bytes, m_params.memory_budget);
+            b_warned_budget = true;
+        }
+    }
+}
+}
+}
@@ -0,0 +1,460 @@
+#include "world/collision.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define SK_COLLISION_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Collision
+{
+    static constexpr size_t SWEEP_GRAIN = 2048;
+    static constexpr size_t NARROWPHASE_GRAIN = 4096;
+
+    static inline uint64_t pair_key(const uint32_t a, const uint32_t b)
+    {
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    CollisionWorld::CollisionWorld(const float strip_height, Threading::ThreadPool& pool)
+        : m_pool{pool}, m_strip_height{std::max(strip_height, 1e-3f)}, m_inv_strip_height{1.f / m_strip_height}
+    {
+    }
+
+    uint32_t CollisionWorld::add_object(KinematicObject* object)
+    {
+        return allocate(Shape::Circle, object->get_position(), {0.f, 0.f}, object->get_radius(), object);
+    }
+
+    uint32_t CollisionWorld::add_circle(const glm::vec2& center, const float radius)
+    {
+        return allocate(Shape::Circle, center, {0.f, 0.f}, radius, nullptr);
+    }
+
+    uint32_t CollisionWorld::add_box(const glm::vec2& center, const glm::vec2& half_extents)
+    {
+        return allocate(Shape::Box, center, glm::abs(half_extents), 0.f, nullptr);
+    }
+
+    uint32_t CollisionWorld::allocate(const Shape shape, const glm::vec2& center, const glm::vec2& half_extents, const float radius, KinematicObject* object)
+    {
+        uint32_t body;
+        if (!m_free.empty())
+        {
+            body = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            body = static_cast<uint32_t>(m_shapes.size());
+            m_center_x.emplace_back();
+            m_center_y.emplace_back();
+            m_half_x.emplace_back();
+            m_half_y.emplace_back();
+            m_radius.emplace_back();
+            m_shapes.emplace_back();
+            m_objects.emplace_back();
+            m_alive.emplace_back();
+            m_strip_lo.emplace_back();
+            m_strip_hi.emplace_back();
+        }
+
+        m_center_x[body] = center.x;
+        m_center_y[body] = center.y;
+        m_half_x[body] = half_extents.x;
+        m_half_y[body] = half_extents.y;
+        m_radius[body] = radius;
+        m_shapes[body] = shape;
+        m_objects[body] = object;
+        m_alive[body] = 1;
+        m_strip_lo[body] = 1;
+        m_strip_hi[body] = 0;
+        ++m_alive_count;
+        return body;
+    }
+
+    void CollisionWorld::remove(const uint32_t body)
+    {
+        if (body >= m_alive.size() || !m_alive[body]) return;
+
+        m_alive[body] = 0;
+        m_objects[body] = nullptr;
+        m_released.push_back(body);
+        --m_alive_count;
+
+        // removed bodies leave silently, no exit events
+        m_touching.erase(std::remove_if(m_touching.begin(), m_touching.end(), [body](const BodyPair& pair) {
+            return pair.a == body || pair.b == body;
+        }), m_touching.end());
+    }
+
+    void CollisionWorld::set_center(const uint32_t body, const glm::vec2& center)
+    {
+        m_center_x[body] = center.x;
+        m_center_y[body] = center.y;
+    }
+
+    void CollisionWorld::step()
+    {
+        sync_objects();
+        update_order();
+        sweep();
+        narrowphase();
+        diff_events();
+    }
+
+    void CollisionWorld::sync_objects()
+    {
+        m_pool.parallel_for(0, m_objects.size(), 8192, [&](const size_t first, const size_t last) {
+            for (size_t body = first; body < last; body++)
+            {
+                const KinematicObject* object = m_objects[body];
+                if (!object) continue;
+
+                const glm::vec2 position = object->get_position();
+                m_center_x[body] = position.x;
+                m_center_y[body] = position.y;
+                m_radius[body] = object->get_radius();
+            }
+        });
+    }
+
+    void CollisionWorld::update_order()
+    {
+        // keep proxies whose body still spans their strip, repair their order in place
+        size_t kept = 0;
+        for (size_t i = 0; i < m_proxies.size(); i++)
+        {
+            const uint32_t body = m_proxies[i].body;
+            if (!m_alive[body]) continue;
+
+            const float extent_y = m_half_y[body] + m_radius[body];
+            const int32_t strip = m_proxies[i].strip;
+            if (strip < strip_of(m_center_y[body] - extent_y) || strip > strip_of(m_center_y[body] + extent_y)) continue;
+
+            m_proxies[kept++] = Proxy{m_center_x[body] - m_half_x[body] - m_radius[body], strip, body};
+        }
+        m_proxies.resize(kept);
+        m_free.insert(m_free.end(), m_released.begin(), m_released.end());
+        m_released.clear();
+
+        // insertion sort: last step's order is nearly sorted, so this is close to linear
+        for (size_t slot = 1; slot < m_proxies.size(); slot++)
+        {
+            const Proxy proxy = m_proxies[slot];
+            size_t hole = slot;
+            while (hole > 0 && proxy < m_proxies[hole - 1])
+            {
+                m_proxies[hole] = m_proxies[hole - 1];
+                --hole;
+            }
+            m_proxies[hole] = proxy;
+        }
+
+        // proxies for strips bodies have just entered, including new bodies
+        m_entering.clear();
+        for (uint32_t body = 0; body < m_alive.size(); body++)
+        {
+            if (!m_alive[body]) continue;
+
+            const float extent_y = m_half_y[body] + m_radius[body];
+            const int32_t lo = strip_of(m_center_y[body] - extent_y);
+            const int32_t hi = strip_of(m_center_y[body] + extent_y);
+            const float min_x = m_center_x[body] - m_half_x[body] - m_radius[body];
+
+            for (int32_t strip = lo; strip <= hi; strip++)
+            {
+                if (strip < m_strip_lo[body] || strip > m_strip_hi[body]) m_entering.push_back(Proxy{min_x, strip, body});
+            }
+            m_strip_lo[body] = lo;
+            m_strip_hi[body] = hi;
+        }
+
+        if (!m_entering.empty())
+        {
+            std::sort(m_entering.begin(), m_entering.end());
+            m_merged.resize(m_proxies.size() + m_entering.size());
+            std::merge(m_proxies.begin(), m_proxies.end(), m_entering.begin(), m_entering.end(), m_merged.begin());
+            m_proxies.swap(m_merged);
+        }
+
+        const size_t count = m_proxies.size();
+        m_max_x.resize(count);
+        m_min_y.resize(count);
+        m_max_y.resize(count);
+        for (size_t slot = 0; slot < count; slot++)
+        {
+            const uint32_t body = m_proxies[slot].body;
+            const float extent_y = m_half_y[body] + m_radius[body];
+            m_max_x[slot] = m_center_x[body] + m_half_x[body] + m_radius[body];
+            m_min_y[slot] = m_center_y[body] - extent_y;
+            m_max_y[slot] = m_center_y[body] + extent_y;
+        }
+    }
+
+    void CollisionWorld::sweep()
+    {
+        const size_t count = m_proxies.size();
+        const size_t chunk_count = (count + SWEEP_GRAIN - 1) / SWEEP_GRAIN;
+        if (m_chunk_pairs.size() < chunk_count) m_chunk_pairs.resize(chunk_count);
+
+        m_pool.parallel_for(0, count, SWEEP_GRAIN, [&](const size_t first, const size_t last) {
+            std::vector<BodyPair>& pairs = m_chunk_pairs[first / SWEEP_GRAIN];
+            pairs.clear();
+
+            for (size_t i = first; i < last; i++)
+            {
+                const Proxy& proxy = m_proxies[i];
+                const float max_x = m_max_x[i];
+                const float min_y = m_min_y[i];
+                const float max_y = m_max_y[i];
+
+                // later proxies in the strip start at or after this one; stop at the first past our end
+                for (size_t j = i + 1; j < count && m_proxies[j].strip == proxy.strip && m_proxies[j].min_x <= max_x; j++)
+                {
+                    if (m_min_y[j] > max_y || min_y > m_max_y[j]) continue;
+
+                    // a pair shares every strip its y overlap touches; report it in the lowest one only
+                    if (strip_of(std::max(min_y, m_min_y[j])) != proxy.strip) continue;
+
+                    const uint32_t other = m_proxies[j].body;
+                    pairs.push_back(proxy.body < other ? BodyPair{proxy.body, other} : BodyPair{other, proxy.body});
+                }
+            }
+        });
+
+        m_pairs.clear();
+        for (size_t c = 0; c < chunk_count; c++)
+        {
+            m_pairs.insert(m_pairs.end(), m_chunk_pairs[c].begin(), m_chunk_pairs[c].end());
+        }
+    }
+
+    namespace
+    {
+        struct Lane
+        {
+            uint32_t circle;
+            uint32_t other;
+            BodyPair pair;
+        };
+
+        // circle c against other o (a box, or a circle with zero half extents);
+        // e is the offset from the closest point of o's box to c's center
+        CollisionContact finish_contact(const Lane& lane, const float cx, const float cy, const float cr,
+            const float ox, const float oy, const float ohx, const float ohy, const float orad,
+            const float ex, const float ey, const float dist_sq)
+        {
+            glm::vec2 n;        // from o towards c
+            glm::vec2 surface;  // on o
+            float depth;
+
+            const float dist = std::sqrt(dist_sq);
+            if (dist > 1e-6f)
+            {
+                n = glm::vec2(ex, ey) / dist;
+                surface = glm::vec2(cx - ex, cy - ey) + n * orad;
+                depth = cr + orad - dist;
+            }
+            else
+            {
+                // center inside o's box (or coincident circles): leave along the shallowest axis
+                const float dx = cx - ox;
+                const float dy = cy - oy;
+                const float pen_x = ohx - std::abs(dx);
+                const float pen_y = ohy - std::abs(dy);
+                if (pen_x <= pen_y)
+                {
+                    n = glm::vec2(dx < 0.f ? -1.f : 1.f, 0.f);
+                    surface = glm::vec2(ox + n.x * ohx, cy) + n * orad;
+                    depth = pen_x + cr + orad;
+                }
+                else
+                {
+                    n = glm::vec2(0.f, dy < 0.f ? -1.f : 1.f);
+                    surface = glm::vec2(cx, oy + n.y * ohy) + n * orad;
+                    depth = pen_y + cr + orad;
+                }
+            }
+
+            CollisionContact contact;
+            contact.body_a = lane.pair.a;
+            contact.body_b = lane.pair.b;
+            if (lane.circle == lane.pair.a)
+            {
+                // normal points from a (the circle) towards b (o); the point lies on b
+                contact.normal = -n;
+                contact.point = surface;
+            }
+            else
+            {
+                contact.normal = n;
+                contact.point = glm::vec2(cx, cy) - n * cr;
+            }
+            contact.depth = depth;
+            return contact;
+        }
+    }
+
+    void CollisionWorld::narrowphase()
+    {
+        const size_t count = m_pairs.size();
+        const size_t chunk_count = (count + NARROWPHASE_GRAIN - 1) / NARROWPHASE_GRAIN;
+        if (m_chunk_contacts.size() < chunk_count) m_chunk_contacts.resize(chunk_count);
+
+        m_pool.parallel_for(0, count, NARROWPHASE_GRAIN, [&](const size_t first, const size_t last) {
+            std::vector<CollisionContact>& contacts = m_chunk_contacts[first / NARROWPHASE_GRAIN];
+            contacts.clear();
+
+            Lane lanes[4];
+            int lane_count = 0;
+
+            auto flush_lanes = [&]() {
+                alignas(16) float cx[4], cy[4], cr[4], ox[4], oy[4], ohx[4], ohy[4], orad[4];
+                alignas(16) float ex[4], ey[4], dist_sq[4];
+                for (int k = 0; k < 4; k++)
+                {
+                    // unused lanes repeat lane 0 and are ignored below
+                    const Lane& lane = lanes[k < lane_count ? k : 0];
+                    cx[k] = m_center_x[lane.circle];
+                    cy[k] = m_center_y[lane.circle];
+                    cr[k] = m_radius[lane.circle];
+                    ox[k] = m_center_x[lane.other];
+                    oy[k] = m_center_y[lane.other];
+                    ohx[k] = m_half_x[lane.other];
+                    ohy[k] = m_half_y[lane.other];
+                    orad[k] = m_radius[lane.other];
+                }
+
+                int hits = 0;
+#ifdef SK_COLLISION_SSE
+                const __m128 dx = _mm_sub_ps(_mm_load_ps(cx), _mm_load_ps(ox));
+                const __m128 dy = _mm_sub_ps(_mm_load_ps(cy), _mm_load_ps(oy));
+                const __m128 hx = _mm_load_ps(ohx);
+                const __m128 hy = _mm_load_ps(ohy);
+                const __m128 zero = _mm_setzero_ps();
+                // clamp onto the box, the remainder is the offset from its closest point
+                const __m128 qx = _mm_min_ps(_mm_max_ps(dx, _mm_sub_ps(zero, hx)), hx);
+                const __m128 qy = _mm_min_ps(_mm_max_ps(dy, _mm_sub_ps(zero, hy)), hy);
+                const __m128 vx = _mm_sub_ps(dx, qx);
+                const __m128 vy = _mm_sub_ps(dy, qy);
+                const __m128 d2 = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+                const __m128 rs = _mm_add_ps(_mm_load_ps(cr), _mm_load_ps(orad));
+                hits = _mm_movemask_ps(_mm_cmplt_ps(d2, _mm_mul_ps(rs, rs)));
+                _mm_store_ps(ex, vx);
+                _mm_store_ps(ey, vy);
+                _mm_store_ps(dist_sq, d2);
+#else
+                for (int k = 0; k < 4; k++)
+                {
+                    const float dx = cx[k] - ox[k];
+                    const float dy = cy[k] - oy[k];
+                    ex[k] = dx - std::clamp(dx, -ohx[k], ohx[k]);
+                    ey[k] = dy - std::clamp(dy, -ohy[k], ohy[k]);
+                    dist_sq[k] = ex[k] * ex[k] + ey[k] * ey[k];
+                    const float rs = cr[k] + orad[k];
+                    if (dist_sq[k] < rs * rs) hits |= 1 << k;
+                }
+#endif
+                for (int k = 0; k < lane_count; k++)
+                {
+                    if (!(hits & (1 << k))) continue;
+                    contacts.push_back(finish_contact(lanes[k], cx[k], cy[k], cr[k], ox[k], oy[k], ohx[k], ohy[k], orad[k], ex[k], ey[k], dist_sq[k]));
+                }
+                lane_count = 0;
+            };
+
+            for (size_t p = first; p < last; p++)
+            {
+                const BodyPair pair = m_pairs[p];
+                const bool b_circle_a = m_shapes[pair.a] == Shape::Circle;
+                const bool b_circle_b = m_shapes[pair.b] == Shape::Circle;
+
+                if (b_circle_a || b_circle_b)
+                {
+                    lanes[lane_count++] = b_circle_a ? Lane{pair.a, pair.b, pair} : Lane{pair.b, pair.a, pair};
+                    if (lane_count == 4) flush_lanes();
+                    continue;
+                }
+
+                // box vs box
+                const float dx = m_center_x[pair.b] - m_center_x[pair.a];
+                const float dy = m_center_y[pair.b] - m_center_y[pair.a];
+                const float pen_x = m_half_x[pair.a] + m_half_x[pair.b] - std::abs(dx);
+                const float pen_y = m_half_y[pair.a] + m_half_y[pair.b] - std::abs(dy);
+                if (pen_x <= 0.f || pen_y <= 0.f) continue;
+
+                CollisionContact contact;
+                contact.body_a = pair.a;
+                contact.body_b = pair.b;
+                if (pen_x <= pen_y)
+                {
+                    contact.normal = glm::vec2(dx < 0.f ? -1.f : 1.f, 0.f);
+                    contact.depth = pen_x;
+                    contact.point = glm::vec2(m_center_x[pair.b] - contact.normal.x * m_half_x[pair.b], m_center_y[pair.a] + dy * 0.5f);
+                }
+                else
+                {
+                    contact.normal = glm::vec2(0.f, dy < 0.f ? -1.f : 1.f);
+                    contact.depth = pen_y;
+                    contact.point = glm::vec2(m_center_x[pair.a] + dx * 0.5f, m_center_y[pair.b] - contact.normal.y * m_half_y[pair.b]);
+                }
+                contacts.push_back(contact);
+            }
+            if (lane_count > 0) flush_lanes();
+        });
+
+        m_contacts.clear();
+        for (size_t c = 0; c < chunk_count; c++)
+        {
+            m_contacts.insert(m_contacts.end(), m_chunk_contacts[c].begin(), m_chunk_contacts[c].end());
+        }
+        std::sort(m_contacts.begin(), m_contacts.end(), [](const CollisionContact& l, const CollisionContact& r) {
+            return pair_key(l.body_a, l.body_b) < pair_key(r.body_a, r.body_b);
+        });
+    }
+
+    void CollisionWorld::diff_events()
+    {
+        m_entered.clear();
+        m_stayed.clear();
+        m_exited.clear();
+
+        // both lists are sorted by pair, so one merge pass classifies everything
+        size_t current = 0;
+        size_t previous = 0;
+        while (current < m_contacts.size() || previous < m_touching.size())
+        {
+            const uint64_t current_key = (current < m_contacts.size()) ? pair_key(m_contacts[current].body_a, m_contacts[current].body_b) : UINT64_MAX;
+            const uint64_t previous_key = (previous < m_touching.size()) ? pair_key(m_touching[previous].a, m_touching[previous].b) : UINT64_MAX;
+
+            if (current_key == previous_key)
+            {
+                m_stayed.push_back(m_contacts[current++]);
+                ++previous;
+            }
+            else if (current_key < previous_key)
+            {
+                m_entered.push_back(m_contacts[current++]);
+            }
+            else
+            {
+                m_exited.push_back(m_touching[previous++]);
+            }
+        }
+
+        m_touching.resize(m_contacts.size());
+        for (size_t i = 0; i < m_contacts.size(); i++)
+        {
+            m_touching[i] = BodyPair{m_contacts[i].body_a, m_contacts[i].body_b};
+        }
+    }
+}
+}
+}
@@ -0,0 +1,100 @@
+#include "world/flocking.h"
+
+#include <algorithm>
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Flocking
+{
+    Flock::Flock(const FlockingParams& params, Threading::ThreadPool& pool)
+        : m_params{params}, m_pool{pool}
+    {
+    }
+
+    const std::vector<SteeringOutput>& Flock::compute(const std::vector<Actor*>& actors)
+    {
+        const size_t count = actors.size();
+        m_positions.resize(count);
+        m_velocities.resize(count);
+        m_outputs.assign(count, SteeringOutput(0.f, 0.f, 0.f));
+
+        for (size_t i = 0; i < count; i++)
+        {
+            m_positions[i] = actors[i]->get_position();
+            m_velocities[i] = actors[i]->effective_velocity();
+        }
+
+        const float query_radius = std::max(m_params.neighbor_radius, m_params.separation_radius);
+        m_grid.set_cell_size(query_radius);
+        m_grid.build(m_positions);
+
+        const float neighbor_radius_sq = m_params.neighbor_radius * m_params.neighbor_radius;
+        const float separation_radius_sq = m_params.separation_radius * m_params.separation_radius;
+
+        m_pool.parallel_for(0, count, 512, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                const glm::vec2 position = m_positions[i];
+                const glm::vec2 velocity = m_velocities[i];
+
+                glm::vec2 separation{0.f, 0.f};
+                glm::vec2 center{0.f, 0.f};
+                glm::vec2 heading{0.f, 0.f};
+                int flockmates = 0;
+
+                m_grid.for_each_in_radius(position, query_radius, [&](const uint32_t other, const glm::vec2& other_position) {
+                    if (other == i) return;
+
+                    const glm::vec2 offset = position - other_position;
+                    const float dist_sq = glm::dot(offset, offset);
+
+                    if (dist_sq < separation_radius_sq && dist_sq > 0.f)
+                    {
+                        // offset / d^2 has length 1 / d: inverse-distance falloff, so the closest neighbors dominate
+                        separation += offset / dist_sq;
+                    }
+
+                    if (dist_sq < neighbor_radius_sq)
+                    {
+                        center += other_position;
+                        heading += m_velocities[other];
+                        ++flockmates;
+                    }
+                });
+
+                glm::vec2 linear = separation * m_params.separation_weight;
+                if (flockmates > 0)
+                {
+                    const float inv_count = 1.f / static_cast<float>(flockmates);
+                    linear += (center * inv_count - position) * m_params.cohesion_weight;
+                    linear += (heading * inv_count - velocity) * m_params.alignment_weight;
+                }
+
+                const float length = glm::length(linear);
+                if (length > m_params.max_linear)
+                {
+                    linear *= m_params.max_linear / length;
+                }
+
+                m_outputs[i].linear = linear;
+            }
+        });
+
+        return m_outputs;
+    }
+
+    void Flock::steer(const std::vector<Actor*>& actors, const Event_NextTick& event)
+    {
+        compute(actors);
+        for (size_t i = 0; i < actors.size(); i++)
+        {
+            const SteeringOutput& output = m_outputs[i];
+            SteeringOutputHandle handle(output.linear.x, output.linear.y, output.heading_delta, event.tick_count, 1.0);
+            actors[i]->add_steering(handle, event.tick_count);
+        }
+    }
+}
+}
+}
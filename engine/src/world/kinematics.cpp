@@ -0,0 +1,129 @@
+#include "world/kinematics.h"
+
+#include <algorithm>
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Kinematics
+{
+    entt::entity create(entt::registry& registry, const float x, const float y)
+    {
+        const entt::entity entity = registry.create();
+        registry.emplace<Position>(entity, glm::vec2{x, y});
+        registry.emplace<Velocity>(entity);
+        registry.emplace<Heading>(entity);
+        registry.emplace<MotionLimits>(entity);
+        return entity;
+    }
+
+    Prefab prefab(const MotionLimits& limits)
+    {
+        Prefab agent;
+        agent.set<Position>().set<Velocity>().set<Heading>().set(limits);
+        return agent;
+    }
+
+    void create_many(entt::registry& registry, const glm::vec2* positions, const size_t count, std::vector<entt::entity>& out_entities, const MotionLimits& limits)
+    {
+        static_assert(sizeof(Position) == sizeof(glm::vec2), "positions are read as Position overrides");
+        PrefabOverrides overrides;
+        overrides.set(reinterpret_cast<const Position*>(positions));
+        prefab(limits).instantiate(registry, count, out_entities, overrides);
+    }
+
+    void set_max_speed(entt::registry& registry, const entt::entity entity, const float max_speed)
+    {
+        registry.get<MotionLimits>(entity).max_speed = std::max(max_speed, 0.f);
+    }
+
+    void set_avoidance_velocity(entt::registry& registry, const entt::entity entity, const glm::vec2& velocity)
+    {
+        Velocity& v = registry.get<Velocity>(entity);
+        v.avoidance = velocity;
+        v.b_has_avoidance = true;
+    }
+
+    void add_steering(entt::registry& registry, const entt::entity entity, const SteeringOutputHandle& handle, const double current_tick)
+    {
+        Velocity& velocity = registry.get<Velocity>(entity);
+        Motion::add_steering(handle, velocity.linear, velocity.angular);
+
+        SteeringQueue& queue = registry.get_or_emplace<SteeringQueue>(entity);
+        queue.handles.push_back(handle);
+        Motion::sort_steering(queue.handles, current_tick);
+    }
+
+    void halt(entt::registry& registry, const entt::entity entity)
+    {
+        Velocity& velocity = registry.get<Velocity>(entity);
+        velocity.linear = glm::vec2(0.f);
+        velocity.angular = 0.f;
+        velocity.b_has_avoidance = false;
+    }
+
+    void steer(entt::registry& registry, const Event_NextTick& event)
+    {
+        // only entities that were ever steered have a queue, so this skips the idle crowd
+        for (const entt::entity entity : registry.view<SteeringQueue>())
+        {
+            std::vector<SteeringOutputHandle>& handles = registry.get<SteeringQueue>(entity).handles;
+            if (handles.empty()) continue;
+
+            auto [position, velocity, heading] = registry.get<Position, Velocity, Heading>(entity);
+            Motion::expire_steering(handles, event, velocity.linear, velocity.angular);
+            for (const SteeringOutputHandle& h : handles)
+            {
+                Motion::apply_steering(h, event, position.value, heading.degrees, velocity.linear, velocity.angular);
+            }
+        }
+    }
+
+    void integrate(entt::registry& registry, const Event_NextTick& event)
+    {
+        motion_group(registry).each([&](const entt::entity entity, Position& position, Velocity& velocity, Heading& heading) {
+            // linear stays the unclamped steering sum so expiring handles can still be subtracted from it
+            velocity.effective = (velocity.b_has_avoidance) ? velocity.avoidance : velocity.linear;
+            if (!velocity.b_has_avoidance && (velocity.effective.x != 0.f || velocity.effective.y != 0.f))
+            {
+                // idle agents skip the limits lookup
+                Motion::clamp_speed(velocity.effective, registry.get<MotionLimits>(entity).max_speed);
+            }
+            velocity.b_has_avoidance = false;
+
+            Motion::integrate(event, velocity.effective, velocity.angular, position.value, heading.degrees);
+        });
+    }
+
+    void update(entt::registry& registry, const Event_NextTick& event)
+    {
+        steer(registry, event);
+        integrate(registry, event);
+    }
+
+    size_t cull(entt::registry& registry, const glm::vec2& lo, const glm::vec2& hi, std::vector<entt::entity>& out_entities)
+    {
+        const size_t before = out_entities.size();
+        motion_group(registry).each([&](const entt::entity entity, const Position& position, const Velocity&, const Heading&) {
+            const glm::vec2& p = position.value;
+            if (p.x >= lo.x && p.y >= lo.y && p.x <= hi.x && p.y <= hi.y)
+            {
+                out_entities.push_back(entity);
+            }
+        });
+        return out_entities.size() - before;
+    }
+
+    void gather_render_positions(entt::registry& registry, std::vector<glm::vec4>& out_positions)
+    {
+        auto group = motion_group(registry);
+        out_positions.clear();
+        out_positions.reserve(group.size());
+        group.each([&](const Position& position, const Velocity&, const Heading& heading) {
+            out_positions.emplace_back(position.value.x, -0.1f, position.value.y, glm::radians(heading.degrees));
+        });
+    }
+}
+}
+}
@@ -0,0 +1,332 @@
+#include "world/loose_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace SketchBook
+{
+namespace View
+{
+    template<int Dim>
+    LooseTree<Dim>::LooseTree(const glm::vec3& center, const float half_extent, const int max_depth)
+        : m_center{center}, m_half_extent{half_extent}, m_max_depth{std::clamp(max_depth, 0, MAX_DEPTH)}
+    {
+        clear();
+    }
+
+    template<int Dim>
+    void LooseTree<Dim>::clear()
+    {
+        m_nodes.clear();
+        m_free_nodes.clear();
+        m_entries.clear();
+        m_free_entries.clear();
+        m_slots.clear();
+        allocate_node(m_center, m_half_extent, 0, NONE);
+    }
+
+    template<int Dim>
+    void LooseTree<Dim>::load(const std::vector<WorldObject>& in_objects)
+    {
+        clear();
+        m_entries.reserve(in_objects.size());
+        m_slots.reserve(in_objects.size());
+        for (const WorldObject& object : in_objects)
+        {
+            insert(object);
+        }
+    }
+
+    template<int Dim>
+    bool LooseTree<Dim>::insert(const WorldObject& object)
+    {
+        if (m_slots.count(object.id)) return false;
+
+        int32_t entry;
+        if (!m_free_entries.empty())
+        {
+            entry = m_free_entries.back();
+            m_free_entries.pop_back();
+        }
+        else
+        {
+            entry = static_cast<int32_t>(m_entries.size());
+            m_entries.emplace_back();
+        }
+
+        m_entries[entry].object = object;
+        m_slots[object.id] = entry;
+        link(entry, find_node(object));
+        return true;
+    }
+
+    template<int Dim>
+    bool LooseTree<Dim>::remove(const int id)
+    {
+        auto it = m_slots.find(id);
+        if (it == m_slots.end()) return false;
+
+        const int32_t entry = it->second;
+        const int32_t node = m_entries[entry].node;
+        unlink(entry);
+        prune(node);
+
+        m_free_entries.push_back(entry);
+        m_slots.erase(it);
+        return true;
+    }
+
+    template<int Dim>
+    bool LooseTree<Dim>::move_object(const int id, const glm::vec3& delta)
+    {
+        auto it = m_slots.find(id);
+        if (it == m_slots.end()) return false;
+
+        const int32_t entry = it->second;
+        WorldObject& object = m_entries[entry].object;
+        object.update_position(delta);
+
+        const int32_t node = m_entries[entry].node;
+        if (fits_loose(m_nodes[node], object)) return false;
+
+        unlink(entry);
+        prune(node);
+        link(entry, find_node(object));
+        return true;
+    }
+
+    template<int Dim>
+    WorldObject* LooseTree<Dim>::get_object(const int id)
+    {
+        auto it = m_slots.find(id);
+        return (it == m_slots.end()) ? nullptr : &m_entries[it->second].object;
+    }
+
+    template<int Dim>
+    const WorldObject* LooseTree<Dim>::get_object(const int id) const
+    {
+        auto it = m_slots.find(id);
+        return (it == m_slots.end()) ? nullptr : &m_entries[it->second].object;
+    }
+
+    template<int Dim>
+    size_t LooseTree<Dim>::query_box(const WorldBox& box, int* out_ids, const size_t capacity) const
+    {
+        size_t count = 0;
+        for_each_in_box(box, [&](const WorldObject& object) {
+            if (count < capacity) out_ids[count] = object.id;
+            ++count;
+        });
+        return count;
+    }
+
+    template<int Dim>
+    size_t LooseTree<Dim>::query_point(const WorldPoint& point, int* out_ids, const size_t capacity) const
+    {
+        return query_box(WorldBox{point, point}, out_ids, capacity);
+    }
+
+    template<int Dim>
+    size_t LooseTree<Dim>::query_nearest(const WorldPoint& point, const size_t k, int* out_ids, const size_t capacity) const
+    {
+        const size_t wanted = std::min({k, MAX_NEAREST, size()});
+        if (wanted == 0) return 0;
+
+        struct Candidate { float distance_sq; int id; };
+        Candidate best[MAX_NEAREST];
+
+        const glm::vec3 center{point.x, point.y, point.h};
+
+        // start from the average spacing and grow the window until it holds k objects;
+        // anything closer than the radius is inside the window, so the result is exact
+        const float spacing = 2.f * m_half_extent / std::pow(static_cast<float>(size()), 1.f / Dim);
+        float radius = spacing * 0.5f + 1e-3f;
+
+        // distance to the far corner of the root's loose bounds; past it only objects outside the world are left
+        float reach_sq = 0.f;
+        for (int i = 0; i < Dim; i++)
+        {
+            const float reach = std::abs(center[i] - m_center[i]) + 2.f * m_half_extent;
+            reach_sq += reach * reach;
+        }
+        const float reach = std::sqrt(reach_sq);
+
+        while (true)
+        {
+            size_t found = 0;
+            for_each_in_radius(center, radius, [&](const WorldObject& object) {
+                const float distance = distance_sq(center, object);
+                if (found == wanted && distance >= best[found - 1].distance_sq) return;
+
+                size_t slot = (found < wanted) ? found++ : found - 1;
+                while (slot > 0 && best[slot - 1].distance_sq > distance)
+                {
+                    best[slot] = best[slot - 1];
+                    --slot;
+                }
+                best[slot] = Candidate{distance, object.id};
+            });
+
+            // an unbounded pass sees every finite object, so whatever it found is all there is
+            // (fewer than k when some entries have NaN bounds, or none for a NaN query point)
+            if (found == wanted || std::isinf(radius))
+            {
+                for (size_t i = 0; i < found && i < capacity; i++)
+                {
+                    out_ids[i] = best[i].id;
+                }
+                return found;
+            }
+            radius = (radius < reach) ? radius * 2.f : std::numeric_limits<float>::infinity();
+        }
+    }
+
+    template<int Dim>
+    float LooseTree<Dim>::distance_sq(const glm::vec3& point, const WorldObject& object)
+    {
+        float sum = 0.f;
+        for (int i = 0; i < Dim; i++)
+        {
+            const float offset = point[i] - std::clamp(point[i], object.min_corner[i], object.max_corner[i]);
+            sum += offset * offset;
+        }
+        return sum;
+    }
+
+    template<int Dim>
+    bool LooseTree<Dim>::fits_loose(const Node& node, const WorldObject& object) const
+    {
+        const float loose = node.half * 2.f;
+        for (int i = 0; i < Dim; i++)
+        {
+            if (object.min_corner[i] < node.center[i] - loose || object.max_corner[i] > node.center[i] + loose) return false;
+        }
+        return true;
+    }
+
+    template<int Dim>
+    int32_t LooseTree<Dim>::allocate_node(const glm::vec3& center, const float half, const int depth, const int32_t parent)
+    {
+        int32_t index;
+        if (!m_free_nodes.empty())
+        {
+            index = m_free_nodes.back();
+            m_free_nodes.pop_back();
+        }
+        else
+        {
+            index = static_cast<int32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        Node& node = m_nodes[index];
+        node.center = center;
+        node.half = half;
+        node.depth = depth;
+        node.parent = parent;
+        std::fill(std::begin(node.children), std::end(node.children), NONE);
+        node.head = NONE;
+        node.child_count = 0;
+        return index;
+    }
+
+    template<int Dim>
+    int32_t LooseTree<Dim>::find_node(const WorldObject& object)
+    {
+        float extent = 0.f;
+        glm::vec3 center(0.f);
+        for (int i = 0; i < Dim; i++)
+        {
+            extent = std::max(extent, (object.max_corner[i] - object.min_corner[i]) * 0.5f);
+            center[i] = (object.min_corner[i] + object.max_corner[i]) * 0.5f;
+        }
+
+        // objects whose center is outside the world stay in the root
+        for (int i = 0; i < Dim; i++)
+        {
+            if (std::abs(center[i] - m_center[i]) > m_half_extent) return 0;
+        }
+
+        // descend while the object still fits a child cell: a center inside the cell and an
+        // extent no larger than the cell half keep it within the child's loose bounds
+        int32_t index = 0;
+        while (m_nodes[index].depth < m_max_depth)
+        {
+            const float child_half = m_nodes[index].half * 0.5f;
+            if (extent > child_half) break;
+
+            int c = 0;
+            glm::vec3 child_center = m_nodes[index].center;
+            for (int i = 0; i < Dim; i++)
+            {
+                if (center[i] >= m_nodes[index].center[i])
+                {
+                    c |= 1 << i;
+                    child_center[i] += child_half;
+                }
+                else
+                {
+                    child_center[i] -= child_half;
+                }
+            }
+
+            int32_t child = m_nodes[index].children[c];
+            if (child == NONE)
+            {
+                // allocate_node may grow the pool, so no Node references are held across it
+                child = allocate_node(child_center, child_half, m_nodes[index].depth + 1, index);
+                m_nodes[index].children[c] = child;
+                m_nodes[index].child_count++;
+            }
+            index = child;
+        }
+        return index;
+    }
+
+    template<int Dim>
+    void LooseTree<Dim>::link(const int32_t entry, const int32_t node)
+    {
+        Entry& e = m_entries[entry];
+        e.node = node;
+        e.prev = NONE;
+        e.next = m_nodes[node].head;
+        if (e.next != NONE) m_entries[e.next].prev = entry;
+        m_nodes[node].head = entry;
+    }
+
+    template<int Dim>
+    void LooseTree<Dim>::unlink(const int32_t entry)
+    {
+        Entry& e = m_entries[entry];
+        if (e.prev != NONE) m_entries[e.prev].next = e.next;
+        else m_nodes[e.node].head = e.next;
+        if (e.next != NONE) m_entries[e.next].prev = e.prev;
+        e.node = e.prev = e.next = NONE;
+    }
+
+    template<int Dim>
+    void LooseTree<Dim>::prune(int32_t node)
+    {
+        // release empty leaves back to the pool, walking up while parents empty out too
+        while (node != 0 && m_nodes[node].head == NONE && m_nodes[node].child_count == 0)
+        {
+            Node& parent = m_nodes[m_nodes[node].parent];
+            for (int c = 0; c < CHILDREN; c++)
+            {
+                if (parent.children[c] == node)
+                {
+                    parent.children[c] = NONE;
+                    parent.child_count--;
+                    break;
+                }
+            }
+            m_free_nodes.push_back(node);
+            node = m_nodes[node].parent;
+        }
+    }
+
+    template class LooseTree<2>;
+    template class LooseTree<3>;
+}
+}
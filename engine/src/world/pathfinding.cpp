@@ -0,0 +1,718 @@
+#include "world/pathfinding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace SketchBook
+{
+namespace World
+{
+namespace Pathfinding
+{
+    namespace
+    {
+        constexpr float INF_COST = std::numeric_limits<float>::infinity();
+        constexpr float DIAGONAL_COST = 1.41421356f;
+
+        // min-entrance length for which two portals (one per run end) are placed instead of one
+        constexpr int SPLIT_ENTRANCE_LENGTH = 6;
+
+        struct OpenEntry
+        {
+            float f;
+            int index;
+
+            bool operator>(const OpenEntry& other) const { return f > other.f; }
+        };
+
+        using OpenList = std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>>;
+
+        inline float octile_distance(const GridCell& a, const GridCell& b)
+        {
+            const float dx = static_cast<float>(std::abs(a.x - b.x));
+            const float dy = static_cast<float>(std::abs(a.y - b.y));
+            return std::max(dx, dy) + (DIAGONAL_COST - 1.f) * std::min(dx, dy);
+        }
+
+        inline uint64_t cache_key(const int start_cluster, const int goal_cluster)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(start_cluster)) << 32) | static_cast<uint32_t>(goal_cluster);
+        }
+    }
+
+    // NavigationGrid
+
+    NavigationGrid::NavigationGrid(const int width, const int height, const float cell_size, const glm::vec2 origin)
+        :   m_width{std::max(width, 1)},
+            m_height{std::max(height, 1)},
+            m_cell_size{cell_size > 0.f ? cell_size : 1.f},
+            m_origin{origin},
+            m_walkable(static_cast<size_t>(m_width) * static_cast<size_t>(m_height), 1)
+    {
+    }
+
+    void NavigationGrid::set_walkable(const GridCell& cell, const bool walkable)
+    {
+        if (in_bounds(cell))
+        {
+            m_walkable[index(cell)] = walkable ? 1 : 0;
+        }
+    }
+
+    void NavigationGrid::set_walkable_rect(const GridCell& min_cell, const GridCell& max_cell, const bool walkable)
+    {
+        for (int y = std::max(min_cell.y, 0); y <= std::min(max_cell.y, m_height - 1); y++)
+        {
+            for (int x = std::max(min_cell.x, 0); x <= std::min(max_cell.x, m_width - 1); x++)
+            {
+                m_walkable[index({x, y})] = walkable ? 1 : 0;
+            }
+        }
+    }
+
+    GridCell NavigationGrid::cell_at(const glm::vec2& world_position) const
+    {
+        const glm::vec2 local = (world_position - m_origin) / m_cell_size;
+        return {
+            std::clamp(static_cast<int>(std::floor(local.x)), 0, m_width - 1),
+            std::clamp(static_cast<int>(std::floor(local.y)), 0, m_height - 1)
+        };
+    }
+
+    glm::vec2 NavigationGrid::cell_center(const GridCell& cell) const
+    {
+        return m_origin + glm::vec2(static_cast<float>(cell.x) + 0.5f, static_cast<float>(cell.y) + 0.5f) * m_cell_size;
+    }
+
+    // HierarchicalGraph
+
+    HierarchicalGraph::HierarchicalGraph(NavigationGrid grid, const int cluster_size)
+        :   m_grid{std::move(grid)},
+            m_cluster_size{std::max(cluster_size, 2)}
+    {
+        m_clusters_x = (m_grid.width() + m_cluster_size - 1) / m_cluster_size;
+        m_clusters_y = (m_grid.height() + m_cluster_size - 1) / m_cluster_size;
+        m_cluster_nodes.resize(cluster_count());
+        m_node_at_cell.assign(static_cast<size_t>(m_grid.width()) * static_cast<size_t>(m_grid.height()), -1);
+
+        build_entrances();
+        build_intra_edges();
+    }
+
+    int HierarchicalGraph::cluster_of(const GridCell& cell) const
+    {
+        return (cell.y / m_cluster_size) * m_clusters_x + (cell.x / m_cluster_size);
+    }
+
+    HierarchicalGraph::ClusterRect HierarchicalGraph::cluster_rect(const int cluster) const
+    {
+        const int cx = cluster % m_clusters_x;
+        const int cy = cluster / m_clusters_x;
+        const GridCell min_cell{cx * m_cluster_size, cy * m_cluster_size};
+        const GridCell max_cell{
+            std::min(min_cell.x + m_cluster_size, m_grid.width()) - 1,
+            std::min(min_cell.y + m_cluster_size, m_grid.height()) - 1
+        };
+        return {min_cell, max_cell};
+    }
+
+    int HierarchicalGraph::add_node(const GridCell& cell)
+    {
+        int& node_id = m_node_at_cell[m_grid.index(cell)];
+        if (node_id < 0)
+        {
+            node_id = static_cast<int>(m_nodes.size());
+            const int cluster = cluster_of(cell);
+            m_nodes.push_back(AbstractNode{cell, cluster, {}});
+            m_cluster_nodes[cluster].push_back(node_id);
+        }
+        return node_id;
+    }
+
+    void HierarchicalGraph::add_edge(const int from, const int to, const float cost, const bool inter_cluster)
+    {
+        for (const AbstractEdge& edge : m_nodes[from].edges)
+        {
+            if (edge.to == to) return;
+        }
+        m_nodes[from].edges.push_back(AbstractEdge{to, cost, inter_cluster});
+    }
+
+    void HierarchicalGraph::build_entrance_run(const GridCell& a0, const GridCell& b0, const GridCell& step, const int length)
+    {
+        auto link = [&](const int offset) {
+            const GridCell a{a0.x + step.x * offset, a0.y + step.y * offset};
+            const GridCell b{b0.x + step.x * offset, b0.y + step.y * offset};
+            const int node_a = add_node(a);
+            const int node_b = add_node(b);
+            add_edge(node_a, node_b, 1.f, true);
+            add_edge(node_b, node_a, 1.f, true);
+        };
+
+        if (length < SPLIT_ENTRANCE_LENGTH)
+        {
+            link(length / 2);
+        }
+        else
+        {
+            link(0);
+            link(length - 1);
+        }
+    }
+
+    void HierarchicalGraph::build_entrances()
+    {
+        for (int cy = 0; cy < m_clusters_y; cy++)
+        {
+            for (int cx = 0; cx < m_clusters_x; cx++)
+            {
+                const ClusterRect rect = cluster_rect(cy * m_clusters_x + cx);
+
+                // east border: column max_cell.x against max_cell.x + 1
+                if (cx + 1 < m_clusters_x)
+                {
+                    const int x = rect.max_cell.x;
+                    int run_start = -1;
+                    for (int y = rect.min_cell.y; y <= rect.max_cell.y + 1; y++)
+                    {
+                        const bool open = y <= rect.max_cell.y && m_grid.is_walkable({x, y}) && m_grid.is_walkable({x + 1, y});
+                        if (open && run_start < 0) run_start = y;
+                        if (!open && run_start >= 0)
+                        {
+                            build_entrance_run({x, run_start}, {x + 1, run_start}, {0, 1}, y - run_start);
+                            run_start = -1;
+                        }
+                    }
+                }
+
+                // north border: row max_cell.y against max_cell.y + 1
+                if (cy + 1 < m_clusters_y)
+                {
+                    const int y = rect.max_cell.y;
+                    int run_start = -1;
+                    for (int x = rect.min_cell.x; x <= rect.max_cell.x + 1; x++)
+                    {
+                        const bool open = x <= rect.max_cell.x && m_grid.is_walkable({x, y}) && m_grid.is_walkable({x, y + 1});
+                        if (open && run_start < 0) run_start = x;
+                        if (!open && run_start >= 0)
+                        {
+                            build_entrance_run({run_start, y}, {run_start, y + 1}, {1, 0}, x - run_start);
+                            run_start = -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void HierarchicalGraph::build_intra_edges()
+    {
+        std::vector<float> dist;
+        std::vector<int> parent;
+
+        for (int cluster = 0; cluster < cluster_count(); cluster++)
+        {
+            const ClusterRect rect = cluster_rect(cluster);
+            const int rect_width = rect.max_cell.x - rect.min_cell.x + 1;
+            const std::vector<int>& cluster_nodes = m_cluster_nodes[cluster];
+
+            for (const int from : cluster_nodes)
+            {
+                search_grid(m_nodes[from].cell, nullptr, rect, dist, parent);
+                for (const int to : cluster_nodes)
+                {
+                    if (to == from) continue;
+                    const GridCell& cell = m_nodes[to].cell;
+                    const float cost = dist[(cell.y - rect.min_cell.y) * rect_width + (cell.x - rect.min_cell.x)];
+                    if (cost < INF_COST)
+                    {
+                        add_edge(from, to, cost, false);
+                    }
+                }
+            }
+        }
+    }
+
+    bool HierarchicalGraph::search_grid(
+        const GridCell& start,
+        const GridCell* goal,
+        const ClusterRect& rect,
+        std::vector<float>& out_dist,
+        std::vector<int>& out_parent) const
+    {
+        static constexpr int DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+        static constexpr int DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+        const int rect_width = rect.max_cell.x - rect.min_cell.x + 1;
+        const int rect_height = rect.max_cell.y - rect.min_cell.y + 1;
+        const size_t area = static_cast<size_t>(rect_width) * static_cast<size_t>(rect_height);
+
+        out_dist.assign(area, INF_COST);
+        out_parent.assign(area, -1);
+
+        auto inside = [&](const GridCell& c) {
+            return c.x >= rect.min_cell.x && c.y >= rect.min_cell.y && c.x <= rect.max_cell.x && c.y <= rect.max_cell.y;
+        };
+        auto local_index = [&](const GridCell& c) {
+            return (c.y - rect.min_cell.y) * rect_width + (c.x - rect.min_cell.x);
+        };
+
+        if (!inside(start) || !m_grid.is_walkable(start)) return false;
+        if (goal && (!inside(*goal) || !m_grid.is_walkable(*goal))) return false;
+
+        std::vector<uint8_t> closed(area, 0);
+        OpenList open;
+
+        const int start_index = local_index(start);
+        out_dist[start_index] = 0.f;
+        open.push({goal ? octile_distance(start, *goal) : 0.f, start_index});
+
+        const int goal_index = goal ? local_index(*goal) : -1;
+
+        while (!open.empty())
+        {
+            const OpenEntry entry = open.top();
+            open.pop();
+
+            if (closed[entry.index]) continue;
+            closed[entry.index] = 1;
+
+            if (entry.index == goal_index) return true;
+
+            const GridCell cell{rect.min_cell.x + entry.index % rect_width, rect.min_cell.y + entry.index / rect_width};
+
+            for (int n = 0; n < 8; n++)
+            {
+                const GridCell next{cell.x + DX[n], cell.y + DY[n]};
+                if (!inside(next) || !m_grid.is_walkable(next)) continue;
+
+                const bool diagonal = n >= 4;
+                // no corner cutting: both orthogonal neighbors must be open for a diagonal step
+                if (diagonal && (!m_grid.is_walkable({next.x, cell.y}) || !m_grid.is_walkable({cell.x, next.y}))) continue;
+
+                const int next_index = local_index(next);
+                if (closed[next_index]) continue;
+
+                const float cost = out_dist[entry.index] + (diagonal ? DIAGONAL_COST : 1.f);
+                if (cost < out_dist[next_index])
+                {
+                    out_dist[next_index] = cost;
+                    out_parent[next_index] = entry.index;
+                    open.push({cost + (goal ? octile_distance(next, *goal) : 0.f), next_index});
+                }
+            }
+        }
+
+        return goal == nullptr;
+    }
+
+    bool HierarchicalGraph::local_path(const GridCell& start, const GridCell& goal, const ClusterRect& rect, std::vector<GridCell>& out_cells) const
+    {
+        std::vector<float> dist;
+        std::vector<int> parent;
+        if (!search_grid(start, &goal, rect, dist, parent)) return false;
+
+        const int rect_width = rect.max_cell.x - rect.min_cell.x + 1;
+        const size_t first = out_cells.size();
+        int index = (goal.y - rect.min_cell.y) * rect_width + (goal.x - rect.min_cell.x);
+        while (index >= 0)
+        {
+            out_cells.push_back({rect.min_cell.x + index % rect_width, rect.min_cell.y + index / rect_width});
+            index = parent[index];
+        }
+        std::reverse(out_cells.begin() + first, out_cells.end());
+        return true;
+    }
+
+    bool HierarchicalGraph::refine_chain(const GridCell& start, const GridCell& goal, const std::vector<int>& chain, std::vector<GridCell>& out_cells) const
+    {
+        out_cells.clear();
+
+        // appends a segment, dropping its first cell (already the last cell of the previous segment)
+        std::vector<GridCell> segment;
+        auto append = [&](const GridCell& from, const GridCell& to, const ClusterRect& rect) {
+            segment.clear();
+            if (!local_path(from, to, rect, segment)) return false;
+            out_cells.insert(out_cells.end(), out_cells.empty() ? segment.begin() : segment.begin() + 1, segment.end());
+            return true;
+        };
+
+        if (!append(start, m_nodes[chain.front()].cell, cluster_rect(cluster_of(start)))) return false;
+
+        for (size_t i = 0; i + 1 < chain.size(); i++)
+        {
+            const AbstractNode& from = m_nodes[chain[i]];
+            const AbstractNode& to = m_nodes[chain[i + 1]];
+            if (from.cluster == to.cluster)
+            {
+                if (!append(from.cell, to.cell, cluster_rect(from.cluster))) return false;
+            }
+            else
+            {
+                out_cells.push_back(to.cell); // portal pairs are adjacent cells
+            }
+        }
+
+        return append(m_nodes[chain.back()].cell, goal, cluster_rect(cluster_of(goal)));
+    }
+
+    bool HierarchicalGraph::search_abstract(const GridCell& start, const GridCell& goal, std::vector<int>& out_chain) const
+    {
+        out_chain.clear();
+
+        const int node_count = static_cast<int>(m_nodes.size());
+        const int goal_node = node_count; // virtual node for the goal cell
+
+        // temporary links from start/goal into their clusters' portals
+        auto link_costs = [&](const GridCell& cell, std::vector<std::pair<int, float>>& out_links) {
+            const int cluster = cluster_of(cell);
+            const ClusterRect rect = cluster_rect(cluster);
+            const int rect_width = rect.max_cell.x - rect.min_cell.x + 1;
+            std::vector<float> dist;
+            std::vector<int> parent;
+            search_grid(cell, nullptr, rect, dist, parent);
+            for (const int node : m_cluster_nodes[cluster])
+            {
+                const GridCell& node_cell = m_nodes[node].cell;
+                const float cost = dist[(node_cell.y - rect.min_cell.y) * rect_width + (node_cell.x - rect.min_cell.x)];
+                if (cost < INF_COST) out_links.emplace_back(node, cost);
+            }
+        };
+
+        std::vector<std::pair<int, float>> start_links;
+        std::vector<std::pair<int, float>> goal_links;
+        link_costs(start, start_links);
+        link_costs(goal, goal_links);
+        if (start_links.empty() || goal_links.empty()) return false;
+
+        std::vector<float> goal_cost(node_count, INF_COST);
+        for (const auto& [node, cost] : goal_links) goal_cost[node] = cost;
+
+        std::vector<float> g(node_count + 1, INF_COST);
+        std::vector<int> parent(node_count + 1, -1);
+        std::vector<uint8_t> closed(node_count + 1, 0);
+        OpenList open;
+
+        for (const auto& [node, cost] : start_links)
+        {
+            g[node] = cost;
+            open.push({cost + octile_distance(m_nodes[node].cell, goal), node});
+        }
+
+        while (!open.empty())
+        {
+            const OpenEntry entry = open.top();
+            open.pop();
+
+            if (closed[entry.index]) continue;
+            closed[entry.index] = 1;
+
+            if (entry.index == goal_node)
+            {
+                for (int node = parent[goal_node]; node >= 0; node = parent[node])
+                {
+                    out_chain.push_back(node);
+                }
+                std::reverse(out_chain.begin(), out_chain.end());
+                return true;
+            }
+
+            const AbstractNode& node = m_nodes[entry.index];
+            for (const AbstractEdge& edge : node.edges)
+            {
+                if (closed[edge.to]) continue;
+                const float cost = g[entry.index] + edge.cost;
+                if (cost < g[edge.to])
+                {
+                    g[edge.to] = cost;
+                    parent[edge.to] = entry.index;
+                    open.push({cost + octile_distance(m_nodes[edge.to].cell, goal), edge.to});
+                }
+            }
+
+            if (goal_cost[entry.index] < INF_COST)
+            {
+                const float cost = g[entry.index] + goal_cost[entry.index];
+                if (cost < g[goal_node])
+                {
+                    g[goal_node] = cost;
+                    parent[goal_node] = entry.index;
+                    open.push({cost, goal_node});
+                }
+            }
+        }
+        return false;
+    }
+
+    bool HierarchicalGraph::find_path(
+        const GridCell& start,
+        const GridCell& goal,
+        std::vector<GridCell>& out_cells,
+        const std::vector<int>* cached_chain,
+        std::vector<int>* out_chain) const
+    {
+        out_cells.clear();
+        if (out_chain) out_chain->clear();
+
+        if (!m_grid.is_walkable(start) || !m_grid.is_walkable(goal)) return false;
+
+        if (start == goal)
+        {
+            out_cells.push_back(start);
+            return true;
+        }
+
+        const int start_cluster = cluster_of(start);
+        if (start_cluster == cluster_of(goal) && local_path(start, goal, cluster_rect(start_cluster), out_cells))
+        {
+            return true;
+        }
+
+        if (cached_chain && !cached_chain->empty() && refine_chain(start, goal, *cached_chain, out_cells))
+        {
+            if (out_chain) *out_chain = *cached_chain;
+            return true;
+        }
+
+        std::vector<int> chain;
+        if (!search_abstract(start, goal, chain) || !refine_chain(start, goal, chain, out_cells))
+        {
+            out_cells.clear();
+            return false;
+        }
+
+        if (out_chain) *out_chain = std::move(chain);
+        return true;
+    }
+
+    bool HierarchicalGraph::line_of_sight(const GridCell& a, const GridCell& b) const
+    {
+        // supercover walk between cell centers: visits every cell the segment touches,
+        // and an exact corner crossing must have both side cells open
+        int x = a.x;
+        int y = a.y;
+        const int nx = std::abs(b.x - a.x);
+        const int ny = std::abs(b.y - a.y);
+        const int step_x = (b.x > a.x) ? 1 : -1;
+        const int step_y = (b.y > a.y) ? 1 : -1;
+
+        for (int ix = 0, iy = 0; ix < nx || iy < ny;)
+        {
+            const long long decision = static_cast<long long>(1 + 2 * ix) * ny - static_cast<long long>(1 + 2 * iy) * nx;
+            if (decision == 0)
+            {
+                if (!m_grid.is_walkable({x + step_x, y}) || !m_grid.is_walkable({x, y + step_y})) return false;
+                x += step_x;
+                y += step_y;
+                ix++;
+                iy++;
+            }
+            else if (decision < 0)
+            {
+                x += step_x;
+                ix++;
+            }
+            else
+            {
+                y += step_y;
+                iy++;
+            }
+            if (!m_grid.is_walkable({x, y})) return false;
+        }
+        return true;
+    }
+
+    void HierarchicalGraph::smooth_path(std::vector<GridCell>& cells) const
+    {
+        if (cells.size() < 3) return;
+
+        std::vector<GridCell> smoothed;
+        smoothed.push_back(cells.front());
+
+        size_t anchor = 0;
+        while (anchor + 1 < cells.size())
+        {
+            size_t next = anchor + 1;
+            for (size_t candidate = cells.size() - 1; candidate > anchor + 1; candidate--)
+            {
+                if (line_of_sight(cells[anchor], cells[candidate]))
+                {
+                    next = candidate;
+                    break;
+                }
+            }
+            smoothed.push_back(cells[next]);
+            anchor = next;
+        }
+        cells = std::move(smoothed);
+    }
+
+    // PathfindingService
+
+    struct PathfindingService::State
+    {
+        std::shared_ptr<const HierarchicalGraph> graph;
+        size_t cache_capacity;
+
+        mutable std::shared_mutex cache_mutex;
+        std::unordered_map<uint64_t, std::vector<int>> chain_cache;
+        std::deque<uint64_t> chain_order; // insertion order, oldest first, for FIFO eviction
+        std::atomic<size_t> cache_hits{0};
+
+        PathResult solve(const PathRequest& path_request);
+    };
+
+    PathResult PathfindingService::State::solve(const PathRequest& path_request)
+    {
+        PathResult result;
+        const NavigationGrid& grid = graph->grid();
+        const GridCell start = grid.cell_at(path_request.start);
+        const GridCell goal = grid.cell_at(path_request.goal);
+        const uint64_t key = cache_key(graph->cluster_of(start), graph->cluster_of(goal));
+
+        std::vector<int> cached_chain;
+        {
+            std::shared_lock lock(cache_mutex);
+            if (auto it = chain_cache.find(key); it != chain_cache.end())
+            {
+                cached_chain = it->second;
+            }
+        }
+
+        std::vector<GridCell> cells;
+        std::vector<int> used_chain;
+        result.b_found = graph->find_path(start, goal, cells, &cached_chain, &used_chain);
+        if (!result.b_found) return result;
+
+        result.b_cache_hit = !cached_chain.empty() && used_chain == cached_chain;
+        if (result.b_cache_hit)
+        {
+            cache_hits.fetch_add(1);
+        }
+        else if (!used_chain.empty())
+        {
+            std::unique_lock lock(cache_mutex);
+            auto [it, b_inserted] = chain_cache.try_emplace(key);
+            if (b_inserted)
+            {
+                chain_order.push_back(key);
+                if (chain_cache.size() > cache_capacity)
+                {
+                    chain_cache.erase(chain_order.front());
+                    chain_order.pop_front();
+                }
+            }
+            it->second = std::move(used_chain);
+        }
+
+        if (path_request.b_smooth)
+        {
+            graph->smooth_path(cells);
+        }
+
+        // exact request endpoints replace the first/last cell centers
+        result.waypoints.reserve(cells.size());
+        result.waypoints.push_back(path_request.start);
+        for (size_t i = 1; i + 1 < cells.size(); i++)
+        {
+            result.waypoints.push_back(grid.cell_center(cells[i]));
+        }
+        result.waypoints.push_back(path_request.goal);
+
+        const float speed = std::max(path_request.speed, std::numeric_limits<float>::epsilon());
+        const float meters_per_tick = speed * path_request.seconds_per_tick;
+        double segment_tick = path_request.tick;
+
+        for (size_t i = 0; i + 1 < result.waypoints.size(); i++)
+        {
+            const glm::vec2 delta = result.waypoints[i + 1] - result.waypoints[i];
+            const float distance = glm::length(delta);
+            if (distance <= 0.f || meters_per_tick <= 0.f) continue;
+
+            // whole ticks, with the speed trimmed so the segment ends exactly on its waypoint
+            const double segment_ticks = std::ceil(distance / meters_per_tick);
+            const glm::vec2 velocity = delta / static_cast<float>(segment_ticks * path_request.seconds_per_tick);
+            result.steering.emplace_back(velocity.x, velocity.y, 0.f, segment_tick, segment_ticks, true, false, false);
+            segment_tick += segment_ticks;
+        }
+
+        return result;
+    }
+
+    PathfindingService::PathfindingService(
+        std::shared_ptr<const HierarchicalGraph> graph,
+        Threading::ThreadPool& pool,
+        const size_t cache_capacity)
+        :   m_state{std::make_shared<State>()},
+            m_pool{pool}
+    {
+        m_state->graph = std::move(graph);
+        m_state->cache_capacity = std::max<size_t>(cache_capacity, 1);
+    }
+
+    std::future<PathResult> PathfindingService::request(const PathRequest& path_request)
+    {
+        // the task keeps the graph and cache alive even if the service goes away first
+        return m_pool.submit([state = m_state, path_request]() {
+            return state->solve(path_request);
+        });
+    }
+
+    PathResult PathfindingService::solve(const PathRequest& path_request)
+    {
+        return m_state->solve(path_request);
+    }
+
+    void PathfindingService::clear_cache()
+    {
+        std::unique_lock lock(m_state->cache_mutex);
+        m_state->chain_cache.clear();
+        m_state->chain_order.clear();
+    }
+
+    size_t PathfindingService::cache_size() const
+    {
+        std::shared_lock lock(m_state->cache_mutex);
+        return m_state->chain_cache.size();
+    }
+
+    size_t PathfindingService::cache_hits() const
+    {
+        return m_state->cache_hits.load();
+    }
+
+    // PathFollower
+
+    void PathFollower::follow(PathResult&& path, const double current_tick)
+    {
+        m_path = std::move(path);
+        m_next_segment = 0;
+
+        // async results arrive late; shift the chain so its first segment starts now
+        if (!m_path.steering.empty())
+        {
+            const double offset = current_tick - m_path.steering.front().duration.created_at;
+            for (SteeringOutputHandle& handle : m_path.steering)
+            {
+                handle.duration.created_at += offset;
+            }
+        }
+    }
+
+    void PathFollower::update(KinematicObject& object, const Event_NextTick& event)
+    {
+        while (!is_finished() && m_path.steering[m_next_segment].duration.created_at <= event.tick_count)
+        {
+            object.add_steering(m_path.steering[m_next_segment], event.tick_count);
+            ++m_next_segment;
+        }
+    }
+}
+}
+}
@@ -46,6 +46,107 @@ namespace World
             b_wander{wander}, b_is_dynamic{is_dynamic}
     {}
 
+    namespace Motion
+    {
+        float wrap_heading(const float heading)
+        {
+            float h = fmod(heading, 360);
+            if (h > 180) h -= 360;
+            if (h < -180) h += 360;
+            return h;
+        }
+
+        float heading_from_velocity(const glm::vec2& velocity)
+        {
+            const float new_orientation = atan2(-velocity.x, velocity.y);
+            return wrap_heading(glm::degrees(new_orientation)-90);
+        }
+
+        void clamp_speed(glm::vec2& velocity, const float max_speed)
+        {
+            if (glm::length(velocity) > max_speed)
+            {
+                velocity = glm::normalize(velocity);
+                velocity *= max_speed;
+            }
+        }
+
+        void add_steering(const SteeringOutputHandle& handle, glm::vec2& linear_velocity, float& angular_velocity)
+        {
+            if (handle.b_is_dynamic) return;
+
+            linear_velocity += handle.steering_output.linear;
+            angular_velocity += handle.steering_output.heading_delta;
+        }
+
+        void remove_steering(const SteeringOutputHandle& handle, const Event_NextTick& event, glm::vec2& linear_velocity, float& angular_velocity)
+        {
+            if (handle.b_is_dynamic)
+            {
+                const float total_ticks = static_cast<float>(handle.duration.active_until);
+                const glm::vec2 velo_delta = total_ticks * handle.steering_output.linear * event.seconds_per_tick;
+                linear_velocity -= velo_delta;
+            }
+            else
+            {
+                linear_velocity -= handle.steering_output.linear;
+                angular_velocity -= handle.steering_output.heading_delta;
+            }
+        }
+
+        void apply_steering(const SteeringOutputHandle& handle, const Event_NextTick& event, glm::vec2& position, float& heading, glm::vec2& linear_velocity, float& angular_velocity)
+        {
+            //todo: pass in event to handle, and update duration if event.seconds_per_tick has changed
+            // or using entt signal to do that
+
+            if (handle.b_is_dynamic)
+            {
+                // the a*t^2/2 term of an acceleration; velocity handles are already covered by integrate()
+                float half_t_sqr = 0.5 * event.seconds_per_tick * event.seconds_per_tick;
+
+                position += handle.steering_output.linear * half_t_sqr;
+                heading += handle.steering_output.heading_delta * half_t_sqr;
+            }
+
+            if (handle.b_wander)
+            {
+                const float _rand = SketchBook::World::Random::binom(1, 0.5);
+                heading *= _rand * std::clamp(handle.steering_output.heading_delta / 180, -1.0f, 1.0f);
+            }
+
+            if (handle.b_is_dynamic)
+            {
+                linear_velocity += handle.steering_output.linear * event.seconds_per_tick;
+                angular_velocity += handle.steering_output.heading_delta * event.seconds_per_tick;
+            }
+        }
+
+        void sort_steering(std::vector<SteeringOutputHandle>& steering, const double current_tick)
+        {
+            std::sort(steering.begin(), steering.end(), [&](const SteeringOutputHandle&h1, const SteeringOutputHandle& h2){
+                return h1.duration.time_left(current_tick) < h2.duration.time_left(current_tick);
+            });
+        }
+
+        void expire_steering(std::vector<SteeringOutputHandle>& steering, const Event_NextTick& event, glm::vec2& linear_velocity, float& angular_velocity)
+        {
+            steering.erase(std::remove_if(steering.begin(), steering.end(), [&](const SteeringOutputHandle& h){
+                const bool b_remove = h.duration.time_left(event.tick_count) <= 0;
+                if (b_remove)
+                {
+                    remove_steering(h, event, linear_velocity, angular_velocity);
+                }
+                return b_remove;
+            }), steering.end());
+        }
+
+        void integrate(const Event_NextTick& event, const glm::vec2& velocity, const float angular_velocity, glm::vec2& position, float& heading)
+        {
+            position += velocity * event.seconds_per_tick;
+            heading += angular_velocity * event.seconds_per_tick;
+        }
+    }
+
     KinematicObject::KinematicObject(const float x, const float y)
         : m_position{x, y}
     {
@@ -53,7 +154,9 @@ namespace World
 
     const glm::vec2 KinematicObject::velocity_meter_per_second() const 
     { 
-        return m_linear_velocity; 
+        glm::vec2 velocity = m_linear_velocity;
+        Motion::clamp_speed(velocity, m_max_speed);
+        return velocity; 
     }
 
     const float KinematicObject::orientation_radians() const 
@@ -73,20 +176,40 @@ namespace World
 
     void KinematicObject::set_heading(const float heading)
     {
-        float h = fmod(heading, 360);
-        if (h > 180) h -= 360;
-        if (h < -180) h += 360;
-        m_heading = h;
+        m_heading = Motion::wrap_heading(heading);
+    }
+
+    void KinematicObject::set_radius(const float radius)
+    {
+        m_radius = std::max(radius, 0.f);
+    }
+
+    void KinematicObject::set_avoidance_velocity(const glm::vec2& velocity)
+    {
+        m_avoidance_velocity = velocity;
+        b_has_avoidance_velocity = true;
     }
 
     void KinematicObject::update(const Event_NextTick& event)
     {
-        update_steering(event);
+        steer(event);
+        integrate(event);
+    }
+
+    void KinematicObject::steer(const Event_NextTick& event)
+    {
+        Motion::expire_steering(current_steering, event, m_linear_velocity, m_angular_velocity);
         for (SteeringOutputHandle& h : current_steering)
-            apply_steering_output(h, event);
+            Motion::apply_steering(h, event, m_position, m_heading, m_linear_velocity, m_angular_velocity);
+    }
 
-        m_position += m_linear_velocity * event.seconds_per_tick;
-        m_heading += m_angular_velocity * event.seconds_per_tick;
+    void KinematicObject::integrate(const Event_NextTick& event)
+    {
+        // m_linear_velocity stays the unclamped steering sum so expiring handles can still be subtracted from it
+        m_effective_velocity = (b_has_avoidance_velocity) ? m_avoidance_velocity : velocity_meter_per_second();
+        b_has_avoidance_velocity = false;
+
+        Motion::integrate(event, m_effective_velocity, m_angular_velocity, m_position, m_heading);
     }
 
     glm::vec3 KinematicObject::get_position_in_render_space() 
@@ -96,8 +219,7 @@ namespace World
 
     void KinematicObject::update_heading(glm::vec2 velocity)
     {
-        const float new_orientation = atan2(-velocity.x, velocity.y);
-        set_heading(glm::degrees(new_orientation)-90);
+        m_heading = Motion::heading_from_velocity(velocity);
     }
 
     void KinematicObject::update_heading(const float& heading_delta)
@@ -107,94 +229,17 @@ namespace World
 
     void KinematicObject::add_steering(SteeringOutputHandle& handle, const double& in_current_tick) 
     {
-        if (handle.b_is_dynamic)
-        {
-        }
-        else
-        {
-            m_linear_velocity += handle.steering_output.linear;
-            m_angular_velocity += handle.steering_output.heading_delta;
-            max_linear_velocity_guard(m_linear_velocity);
-        }
-        
+        Motion::add_steering(handle, m_linear_velocity, m_angular_velocity);
         current_steering.push_back(handle);
-        sort_steering(in_current_tick);
-    }
-
-    void KinematicObject::apply_steering_output(const SteeringOutputHandle& handle, const Event_NextTick& event)
-    {
-        //todo: pass in event to handle, and update duration if event.seconds_per_tick has changed
-        // or using entt signal to do that
-
-        float half_t_sqr = 0.5 * event.seconds_per_tick * event.seconds_per_tick;
-
-        m_position += handle.steering_output.linear * half_t_sqr;
-        m_heading += handle.steering_output.heading_delta * half_t_sqr;
-
-        if (handle.b_wander)
-        {
-            const float _rand = SketchBook::World::Random::binom(1, 0.5);
-            m_heading *= _rand * std::clamp(handle.steering_output.heading_delta / 180, -1.0f, 1.0f);
-        }
-
-        if (handle.b_is_dynamic)
-        {
-            m_linear_velocity += handle.steering_output.linear * event.seconds_per_tick;
-            m_angular_velocity += handle.steering_output.heading_delta * event.seconds_per_tick;
-        }
+        Motion::sort_steering(current_steering, in_current_tick);
     }
 
     void KinematicObject::halt()
     {
         m_linear_velocity = glm::vec2(0.f);
         m_angular_velocity = 0.f;
+        b_has_avoidance_velocity = false;
     }
 
-    void KinematicObject::max_linear_velocity_guard(glm::vec2& velo)
-    {
-        if (glm::length(velo) > m_max_speed)
-        {
-            velo = glm::normalize(velo);
-            velo *= m_max_speed;
-        }
-    }
-
-    void KinematicObject::sort_steering(const double& in_current_tick)
-    {
-        std::sort(current_steering.begin(), current_steering.end(), [&](const SteeringOutputHandle&h1, const SteeringOutputHandle& h2){
-            return h1.duration.time_left(in_current_tick) < h2.duration.time_left(in_current_tick);
-        });
-    }
-
-    void KinematicObject::update_steering(const Event_NextTick& event)
-    {
-        current_steering.erase(std::remove_if(current_steering.begin(), current_steering.end(), [&, this](const SteeringOutputHandle& h){
-            const bool b_remove = h.duration.time_left(event.tick_count) <= 0;
-            if (b_remove)
-            {
-                remove_steering(h, event);
-            }
-            return b_remove;
-        }), current_steering.end());
-    }
-
-    void KinematicObject::remove_steering(const SteeringOutputHandle& handle, const Event_NextTick& event)
-    {
-        if (handle.b_is_dynamic)
-        {
-            const float total_ticks = static_cast<float>(handle.duration.active_until);
-            const glm::vec2 velo_delta = total_ticks * handle.steering_output.linear * event.seconds_per_tick;
-            m_linear_velocity -= velo_delta;
-        }
-        else
-        {
-            m_linear_velocity -= handle.steering_output.linear;
-            m_angular_velocity -= handle.steering_output.heading_delta;
-        }
-    }
-        
-        
-
-
 }
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "world/sk_world.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SketchBook
+{
+namespace View
+{
+    void World2dModel::load(std::vector<WorldObject> in_objects)
+    {
+        objects.clear();
+        objects.reserve(in_objects.size());
+
+        // later copies of an id replace earlier ones, so only the survivors go into the tree
+        for (WorldObject& object : in_objects)
+        {
+            object.reset_slack(slack_margin);
+            objects[object.id] = object;
+        }
+
+        std::vector<IndexValue> values;
+        values.reserve(objects.size());
+        for (const auto& [id, object] : objects)
+        {
+            values.emplace_back(object.slack_box(), id);
+        }
+
+        // the range constructor packs the tree (STR) instead of inserting one by one
+        rtree = RTree(values.begin(), values.end());
+    }
+
+    bool World2dModel::insert(const WorldObject& object)
+    {
+        auto [it, b_inserted] = objects.emplace(object.id, object);
+        if (!b_inserted) return false;
+
+        it->second.reset_slack(slack_margin);
+        rtree.insert(IndexValue{it->second.slack_box(), object.id});
+        return true;
+    }
+
+    bool World2dModel::remove(const int id)
+    {
+        auto it = objects.find(id);
+        if (it == objects.end()) return false;
+
+        rtree.remove(IndexValue{it->second.slack_box(), id});
+        objects.erase(it);
+        return true;
+    }
+
+    bool World2dModel::move_object(const int id, const glm::vec3& delta)
+    {
+        auto it = objects.find(id);
+        if (it == objects.end()) return false;
+
+        WorldObject& object = it->second;
+        const WorldBox indexed = object.slack_box();
+        if (!object.update_position(delta)) return false;
+
+        rtree.remove(IndexValue{indexed, id});
+        object.reset_slack(slack_margin);
+        rtree.insert(IndexValue{object.slack_box(), id});
+        return true;
+    }
+
+    WorldObject* World2dModel::get_object(const int id)
+    {
+        auto it = objects.find(id);
+        return (it == objects.end()) ? nullptr : &it->second;
+    }
+
+    const WorldObject* World2dModel::get_object(const int id) const
+    {
+        auto it = objects.find(id);
+        return (it == objects.end()) ? nullptr : &it->second;
+    }
+
+    size_t World2dModel::query_box(const WorldBox& box, int* out_ids, const size_t capacity) const
+    {
+        size_t count = 0;
+        for_each_in_box(box, [&](const WorldObject& object) {
+            if (count < capacity) out_ids[count] = object.id;
+            ++count;
+        });
+        return count;
+    }
+
+    size_t World2dModel::query_point(const WorldPoint& point, int* out_ids, const size_t capacity) const
+    {
+        return query_box(WorldBox{point, point}, out_ids, capacity);
+    }
+
+    size_t World2dModel::query_nearest(const WorldPoint& point, const size_t k, int* out_ids, const size_t capacity) const
+    {
+        const size_t wanted = std::min({k, MAX_NEAREST, objects.size()});
+        if (wanted == 0 || rtree.empty()) return 0;
+
+        struct Candidate { float distance_sq; int id; };
+        Candidate best[MAX_NEAREST];
+
+        const glm::vec3 center{point.x, point.y, point.h};
+        WorldBox bounds;
+        bg::convert(rtree.bounds(), bounds);
+        const glm::vec3 bounds_min{bounds.minCorner.x, bounds.minCorner.y, bounds.minCorner.h};
+        const glm::vec3 bounds_max{bounds.maxCorner.x, bounds.maxCorner.y, bounds.maxCorner.h};
+
+        // start from the average spacing and grow the window until the k-th hit is inside it
+        const float spacing = glm::length(bounds_max - bounds_min) / std::sqrt(static_cast<float>(objects.size()));
+        float radius = std::max(spacing, slack_margin) * 0.5f + 1e-3f;
+
+        while (true)
+        {
+            size_t found = 0;
+            for_each_in_radius(center, radius, [&](const WorldObject& object) {
+                const float distance = distance_sq(center, object);
+                if (found == wanted && distance >= best[found - 1].distance_sq) return;
+
+                size_t slot = (found < wanted) ? found++ : found - 1;
+                while (slot > 0 && best[slot - 1].distance_sq > distance)
+                {
+                    best[slot] = best[slot - 1];
+                    --slot;
+                }
+                best[slot] = Candidate{distance, object.id};
+            });
+
+            const bool b_covers_all = center.x - radius <= bounds_min.x && center.y - radius <= bounds_min.y && center.z - radius <= bounds_min.z
+                && center.x + radius >= bounds_max.x && center.y + radius >= bounds_max.y && center.z + radius >= bounds_max.z;
+
+            // anything closer than radius is inside the window, so a full window is exact
+            if (found == wanted || b_covers_all)
+            {
+                for (size_t i = 0; i < found && i < capacity; i++)
+                {
+                    out_ids[i] = best[i].id;
+                }
+                return found;
+            }
+            radius *= 2.f;
+        }
+    }
+
+    float World2dModel::distance_sq(const glm::vec3& point, const WorldObject& object)
+    {
+        const glm::vec3 closest = glm::clamp(point, object.min_corner, object.max_corner);
+        const glm::vec3 offset = point - closest;
+        return glm::dot(offset, offset);
+    }
+}
+}
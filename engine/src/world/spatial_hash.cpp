@@ -0,0 +1,80 @@
+#include "world/spatial_hash.h"
+
+namespace SketchBook
+{
+namespace World
+{
+    void SpatialHashGrid::build(const glm::vec2* positions, const size_t count)
+    {
+        m_items.resize(count);
+        m_positions.resize(count);
+        m_item_cell.resize(count);
+
+        if (count == 0)
+        {
+            m_cells_x = 0;
+            m_cells_y = 0;
+            m_cell_start.assign(1, 0);
+            return;
+        }
+
+        glm::vec2 min_corner = positions[0];
+        glm::vec2 max_corner = positions[0];
+        for (size_t i = 1; i < count; i++)
+        {
+            min_corner = glm::min(min_corner, positions[i]);
+            max_corner = glm::max(max_corner, positions[i]);
+        }
+
+        // keep the table proportional to the item count; sparse worlds get coarser cells
+        const glm::vec2 extent = max_corner - min_corner;
+        const double max_cells = std::max<double>(4.0 * static_cast<double>(count), 1024.0);
+        float cell_size = m_cell_size;
+        const double wanted_cells = (std::floor(extent.x / cell_size) + 1.0) * (std::floor(extent.y / cell_size) + 1.0);
+        if (wanted_cells > max_cells)
+        {
+            cell_size *= static_cast<float>(std::sqrt(wanted_cells / max_cells)) * 1.01f;
+        }
+
+        m_effective_cell_size = cell_size;
+        m_inv_cell_size = 1.f / cell_size;
+        m_origin = min_corner;
+        m_cells_x = static_cast<int>(extent.x * m_inv_cell_size) + 1;
+        m_cells_y = static_cast<int>(extent.y * m_inv_cell_size) + 1;
+
+        const size_t cell_count = static_cast<size_t>(m_cells_x) * static_cast<size_t>(m_cells_y);
+        m_cell_start.assign(cell_count + 1, 0);
+
+        // counting sort: histogram, exclusive prefix sum, scatter
+        for (size_t i = 0; i < count; i++)
+        {
+            const int cx = std::min(static_cast<int>((positions[i].x - m_origin.x) * m_inv_cell_size), m_cells_x - 1);
+            const int cy = std::min(static_cast<int>((positions[i].y - m_origin.y) * m_inv_cell_size), m_cells_y - 1);
+            const uint32_t cell = static_cast<uint32_t>(cy * m_cells_x + cx);
+            m_item_cell[i] = cell;
+            m_cell_start[cell + 1]++;
+        }
+
+        for (size_t c = 0; c < cell_count; c++)
+        {
+            m_cell_start[c + 1] += m_cell_start[c];
+        }
+
+        // m_cell_start doubles as the per-cell write cursor during the scatter
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint32_t cell = m_item_cell[i];
+            const uint32_t slot = m_cell_start[cell]++;
+            m_items[slot] = static_cast<uint32_t>(i);
+            m_positions[slot] = positions[i];
+        }
+
+        // the scatter advanced every start to the next cell's start; shift back by one
+        for (size_t c = cell_count; c > 0; c--)
+        {
+            m_cell_start[c] = m_cell_start[c - 1];
+        }
+        m_cell_start[0] = 0;
+    }
+}
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "async_loader.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+    using namespace SketchBook::IO;
+
+    TEST(AsyncLoaderTests, DecodesOnThePoolAndFinishesInPump)
+    {
+        Threading::ThreadPool pool(2);
+        AsyncLoader loader(pool);
+
+        const std::thread::id caller = std::this_thread::get_id();
+        std::thread::id decode_thread;
+        std::thread::id finish_thread;
+        int finished_value = 0;
+
+        LoadTicket ticket = loader.load<std::string>(
+            [&](std::string& text) { decode_thread = std::this_thread::get_id(); text = "42"; return true; },
+            [&](std::string& text) { finish_thread = std::this_thread::get_id(); finished_value = std::stoi(text); return true; });
+
+        loader.wait_decoded();
+        EXPECT_TRUE(ticket.is_pending());
+        EXPECT_TRUE(loader.has_decoded());
+        EXPECT_EQ(finished_value, 0);
+
+        EXPECT_EQ(loader.pump(), 1u);
+        EXPECT_TRUE(ticket.is_ready());
+        EXPECT_EQ(finished_value, 42);
+        EXPECT_NE(decode_thread, caller);
+        EXPECT_EQ(finish_thread, caller);
+        EXPECT_EQ(loader.pending(), 0u);
+    }
+
+    TEST(AsyncLoaderTests, FailedStagesFailTheLoad)
+    {
+        Threading::ThreadPool pool(2);
+        AsyncLoader loader(pool);
+        std::atomic<int> finishes{0};
+
+        LoadTicket bad_decode = loader.load<int>(
+            [](int&) { return false; },
+            [&](int&) { ++finishes; return true; });
+        LoadTicket bad_finish = loader.load<int>(
+            [](int&) { return true; },
+            [&](int&) { ++finishes; return false; });
+        LoadTicket throws = loader.load<int>(
+            [](int&) -> bool { throw std::runtime_error("corrupt file"); },
+            [&](int&) { ++finishes; return true; });
+
+        loader.finish_all();
+        EXPECT_TRUE(bad_decode.is_failed());
+        EXPECT_TRUE(bad_finish.is_failed());
+        EXPECT_TRUE(throws.is_failed());
+        EXPECT_EQ(finishes.load(), 1);
+        EXPECT_TRUE(LoadTicket{}.is_failed());
+    }
+
+    TEST(AsyncLoaderTests, PumpRespectsTheBudget)
+    {
+        Threading::ThreadPool pool(2);
+        AsyncLoader loader(pool);
+
+        std::vector<LoadTicket> tickets;
+        for (int i = 0; i < 10; i++)
+        {
+            tickets.push_back(loader.load<int>([i](int& value) { value = i; return true; }, [](int&) { return true; }));
+        }
+
+        loader.wait_decoded();
+        EXPECT_EQ(loader.pump(3), 3u);
+        EXPECT_EQ(loader.pending(), 7u);
+        EXPECT_EQ(loader.pump(), 7u);
+
+        for (const LoadTicket& ticket : tickets)
+        {
+            EXPECT_TRUE(ticket.is_ready());
+        }
+    }
+
+    TEST(AsyncLoaderTests, CancelFailsUnfinishedLoads)
+    {
+        Threading::ThreadPool pool(2);
+        bool b_finished = false;
+        LoadTicket ticket;
+        {
+            AsyncLoader loader(pool);
+            ticket = loader.load<int>([](int&) { return true; }, [&](int&) { b_finished = true; return true; });
+        }
+        EXPECT_TRUE(ticket.is_failed());
+        EXPECT_FALSE(b_finished);
+    }
+
+    TEST(AsyncLoaderTests, DecodesInlineWithoutWorkers)
+    {
+        Threading::ThreadPool pool(0);
+        AsyncLoader loader(pool);
+
+        LoadTicket ticket = loader.load<int>([](int& value) { value = 7; return true; }, [](int& value) { return value == 7; });
+        EXPECT_TRUE(loader.has_decoded());
+        loader.pump();
+        EXPECT_TRUE(ticket.is_ready());
+    }
+}
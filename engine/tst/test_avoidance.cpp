@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include "world/avoidance.h"
+#include "world/spatial_hash.h"
+#include <algorithm>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World;
+
+    TEST(SpatialHashGridTests, RadiusQueryMatchesBruteForce)
+    {
+        std::vector<glm::vec2> positions;
+        for (int i = 0; i < 500; i++)
+        {
+            positions.push_back({static_cast<float>((i * 37) % 101), static_cast<float>((i * 53) % 89)});
+        }
+
+        SpatialHashGrid grid(3.f);
+        grid.build(positions);
+
+        const glm::vec2 center{40.f, 40.f};
+        const float radius = 9.f;
+
+        std::vector<uint32_t> found;
+        grid.for_each_in_radius(center, radius, [&](const uint32_t item, const glm::vec2&) { found.push_back(item); });
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < positions.size(); i++)
+        {
+            if (glm::distance(positions[i], center) <= radius) expected.push_back(i);
+        }
+
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+
+    TEST(SpatialHashGridTests, QueriesOutsideGridFindNothing)
+    {
+        std::vector<glm::vec2> positions;
+        for (int y = 0; y < 10; y++)
+        {
+            for (int x = 0; x < 10; x++)
+            {
+                positions.push_back({static_cast<float>(x), static_cast<float>(y)});
+            }
+        }
+
+        SpatialHashGrid grid(1.f);
+        grid.build(positions);
+
+        size_t found = 0;
+        const auto count = [&](const uint32_t, const glm::vec2&) { found++; };
+        grid.for_each_in_radius({1000.f, 5.f}, 2.f, count);
+        grid.for_each_in_radius({5.f, 1000.f}, 2.f, count);
+        grid.for_each_in_radius({-1000.f, -1000.f}, 2.f, count);
+        grid.for_each_in_box({20.f, 20.f}, {30.f, 30.f}, count);
+        grid.for_each_in_box({-30.f, 2.f}, {-20.f, 4.f}, count);
+        EXPECT_EQ(found, 0u);
+
+        // a box straddling the edge still sees the items inside
+        grid.for_each_in_box({8.5f, 8.5f}, {30.f, 30.f}, count);
+        EXPECT_EQ(found, 1u);
+    }
+
+    TEST(CrowdAvoidanceTests, HeadOnAgentsDoNotOverlap)
+    {
+        SketchBook::Threading::ThreadPool pool(2);
+        Avoidance::CrowdAvoidance avoidance({}, pool);
+
+        KinematicObject a(-5.f, 0.f);
+        KinematicObject b(5.f, 0.2f); // exact symmetry is a known ORCA deadlock
+        a.set_max_speed(2.f);
+        b.set_max_speed(2.f);
+
+        SteeringOutputHandle go_right(1.f, 0.f, 0.f, 0.0, 1000.0);
+        SteeringOutputHandle go_left(-1.f, 0.f, 0.f, 0.0, 1000.0);
+        a.add_steering(go_right, 0.0);
+        b.add_steering(go_left, 0.0);
+
+        std::vector<KinematicObject*> agents{&a, &b};
+        float closest = 100.f;
+        for (int tick = 0; tick < 200; tick++)
+        {
+            avoidance.update(agents, Event_NextTick{static_cast<double>(tick), 0.05f});
+            closest = std::min(closest, glm::distance(a.get_position(), b.get_position()));
+        }
+
+        EXPECT_GE(closest, a.get_radius() + b.get_radius() - 0.05f);
+        // they pass each other instead of stalling
+        EXPECT_GT(a.get_position().x, b.get_position().x);
+    }
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "world/batch_queries.h"
+#include <algorithm>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World;
+
+    static std::vector<glm::vec2> make_positions(const int count, const int seed)
+    {
+        std::vector<glm::vec2> positions;
+        for (int i = 0; i < count; i++)
+        {
+            positions.push_back({static_cast<float>((i * 37 + seed) % 101), static_cast<float>((i * 53 + seed * 7) % 89)});
+        }
+        return positions;
+    }
+
+    // query points beyond the grid on every side, some just past the edge and some far away
+    static void add_outside_points(std::vector<glm::vec2>& points)
+    {
+        points.insert(points.end(), {
+            {-2.f, 40.f}, {102.f, 40.f}, {50.f, -2.f}, {50.f, 90.f},
+            {1000.f, 5.f}, {5.f, 1000.f}, {-1000.f, -1000.f}, {1e6f, 1e6f},
+        });
+    }
+
+    TEST(BatchQueryTests, RadiusMatchesSingleQueries)
+    {
+        const std::vector<glm::vec2> positions = make_positions(2000, 0);
+        std::vector<glm::vec2> queries = make_positions(700, 13);
+        add_outside_points(queries);
+
+        SpatialHashGrid grid(4.f);
+        grid.build(positions);
+
+        SketchBook::Threading::ThreadPool pool(2);
+        BatchQuery batch(pool, 64);
+        BatchQueryResults results;
+        batch.radius(grid, queries, 4.f, results);
+
+        ASSERT_EQ(results.query_count(), queries.size());
+        for (size_t q = 0; q < queries.size(); q++)
+        {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < positions.size(); i++)
+            {
+                if (glm::distance(positions[i], queries[q]) <= 4.f) expected.push_back(i);
+            }
+
+            std::vector<uint32_t> found(results.begin(q), results.end(q));
+            std::sort(found.begin(), found.end());
+            EXPECT_EQ(found, expected);
+        }
+    }
+
+    TEST(BatchQueryTests, NearestAgreesAcrossIndices)
+    {
+        const std::vector<glm::vec2> positions = make_positions(500, 3);
+        std::vector<glm::vec2> queries = make_positions(100, 29);
+        add_outside_points(queries);
+
+        SpatialHashGrid grid(3.f);
+        grid.build(positions);
+
+        // zero-size objects so the r-tree ranks by the same point distances as the grid
+        std::vector<SketchBook::View::WorldObject> objects(positions.size());
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            objects[i].id = static_cast<int>(i);
+            objects[i].position = objects[i].min_corner = objects[i].max_corner = glm::vec3(positions[i].x, positions[i].y, 0.f);
+        }
+        SketchBook::View::World2dModel model;
+        model.load(objects);
+
+        BatchQuery batch;
+        BatchQueryResults from_grid;
+        BatchQueryResults from_model;
+        batch.nearest(grid, queries, 4, from_grid);
+        batch.nearest(model, queries, 4, from_model);
+
+        for (size_t q = 0; q < queries.size(); q++)
+        {
+            ASSERT_EQ(from_grid.count(q), 4u);
+            ASSERT_EQ(from_model.count(q), 4u);
+            for (size_t i = 0; i < 4; i++)
+            {
+                // ties may come back in either order, distances must not
+                EXPECT_FLOAT_EQ(glm::distance(positions[from_grid.begin(q)[i]], queries[q]), glm::distance(positions[from_model.begin(q)[i]], queries[q]));
+            }
+        }
+    }
+}
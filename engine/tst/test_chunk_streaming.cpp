@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "world/chunk_streaming.h"
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World::Streaming;
+
+    static std::string make_chunk_directory()
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sk_chunk_streaming_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        for (int y = -3; y <= 3; y++)
+        {
+            for (int x = -3; x <= 3; x++)
+            {
+                const ChunkCoord coord{x, y};
+                std::vector<ChunkObjectRecord> objects(4);
+                for (int i = 0; i < 4; i++)
+                {
+                    objects[i] = ChunkObjectRecord{x * 100 + y * 10 + i, 0, {x * 16.f + i, y * 16.f, 0.f}, {}, {}};
+                }
+                std::vector<float> heights(8 * 8, static_cast<float>(x + y));
+                EXPECT_TRUE(write_chunk((directory / chunk_file_name(coord)).string(), coord, objects, heights, 8));
+            }
+        }
+        return directory.string();
+    }
+
+    TEST(ChunkStreamingTests, LoadsAroundFocusAndEvictsByLru)
+    {
+        const std::string directory = make_chunk_directory();
+        SketchBook::Threading::ThreadPool pool(2);
+
+        ChunkStreamingParams params;
+        params.chunk_size = 16.f;
+        params.load_radius = 1;
+        params.max_loads_in_flight = 64;
+        params.memory_budget = 12 * (sizeof(ChunkData) + sizeof(ChunkHeader) + 4 * sizeof(ChunkObjectRecord) + 64 * sizeof(float));
+
+        ChunkStreamer streamer(directory, params, pool);
+        size_t loaded = 0;
+        size_t evicted = 0;
+        streamer.on_chunk_loaded = [&](const std::shared_ptr<const ChunkData>&) { ++loaded; };
+        streamer.on_chunk_evicted = [&](const std::shared_ptr<const ChunkData>&) { ++evicted; };
+
+        streamer.update({ChunkStreamer::camera_focus({8.f, 50.f, 8.f})});
+        streamer.flush();
+        EXPECT_EQ(streamer.resident_count(), 9u);
+        EXPECT_EQ(loaded, 9u);
+
+        auto origin = streamer.acquire({0, 0});
+        ASSERT_NE(origin, nullptr);
+        ASSERT_EQ(origin->object_count(), 4u);
+        EXPECT_EQ(origin->objects[2].id, 2);
+        EXPECT_EQ(origin->terrain_resolution(), 8u);
+        EXPECT_FLOAT_EQ(origin->heights[63], 0.f);
+
+        // walk two chunks east: 3 chunks are shared, the west column goes once over budget
+        streamer.update({{40.f, 8.f}});
+        streamer.flush();
+        streamer.update({{40.f, 8.f}});
+        EXPECT_TRUE(streamer.is_resident({2, 0}));
+        EXPECT_TRUE(streamer.is_resident({3, 1}));
+        EXPECT_LE(streamer.resident_bytes(), params.memory_budget);
+        EXPECT_GT(evicted, 0u);
+        EXPECT_FALSE(streamer.is_resident({-1, 0}));
+
+        // evicted data stays readable while it is held
+        EXPECT_EQ(origin->objects[3].id, 3);
+
+        // chunks with no file are empty, not errors
+        streamer.update({{1000.f, 1000.f}});
+        streamer.flush();
+        auto empty = streamer.acquire(streamer.chunk_at({1000.f, 1000.f}));
+        ASSERT_NE(empty, nullptr);
+        EXPECT_TRUE(empty->is_empty());
+
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST(ChunkStreamingTests, RejectsHeaderOffsetsThatWrap)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "sk_chunk_wrap_test.chunk").string();
+        const ChunkCoord coord{1, 2};
+        std::vector<ChunkObjectRecord> objects(4);
+        std::vector<float> heights(4 * 4, 1.f);
+        ASSERT_TRUE(write_chunk(path, coord, objects, heights, 4));
+        ASSERT_FALSE(load_chunk(path, coord)->is_empty());
+
+        // offset + count * stride wraps around to a small, in-bounds value
+        std::vector<uint8_t> bytes;
+        {
+            SketchBook::IO::MappedFile file(path);
+            ASSERT_TRUE(file.is_valid());
+            bytes.assign(file.data(), file.data() + file.size());
+        }
+        ChunkHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        header.objects_offset = 0ull - header.object_count * sizeof(ChunkObjectRecord) + sizeof(ChunkHeader);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        ASSERT_TRUE(SketchBook::IO::write_file(path, bytes.data(), bytes.size()));
+
+        EXPECT_TRUE(load_chunk(path, coord)->is_empty());
+        std::filesystem::remove(path);
+    }
+}
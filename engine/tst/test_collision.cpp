@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include "world/collision.h"
+#include <algorithm>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World;
+
+    TEST(CollisionTests, BroadphaseFindsAllTouchingPairs)
+    {
+        SketchBook::Threading::ThreadPool pool(2);
+        Collision::CollisionWorld world(4.f, pool);
+
+        std::vector<glm::vec2> centers;
+        for (int i = 0; i < 3000; i++)
+        {
+            centers.push_back({static_cast<float>((i * 37) % 211) * 0.5f, static_cast<float>((i * 53) % 197) * 0.5f});
+            world.add_circle(centers.back(), 0.4f);
+        }
+
+        // two steps so the second one runs on the persisted order
+        world.step();
+        for (uint32_t i = 0; i < centers.size(); i += 3)
+        {
+            centers[i] += glm::vec2(0.3f, -0.2f);
+            world.set_center(i, centers[i]);
+        }
+        world.step();
+
+        std::vector<std::pair<uint32_t, uint32_t>> expected;
+        for (uint32_t a = 0; a < centers.size(); a++)
+        {
+            for (uint32_t b = a + 1; b < centers.size(); b++)
+            {
+                if (glm::distance(centers[a], centers[b]) < 0.8f) expected.push_back({a, b});
+            }
+        }
+
+        ASSERT_FALSE(expected.empty());
+
+        std::vector<std::pair<uint32_t, uint32_t>> found;
+        for (const CollisionContact& contact : world.contacts())
+        {
+            found.push_back({contact.body_a, contact.body_b});
+            EXPECT_NEAR(contact.depth, 0.8f - glm::distance(centers[contact.body_a], centers[contact.body_b]), 1e-4f);
+        }
+        EXPECT_EQ(found, expected);
+    }
+
+    TEST(CollisionTests, InlinePoolDoesNotReuseStaleChunks)
+    {
+        // no workers: every chunk runs on the caller and must fill its own buffer, as with workers
+        SketchBook::Threading::ThreadPool pool(0);
+        Collision::CollisionWorld world(4.f, pool);
+
+        // a lattice tight enough that each circle touches its four neighbors,
+        // so both the sweep and the narrowphase span several chunks
+        const int side = 100;
+        std::vector<glm::vec2> centers;
+        for (int y = 0; y < side; y++)
+        {
+            for (int x = 0; x < side; x++)
+            {
+                centers.push_back({x * 0.7f, y * 0.7f});
+                world.add_circle(centers.back(), 0.4f);
+            }
+        }
+
+        world.step();
+        EXPECT_EQ(world.contacts().size(), static_cast<size_t>(2 * side * (side - 1)));
+
+        // spread out so nothing touches; leftovers from the first step must not come back
+        for (uint32_t i = 0; i < centers.size(); i++)
+        {
+            world.set_center(i, centers[i] * 3.f);
+        }
+        world.step();
+        EXPECT_TRUE(world.contacts().empty());
+    }
+
+    TEST(CollisionTests, ObjectsReportEnterStayExit)
+    {
+        Collision::CollisionWorld world;
+
+        KinematicObject mover(0.f, 0.f);
+        const uint32_t body = world.add_object(&mover);
+        const uint32_t wall = world.add_box({2.f, 0.f}, {0.5f, 2.f});
+
+        world.step();
+        EXPECT_TRUE(world.contacts().empty());
+
+        // moving object: walk it into the wall through the kinematics
+        mover.set_max_speed(10.f);
+        SteeringOutputHandle push(5.f, 0.f, 0.f, 0.0, 1000.0);
+        mover.add_steering(push, 0.0);
+        for (int tick = 0; tick < 3; tick++) mover.update(Event_NextTick{static_cast<double>(tick), 0.1f});
+
+        world.step();
+        ASSERT_EQ(world.entered().size(), 1u);
+        const CollisionContact contact = world.entered()[0];
+        EXPECT_EQ(contact.body_a, body);
+        EXPECT_EQ(contact.body_b, wall);
+        EXPECT_GT(contact.normal.x, 0.99f);
+        EXPECT_GT(contact.depth, 0.f);
+        EXPECT_EQ(world.object(body), &mover);
+
+        world.step();
+        EXPECT_TRUE(world.entered().empty());
+        EXPECT_EQ(world.stayed().size(), 1u);
+
+        world.set_center(wall, {20.f, 0.f});
+        world.step();
+        ASSERT_EQ(world.exited().size(), 1u);
+        EXPECT_EQ(world.exited()[0].a, body);
+        EXPECT_TRUE(world.contacts().empty());
+
+        // ids are recycled only after a step, so a replacement never inherits stale proxies
+        world.remove(wall);
+        const uint32_t ball = world.add_circle(mover.get_position(), 0.5f);
+        EXPECT_NE(ball, wall);
+        world.step();
+        ASSERT_EQ(world.contacts().size(), 1u);
+        EXPECT_EQ(world.contacts()[0].body_b, ball);
+    }
+}
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "command_buffer.h"
+#include <algorithm>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+
+    struct Spawned
+    {
+        uint32_t source;
+    };
+
+    struct Dead {};
+
+    static std::vector<std::pair<entt::entity, uint32_t>> spawn_in_parallel(Threading::ThreadPool& pool)
+    {
+        entt::registry registry;
+        std::vector<entt::entity> parents(1000);
+        registry.create(parents.begin(), parents.end());
+
+        CommandBuffers commands(pool);
+        pool.parallel_for(0, parents.size(), 16, [&](const size_t first, const size_t last) {
+            EntityCommandBuffer& buffer = commands.local();
+            for (size_t i = first; i < last; i++)
+            {
+                buffer.set_order(i);
+                if (i % 2 == 0)
+                {
+                    const PendingEntity child = buffer.create();
+                    buffer.emplace<Spawned>(child, static_cast<uint32_t>(i));
+                }
+                if (i % 5 == 0) buffer.emplace<Dead>(parents[i]);
+                if (i % 10 == 0) buffer.destroy(parents[i]);
+            }
+        });
+        EXPECT_EQ(registry.view<Spawned>().size(), 0u);
+
+        commands.playback(registry);
+        EXPECT_EQ(commands.size(), 0u);
+
+        for (size_t i = 0; i < parents.size(); i++)
+        {
+            EXPECT_EQ(registry.valid(parents[i]), i % 10 != 0);
+            if (i % 10 != 0) EXPECT_EQ(registry.all_of<Dead>(parents[i]), i % 5 == 0);
+        }
+
+        std::vector<std::pair<entt::entity, uint32_t>> spawned;
+        registry.view<Spawned>().each([&](const entt::entity entity, const Spawned& s) { spawned.emplace_back(entity, s.source); });
+        std::sort(spawned.begin(), spawned.end());
+        return spawned;
+    }
+
+    TEST(CommandBufferTests, ParallelRecordingPlaysBackDeterministically)
+    {
+        Threading::ThreadPool pool(3);
+        const auto first = spawn_in_parallel(pool);
+        const auto second = spawn_in_parallel(pool);
+
+        ASSERT_EQ(first.size(), 500u);
+        EXPECT_EQ(first, second);
+    }
+
+    TEST(CommandBufferTests, PendingEntitiesTakeComponentsAndRemovals)
+    {
+        entt::registry registry;
+        CommandBuffers commands(Threading::ThreadPool::shared());
+
+        EntityCommandBuffer& buffer = commands.local();
+        const PendingEntity a = buffer.create();
+        const PendingEntity b = buffer.create();
+        buffer.emplace<Spawned>(a, 1u);
+        buffer.emplace<Dead>(a);
+        buffer.emplace<Spawned>(b, 2u);
+        buffer.remove<Dead>(a);
+        buffer.emplace<Spawned>(b, 3u);   // replaces
+        buffer.destroy(a);
+        commands.playback(registry);
+
+        std::vector<uint32_t> values;
+        registry.view<Spawned>().each([&](const Spawned& s) { values.push_back(s.source); });
+        EXPECT_EQ(values, std::vector<uint32_t>{3u});
+        EXPECT_EQ(registry.view<Dead>().size(), 0u);
+    }
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "world/flocking.h"
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World;
+
+    TEST(FlockingTests, ComputeSeparatesAndGathers)
+    {
+        SketchBook::Threading::ThreadPool pool(2);
+        Flocking::Flock flock({}, pool);
+
+        // a crowded pair, a pair inside cohesion range, and a loner
+        Actor a(0.f, 0.f);
+        Actor b(0.5f, 0.f);
+        Actor c(20.f, 0.f);
+        Actor d(22.f, 0.f);
+        Actor loner(-50.f, -50.f);
+        const std::vector<Actor*> actors{&a, &b, &c, &d, &loner};
+
+        const std::vector<SteeringOutput>& outputs = flock.compute(actors);
+        ASSERT_EQ(outputs.size(), actors.size());
+
+        // separation wins inside separation_radius
+        EXPECT_LT(outputs[0].linear.x, 0.f);
+        EXPECT_GT(outputs[1].linear.x, 0.f);
+        // cohesion pulls the farther pair together
+        EXPECT_GT(outputs[2].linear.x, 0.f);
+        EXPECT_LT(outputs[3].linear.x, 0.f);
+        EXPECT_EQ(outputs[4].linear, glm::vec2(0.f, 0.f));
+
+        for (const SteeringOutput& output : outputs)
+        {
+            EXPECT_LE(glm::length(output.linear), flock.params().max_linear + 1e-5f);
+        }
+    }
+
+    TEST(FlockingTests, SteerKeepsClampedSpeedAndLeavesNoResidue)
+    {
+        SketchBook::Threading::ThreadPool pool(0);
+        Flocking::Flock flock({}, pool);
+
+        // close enough that every output is max_linear, above the default max speed
+        Actor a(0.f, 0.f);
+        Actor b(0.2f, 0.f);
+        const std::vector<Actor*> actors{&a, &b};
+        ASSERT_GT(flock.params().max_linear, a.get_max_speed());
+
+        int tick = 0;
+        for (; tick < 5; tick++)
+        {
+            const Event_NextTick event{static_cast<double>(tick), 0.01f};
+            flock.steer(actors, event);
+            a.update(event);
+            b.update(event);
+
+            EXPECT_NEAR(glm::length(a.effective_velocity()), a.get_max_speed(), 1e-5f);
+            EXPECT_NEAR(glm::length(b.effective_velocity()), b.get_max_speed(), 1e-5f);
+            EXPECT_EQ(a.get_current_steering().size(), 1u);
+        }
+
+        // once the flock stops steering, the last handle expires and takes all of its velocity with it
+        const Event_NextTick event{static_cast<double>(tick), 0.01f};
+        a.update(event);
+        b.update(event);
+        EXPECT_TRUE(a.get_current_steering().empty());
+        EXPECT_EQ(a.effective_velocity(), glm::vec2(0.f, 0.f));
+        EXPECT_EQ(b.effective_velocity(), glm::vec2(0.f, 0.f));
+    }
+}
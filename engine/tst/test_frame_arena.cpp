@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "frame_arena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace EngineTests
+{
+    using namespace SketchBook::Memory;
+
+    TEST(FrameArenaTests, AllocationsAreAligned)
+    {
+        FrameArena arena(256);
+        arena.allocate(1, 1);
+        void* a = arena.allocate(16, 16);
+        arena.allocate(3, 1);
+        void* b = arena.allocate(64, 64);
+
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 16, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0);
+    }
+
+    TEST(FrameArenaTests, ResetFoldsOverflowIntoOneBlock)
+    {
+        FrameArena arena(128);
+        for (int i = 0; i < 10; i++) arena.allocate(100);
+        EXPECT_GT(arena.block_count(), 1);
+        const size_t frame_bytes = arena.used();
+
+        arena.reset();
+        EXPECT_EQ(arena.block_count(), 1);
+        EXPECT_EQ(arena.used(), 0);
+        EXPECT_GE(arena.capacity(), frame_bytes);
+
+        // the same frame again fits without a new block
+        for (int i = 0; i < 10; i++) arena.allocate(100);
+        EXPECT_EQ(arena.block_count(), 1);
+    }
+
+    TEST(FrameArenaTests, FrameVectors)
+    {
+        FrameArena arena(1024);
+        FrameVector<int> values = arena.make_vector<int>();
+        for (int i = 0; i < 64; i++) values.push_back(i);
+
+        // old buffers stay behind until reset, so doubling costs under twice the final size
+        EXPECT_EQ(values.size(), 64);
+        EXPECT_EQ(values[63], 63);
+        EXPECT_LE(arena.used(), 2 * 64 * sizeof(int));
+
+        FrameVector<int> reserved = arena.make_vector<int>(32);
+        const size_t before = arena.used();
+        for (int i = 0; i < 32; i++) reserved.push_back(i);
+        EXPECT_EQ(arena.used(), before);
+    }
+
+    TEST(FrameArenaTests, SteadyStateDoesNotGrow)
+    {
+        FrameArena arena(64);
+        size_t capacity = 0;
+        for (int frame = 0; frame < 8; frame++)
+        {
+            arena.reset();
+            if (frame == 2) capacity = arena.capacity();
+
+            FrameVector<float> scratch = arena.make_vector<float>(500);
+            scratch.resize(500, 1.f);
+            FrameString label{ArenaAllocator<char>(arena)};
+            label.assign(200, 'x');
+
+            if (frame >= 2)
+            {
+                EXPECT_EQ(arena.capacity(), capacity);
+            }
+        }
+        EXPECT_EQ(arena.block_count(), 1);
+    }
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "instance_transforms.h"
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+
+    TEST(InstanceTransformsTests, DirtyRangesCoalesceAndClear)
+    {
+        DirtyRanges dirty;
+        dirty.resize(10000);
+
+        std::vector<SlotRange> ranges;
+        dirty.take_ranges(ranges);
+        ASSERT_EQ(ranges.size(), 1u);
+        EXPECT_EQ(ranges[0].first, 0u);
+        EXPECT_EQ(ranges[0].last, 10000u);
+        EXPECT_FALSE(dirty.any());
+
+        ranges.clear();
+        dirty.take_ranges(ranges);
+        EXPECT_TRUE(ranges.empty());
+
+        for (const size_t slot : {5, 6, 7, 10, 63, 64, 65, 500, 4095, 4096, 9999})
+        {
+            dirty.mark(slot);
+        }
+        dirty.take_ranges(ranges, 2); // 8 and 9 are a gap of two, so 5-7 and 10 merge
+        const std::vector<std::pair<uint32_t, uint32_t>> expected{{5, 11}, {63, 66}, {500, 501}, {4095, 4097}, {9999, 10000}};
+        ASSERT_EQ(ranges.size(), expected.size());
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            EXPECT_EQ(ranges[i].first, expected[i].first);
+            EXPECT_EQ(ranges[i].last, expected[i].second);
+        }
+
+        ranges.clear();
+        dirty.mark(7);
+        dirty.mark(11);
+        dirty.take_ranges(ranges, 2);
+        ASSERT_EQ(ranges.size(), 2u);
+        EXPECT_EQ(ranges[0].last, 8u);
+        EXPECT_EQ(ranges[1].first, 11u);
+    }
+
+    TEST(InstanceTransformsTests, EachFrameCatchesUpOnItsOwnChanges)
+    {
+        InstanceTransforms transforms;
+        transforms.resize(1000);
+
+        std::vector<glm::mat4> frames[2] = {std::vector<glm::mat4>(1001), std::vector<glm::mat4>(1001)};
+        EXPECT_EQ(transforms.upload(0, 2, frames[0].data(), 1001), 1001 * sizeof(glm::mat4));
+        EXPECT_EQ(transforms.upload(1, 2, frames[1].data(), 1001), 1001 * sizeof(glm::mat4));
+        EXPECT_TRUE(transforms.is_clean(0, 2));
+
+        const glm::mat4 moved(2.f);
+        transforms.set(42, moved);
+        EXPECT_EQ(transforms.upload(0, 2, frames[0].data(), 1001), sizeof(glm::mat4));
+        EXPECT_TRUE(transforms.is_clean(0, 2));
+        EXPECT_FALSE(transforms.is_clean(1, 2));
+        EXPECT_EQ(transforms.upload(1, 2, frames[1].data(), 1001), sizeof(glm::mat4));
+        EXPECT_EQ(frames[0][42], moved);
+        EXPECT_EQ(frames[1][42], moved);
+        EXPECT_EQ(frames[1][0], glm::mat4(1.f));
+    }
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "sk_io.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::IO;
+
+    TEST(IOTests, ConcurrentWritesToOneFileStayWhole)
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sk_write_file_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        const std::string path = (directory / "target.bin").string();
+
+        // each writer fills the file with its own byte; the survivor must be one writer's whole buffer
+        const size_t writer_count = 8;
+        const size_t size = 1 << 16;
+        std::vector<std::thread> writers;
+        std::vector<char> b_ok(writer_count, 0);
+        for (size_t w = 0; w < writer_count; w++)
+        {
+            writers.emplace_back([&, w]() {
+                const std::vector<uint8_t> bytes(size, static_cast<uint8_t>(w + 1));
+                bool b_all = true;
+                for (int round = 0; round < 20; round++)
+                {
+                    b_all = write_file(path, bytes.data(), bytes.size()) && b_all;
+                }
+                b_ok[w] = b_all;
+            });
+        }
+        for (std::thread& writer : writers)
+        {
+            writer.join();
+        }
+
+        for (size_t w = 0; w < writer_count; w++)
+        {
+            EXPECT_TRUE(b_ok[w]);
+        }
+
+        MappedFile file(path);
+        ASSERT_TRUE(file.is_valid());
+        ASSERT_EQ(file.size(), size);
+        const uint8_t first = file.data()[0];
+        EXPECT_GE(first, 1);
+        EXPECT_LE(first, writer_count);
+        EXPECT_EQ(std::count(file.data(), file.data() + file.size(), first), static_cast<std::ptrdiff_t>(size));
+        file.close();
+
+        // no temp files left behind
+        EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST(IOTests, RangeFitsRejectsWrappingRanges)
+    {
+        EXPECT_TRUE(range_fits(0, 4, 16, 64));
+        EXPECT_TRUE(range_fits(64, 0, 16, 64));
+        EXPECT_FALSE(range_fits(8, 4, 16, 64));
+        EXPECT_FALSE(range_fits(65, 0, 16, 64));
+
+        // offset + count * stride would wrap to 8
+        EXPECT_FALSE(range_fits(0ull - 56, 4, 16, 64));
+        EXPECT_FALSE(range_fits(0, 1ull << 62, 8, 64));
+    }
+}
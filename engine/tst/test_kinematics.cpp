@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "world/kinematics.h"
+#include <algorithm>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World;
+
+    TEST(KinematicsTests, ComponentsMoveLikeKinematicObject)
+    {
+        entt::registry registry;
+        std::vector<KinematicObject> objects;
+        std::vector<entt::entity> entities;
+
+        for (int i = 0; i < 16; i++)
+        {
+            const float x = static_cast<float>(i);
+            const float y = static_cast<float>(i % 5);
+            objects.emplace_back(x, y);
+            objects.back().set_max_speed(2.f);
+            entities.push_back(Kinematics::create(registry, x, y));
+            Kinematics::set_max_speed(registry, entities.back(), 2.f);
+        }
+
+        // a finite and a dynamic handle on every other agent, so expiry is covered too
+        for (size_t i = 0; i < objects.size(); i += 2)
+        {
+            SteeringOutputHandle push(1.f, -0.5f, 10.f, 0.0, 20.0);
+            SteeringOutputHandle accelerate(0.2f, 0.1f, 0.f, 0.0, 10.0, true, false, true);
+            objects[i].add_steering(push, 0.0);
+            objects[i].add_steering(accelerate, 0.0);
+            Kinematics::add_steering(registry, entities[i], push, 0.0);
+            Kinematics::add_steering(registry, entities[i], accelerate, 0.0);
+        }
+
+        for (int tick = 0; tick < 40; tick++)
+        {
+            const Event_NextTick event{static_cast<double>(tick), 0.05f};
+            if (tick == 7)
+            {
+                objects[3].set_avoidance_velocity({0.f, 1.f});
+                Kinematics::set_avoidance_velocity(registry, entities[3], {0.f, 1.f});
+            }
+            for (KinematicObject& object : objects)
+            {
+                object.update(event);
+            }
+            Kinematics::update(registry, event);
+        }
+
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            const glm::vec2 position = registry.get<Kinematics::Position>(entities[i]).value;
+            EXPECT_FLOAT_EQ(position.x, objects[i].get_position().x);
+            EXPECT_FLOAT_EQ(position.y, objects[i].get_position().y);
+            EXPECT_FLOAT_EQ(registry.get<Kinematics::Heading>(entities[i]).degrees, objects[i].get_heading());
+        }
+    }
+
+    TEST(KinematicsTests, CullReturnsEntitiesInsideBounds)
+    {
+        entt::registry registry;
+        std::vector<entt::entity> inside;
+        for (int i = 0; i < 10; i++)
+        {
+            const entt::entity entity = Kinematics::create(registry, static_cast<float>(i), 0.f);
+            if (i >= 2 && i <= 5) inside.push_back(entity);
+        }
+
+        std::vector<entt::entity> culled;
+        EXPECT_EQ(Kinematics::cull(registry, {2.f, -1.f}, {5.f, 1.f}, culled), inside.size());
+
+        std::sort(culled.begin(), culled.end());
+        std::sort(inside.begin(), inside.end());
+        EXPECT_EQ(culled, inside);
+
+        std::vector<glm::vec4> positions;
+        Kinematics::gather_render_positions(registry, positions);
+        EXPECT_EQ(positions.size(), 10u);
+    }
+}
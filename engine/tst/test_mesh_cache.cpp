@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "mesh_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::IO;
+
+    struct CacheVertex
+    {
+        float position[3];
+        float normal[3];
+    };
+
+    TEST(MeshCacheTests, CachePathReplacesTheExtension)
+    {
+        EXPECT_EQ(mesh_cache_path("assets/monkey_smooth.obj"), "assets/monkey_smooth.skmesh");
+        EXPECT_EQ(mesh_cache_path("assets.d/wedge"), "assets.d/wedge.skmesh");
+    }
+
+    TEST(MeshCacheTests, RoundTripAndStaleness)
+    {
+        const std::string source = "v 0 0 0\nv 1 0 0\nv 0 1 0\n";
+        const uint64_t source_hash = hash_bytes(source.data(), source.size());
+
+        std::vector<CacheVertex> vertices(5);
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            vertices[i] = CacheVertex{{float(i), float(2 * i), -float(i)}, {0.f, 1.f, 0.f}};
+        }
+        const std::vector<uint32_t> indices{0, 1, 2, 2, 3, 4};
+
+        MeshBlobs blobs;
+        blobs.vertices = vertices.data();
+        blobs.vertex_count = static_cast<uint32_t>(vertices.size());
+        blobs.vertex_stride = sizeof(CacheVertex);
+        blobs.indices = indices.data();
+        blobs.index_count = static_cast<uint32_t>(indices.size());
+        blobs.bounds_min[0] = -1.f;
+        blobs.bounds_max[1] = 8.f;
+
+        const std::string path = (std::filesystem::temp_directory_path() / "sk_mesh_cache_test.skmesh").string();
+        ASSERT_TRUE(write_mesh_cache(path, source_hash, source.size(), blobs));
+
+        {
+            MeshCacheFile cache;
+            ASSERT_TRUE(cache.open(path, source_hash, source.size(), sizeof(CacheVertex)));
+            EXPECT_EQ(cache.header().vertex_count, 5);
+            EXPECT_EQ(cache.header().index_count, 6);
+            EXPECT_EQ(cache.header().bounds_min[0], -1.f);
+            EXPECT_EQ(cache.header().bounds_max[1], 8.f);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(cache.vertex_data()) % SKMESH_ALIGNMENT, 0);
+
+            ASSERT_EQ(cache.vertex_bytes(), vertices.size() * sizeof(CacheVertex));
+            EXPECT_EQ(std::memcmp(cache.vertex_data(), vertices.data(), cache.vertex_bytes()), 0);
+            const uint32_t* cached_indices = static_cast<const uint32_t*>(cache.index_data());
+            EXPECT_EQ(std::vector<uint32_t>(cached_indices, cached_indices + cache.header().index_count), indices);
+        }
+
+        // 16-bit indices keep their width
+        const std::vector<uint16_t> short_indices{0, 1, 2, 2, 3, 4};
+        blobs.indices = short_indices.data();
+        blobs.index_size = 2;
+        ASSERT_TRUE(write_mesh_cache(path, source_hash, source.size(), blobs));
+        {
+            MeshCacheFile cache;
+            ASSERT_TRUE(cache.open(path, source_hash, source.size(), sizeof(CacheVertex)));
+            EXPECT_EQ(cache.header().index_size, 2);
+            ASSERT_EQ(cache.index_bytes(), short_indices.size() * sizeof(uint16_t));
+            EXPECT_EQ(std::memcmp(cache.index_data(), short_indices.data(), cache.index_bytes()), 0);
+        }
+
+        // an edited source, another vertex layout or a truncated file all miss
+        const std::string edited = source + "v 1 1 0\n";
+        MeshCacheFile cache;
+        EXPECT_FALSE(cache.open(path, hash_bytes(edited.data(), edited.size()), edited.size(), sizeof(CacheVertex)));
+        EXPECT_FALSE(cache.open(path, source_hash, source.size(), sizeof(CacheVertex) + 4));
+        EXPECT_FALSE(cache.is_valid());
+
+        // a vertex offset that wraps offset + bytes around to a small in-file value
+        {
+            std::vector<uint8_t> bytes;
+            {
+                MappedFile file(path);
+                ASSERT_TRUE(file.is_valid());
+                bytes.assign(file.data(), file.data() + file.size());
+            }
+            SkMeshHeader header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            header.vertex_count = 1000;
+            const uint64_t vertex_bytes = uint64_t{header.vertex_count} * header.vertex_stride;
+            header.vertex_offset = 0ull - (vertex_bytes - vertex_bytes % SKMESH_ALIGNMENT);
+            std::memcpy(bytes.data(), &header, sizeof(header));
+            ASSERT_TRUE(write_file(path, bytes.data(), bytes.size()));
+            EXPECT_FALSE(cache.open(path, source_hash, source.size(), sizeof(CacheVertex)));
+        }
+
+        std::filesystem::resize_file(path, SKMESH_ALIGNMENT + 8);
+        EXPECT_FALSE(cache.open(path, source_hash, source.size(), sizeof(CacheVertex)));
+
+        std::remove(path.c_str());
+        EXPECT_FALSE(cache.open(path, source_hash, source.size(), sizeof(CacheVertex)));
+    }
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::MeshOptimizer;
+
+    struct GridVertex
+    {
+        float position[3];
+        uint32_t id;
+    };
+
+    // n x n quads on the z = 0 plane, triangles shuffled
+    static void make_grid(const uint32_t n, std::vector<GridVertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        vertices.clear();
+        indices.clear();
+        for (uint32_t y = 0; y <= n; y++)
+        {
+            for (uint32_t x = 0; x <= n; x++)
+            {
+                vertices.push_back(GridVertex{{float(x), float(y), 0.f}, y * (n + 1) + x});
+            }
+        }
+
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (uint32_t y = 0; y < n; y++)
+        {
+            for (uint32_t x = 0; x < n; x++)
+            {
+                const uint32_t i = y * (n + 1) + x;
+                triangles.push_back({i, i + 1, i + n + 1});
+                triangles.push_back({i + 1, i + n + 2, i + n + 1});
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+        for (const auto& triangle : triangles) indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+
+    // triangles as sorted vertex id triples, so two index lists can be compared as sets
+    static std::vector<std::array<uint32_t, 3>> triangle_set(const std::vector<GridVertex>& vertices, const std::vector<uint32_t>& indices)
+    {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::array<uint32_t, 3> triangle{vertices[indices[i]].id, vertices[indices[i + 1]].id, vertices[indices[i + 2]].id};
+            // keep winding: rotate the smallest id to the front
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    TEST(MeshOptimizerTests, AnalyzeWorstAndBestCase)
+    {
+        // disjoint triangles: every vertex transformed once, 3 per triangle
+        const std::vector<uint32_t> disjoint{0, 1, 2, 3, 4, 5};
+        const VertexCacheStats worst = analyze_vertex_cache(disjoint, 6);
+        EXPECT_EQ(worst.transformed, 6);
+        EXPECT_FLOAT_EQ(worst.acmr, 3.f);
+        EXPECT_FLOAT_EQ(worst.atvr, 1.f);
+
+        const std::vector<uint32_t> shared{0, 1, 2, 2, 1, 3};
+        EXPECT_FLOAT_EQ(analyze_vertex_cache(shared, 4).acmr, 2.f);
+    }
+
+    TEST(MeshOptimizerTests, AnalyzeEmptyInputIsZero)
+    {
+        // no triangle to divide by: zeroed stats, never inf or NaN
+        for (const std::vector<uint32_t>& indices : {std::vector<uint32_t>{}, std::vector<uint32_t>{0, 1}})
+        {
+            const VertexCacheStats stats = analyze_vertex_cache(indices, 2);
+            EXPECT_EQ(stats.transformed, 0);
+            EXPECT_EQ(stats.acmr, 0.f);
+            EXPECT_EQ(stats.atvr, 0.f);
+        }
+
+        const VertexCacheStats no_vertices = analyze_vertex_cache({0, 1, 2}, 0);
+        EXPECT_EQ(no_vertices.acmr, 0.f);
+        EXPECT_EQ(no_vertices.atvr, 0.f);
+    }
+
+    TEST(MeshOptimizerTests, VertexCacheOrderImprovesAcmr)
+    {
+        std::vector<GridVertex> vertices;
+        std::vector<uint32_t> indices;
+        make_grid(40, vertices, indices);
+        const auto triangles = triangle_set(vertices, indices);
+
+        const VertexCacheStats before = analyze_vertex_cache(indices, vertices.size());
+        optimize_vertex_cache(indices, vertices.size());
+        const VertexCacheStats after = analyze_vertex_cache(indices, vertices.size());
+
+        EXPECT_EQ(triangle_set(vertices, indices), triangles);
+        EXPECT_LT(after.acmr, before.acmr * 0.5f);
+        EXPECT_LT(after.acmr, 1.0f);
+        EXPECT_LT(after.atvr, before.atvr);
+    }
+
+    TEST(MeshOptimizerTests, OverdrawKeepsTrianglesAndCacheEfficiency)
+    {
+        std::vector<GridVertex> vertices;
+        std::vector<uint32_t> indices;
+        make_grid(40, vertices, indices);
+        const auto triangles = triangle_set(vertices, indices);
+
+        optimize_vertex_cache(indices, vertices.size());
+        const float acmr = analyze_vertex_cache(indices, vertices.size()).acmr;
+        optimize_overdraw(indices, vertices[0].position, sizeof(GridVertex), vertices.size(), 1.05f);
+
+        EXPECT_EQ(triangle_set(vertices, indices), triangles);
+        EXPECT_LE(analyze_vertex_cache(indices, vertices.size()).acmr, acmr * 1.05f);
+    }
+
+    TEST(MeshOptimizerTests, FetchOrderFollowsFirstUse)
+    {
+        std::vector<GridVertex> vertices;
+        std::vector<uint32_t> indices;
+        make_grid(8, vertices, indices);
+        vertices.push_back(GridVertex{{-1.f, -1.f, 0.f}, 9999});     // unused
+        const auto triangles = triangle_set(vertices, indices);
+
+        optimize_vertex_fetch(vertices, indices);
+
+        EXPECT_EQ(vertices.size(), 81);
+        EXPECT_EQ(triangle_set(vertices, indices), triangles);
+
+        uint32_t next = 0;
+        for (const uint32_t index : indices)
+        {
+            ASSERT_LE(index, next);
+            if (index == next) ++next;
+        }
+    }
+}
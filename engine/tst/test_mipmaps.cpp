@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "mipmaps.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+    using namespace SketchBook::Imaging;
+
+    static std::vector<uint8_t> solid(const uint32_t width, const uint32_t height, const uint8_t r, const uint8_t g, const uint8_t b, const uint8_t a)
+    {
+        std::vector<uint8_t> pixels(size_t{width} * height * 4);
+        for (size_t i = 0; i < pixels.size(); i += 4)
+        {
+            pixels[i + 0] = r;
+            pixels[i + 1] = g;
+            pixels[i + 2] = b;
+            pixels[i + 3] = a;
+        }
+        return pixels;
+    }
+
+    TEST(MipmapTests, LevelCountAndLayout)
+    {
+        EXPECT_EQ(mip_level_count(1, 1), 1u);
+        EXPECT_EQ(mip_level_count(256, 256), 9u);
+        EXPECT_EQ(mip_level_count(300, 7), 9u);
+        EXPECT_EQ(mip_level_count(1u << 20, 1), MAX_MIP_LEVELS);
+
+        const std::vector<uint8_t> image = solid(5, 3, 10, 20, 30, 40);
+        std::vector<uint8_t> chain;
+        std::vector<MipLevel> levels;
+        build_mip_chain(image.data(), 5, 3, false, chain, levels);
+
+        ASSERT_EQ(levels.size(), 3u);
+        const uint32_t sizes[3][2] = {{5, 3}, {2, 1}, {1, 1}};
+        uint64_t offset = 0;
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            EXPECT_EQ(levels[i].width, sizes[i][0]);
+            EXPECT_EQ(levels[i].height, sizes[i][1]);
+            EXPECT_EQ(levels[i].offset, offset);
+            EXPECT_EQ(levels[i].bytes, uint64_t{sizes[i][0]} * sizes[i][1] * 4);
+            offset += levels[i].bytes;
+        }
+        EXPECT_EQ(chain.size(), offset);
+    }
+
+    TEST(MipmapTests, SolidColorsSurviveEveryLevel)
+    {
+        for (const bool b_srgb : {false, true})
+        {
+            const std::vector<uint8_t> image = solid(64, 32, 13, 128, 251, 77);
+            std::vector<uint8_t> chain;
+            std::vector<MipLevel> levels;
+            build_mip_chain(image.data(), 64, 32, b_srgb, chain, levels);
+
+            for (size_t i = 0; i < chain.size(); i += 4)
+            {
+                ASSERT_EQ(chain[i + 0], 13);
+                ASSERT_EQ(chain[i + 1], 128);
+                ASSERT_EQ(chain[i + 2], 251);
+                ASSERT_EQ(chain[i + 3], 77);
+            }
+        }
+    }
+
+    // half black, half white: the average is 50% linear light, sRGB 188, not 128
+    TEST(MipmapTests, SrgbAveragesInLinearLight)
+    {
+        const uint8_t src[2 * 4] = {0, 0, 0, 0, 255, 255, 255, 255};
+        uint8_t linear[4];
+        uint8_t srgb[4];
+        downsample(src, 2, 1, linear, 1, false, 0, 1);
+        downsample(src, 2, 1, srgb, 1, true, 0, 1);
+
+        EXPECT_EQ(linear[0], 128);
+        EXPECT_EQ(srgb[0], 188);
+        EXPECT_EQ(srgb[2], 188);
+        EXPECT_EQ(srgb[3], 128);    // alpha is linear either way
+    }
+
+    TEST(MipmapTests, ParallelChainMatchesSerial)
+    {
+        const uint32_t width = 513;
+        const uint32_t height = 300;
+        std::vector<uint8_t> image(size_t{width} * height * 4);
+        std::srand(7);
+        for (uint8_t& value : image) value = static_cast<uint8_t>(std::rand());
+
+        Threading::ThreadPool single(0);
+        Threading::ThreadPool many(3);
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> actual;
+        std::vector<MipLevel> levels;
+        build_mip_chain(image.data(), width, height, true, expected, levels, single);
+        build_mip_chain(image.data(), width, height, true, actual, levels, many);
+        EXPECT_EQ(actual, expected);
+    }
+}
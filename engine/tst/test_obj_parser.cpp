@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include "obj_parser.h"
+
+#include <string>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+    using namespace SketchBook::IO;
+
+    static bool same_index(const ObjIndex& a, const ObjIndex& b)
+    {
+        return a.position == b.position && a.texcoord == b.texcoord && a.normal == b.normal;
+    }
+
+    TEST(ObjParserTests, ParsesAttributesAndFaces)
+    {
+        const std::string text =
+            "# comment\n"
+            "mtllib cube.mtl\n"
+            "o Cube\n"
+            "v 1.0 -2.5 +3e1\n"
+            "v 0 0 0\r\n"
+            "v 1 1 1\n"
+            "vt 0.5 0.25\n"
+            "vn 0 1 0\n"
+            "usemtl Material\n"
+            "s off\n"
+            "f 1/1/1 2/1/1 3/1/1\n"
+            "f 1//1 2//1 3//1\n"
+            "f 3 2 1";
+
+        ObjData obj;
+        ASSERT_TRUE(parse_obj(text.data(), text.size(), obj));
+        ASSERT_EQ(obj.positions.size(), 9u);
+        EXPECT_FLOAT_EQ(obj.positions[0], 1.f);
+        EXPECT_FLOAT_EQ(obj.positions[1], -2.5f);
+        EXPECT_FLOAT_EQ(obj.positions[2], 30.f);
+        ASSERT_EQ(obj.texcoords.size(), 2u);
+        EXPECT_FLOAT_EQ(obj.texcoords[1], 0.25f);
+        ASSERT_EQ(obj.normals.size(), 3u);
+
+        ASSERT_EQ(obj.indices.size(), 9u);
+        EXPECT_TRUE(same_index(obj.indices[0], ObjIndex{0, 0, 0}));
+        EXPECT_TRUE(same_index(obj.indices[4], ObjIndex{1, -1, 0}));
+        EXPECT_TRUE(same_index(obj.indices[6], ObjIndex{2, -1, -1}));
+    }
+
+    TEST(ObjParserTests, FanTriangulatesPolygons)
+    {
+        const std::string text = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 2 0\nf 1 2 3 4 5\n";
+
+        ObjData obj;
+        ASSERT_TRUE(parse_obj(text.data(), text.size(), obj));
+        ASSERT_EQ(obj.indices.size(), 9u);
+        const int32_t expected[9] = {0, 1, 2, 0, 2, 3, 0, 3, 4};
+        for (size_t i = 0; i < 9; i++)
+        {
+            EXPECT_EQ(obj.indices[i].position, expected[i]);
+        }
+    }
+
+    TEST(ObjParserTests, ResolvesNegativeIndices)
+    {
+        const std::string text = "v 0 0 0\nv 1 0 0\nv 1 1 0\nvn 0 0 1\nf -3//-1 -2//-1 -1//-1\n";
+
+        ObjData obj;
+        ASSERT_TRUE(parse_obj(text.data(), text.size(), obj));
+        ASSERT_EQ(obj.indices.size(), 3u);
+        EXPECT_TRUE(same_index(obj.indices[0], ObjIndex{0, -1, 0}));
+        EXPECT_TRUE(same_index(obj.indices[2], ObjIndex{2, -1, 0}));
+    }
+
+    TEST(ObjParserTests, RejectsMissingPositions)
+    {
+        const std::string text = "v 0 0 0\nf 1 2 3\n";
+
+        ObjData obj;
+        EXPECT_FALSE(parse_obj(text.data(), text.size(), obj));
+    }
+
+    // big enough for several chunks; relative indices reach back across chunk boundaries
+    TEST(ObjParserTests, ChunkedParseMatchesSingleThreaded)
+    {
+        std::string text;
+        const int quads = 40000;
+        for (int q = 0; q < quads; q++)
+        {
+            text += "v " + std::to_string(q) + " 0 0\n";
+            text += "v " + std::to_string(q) + " 1 0\n";
+            text += "vn 0 0 1\n";
+            if (q > 0)
+            {
+                // the previous pair and this one, half absolute and half relative
+                if (q % 2) text += "f " + std::to_string(2 * q - 1) + "//1 " + std::to_string(2 * q + 1) + "//1 -1//-1 -3//-2\n";
+                else text += "f -4//-1 -2//-1 -1//-1 -3//-1\n";
+            }
+        }
+
+        Threading::ThreadPool single(0);
+        Threading::ThreadPool many(4);
+        ObjData expected;
+        ObjData actual;
+        ASSERT_TRUE(parse_obj(text.data(), text.size(), expected, single));
+        ASSERT_TRUE(parse_obj(text.data(), text.size(), actual, many));
+
+        EXPECT_EQ(actual.positions, expected.positions);
+        EXPECT_EQ(actual.normals, expected.normals);
+        ASSERT_EQ(actual.indices.size(), expected.indices.size());
+        ASSERT_EQ(actual.indices.size(), size_t(quads - 1) * 6);
+        for (size_t i = 0; i < actual.indices.size(); i++)
+        {
+            ASSERT_TRUE(same_index(actual.indices[i], expected.indices[i])) << "corner " << i;
+        }
+
+        // quad q = 1: corners 1, 3, 4, 2 (1-based) -> fan (0, 2, 3), (0, 3, 1)
+        EXPECT_EQ(expected.indices[0].position, 0);
+        EXPECT_EQ(expected.indices[1].position, 2);
+        EXPECT_EQ(expected.indices[2].position, 3);
+        EXPECT_EQ(expected.indices[5].position, 1);
+        // quad q = 2: -4 -2 -1 -3 with 6 positions -> 2, 4, 5, 3
+        EXPECT_EQ(expected.indices[6].position, 2);
+        EXPECT_EQ(expected.indices[7].position, 4);
+        EXPECT_EQ(expected.indices[8].position, 5);
+    }
+}
@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+#include "world/pathfinding.h"
+#include <memory>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::World::Pathfinding;
+
+    // 64x64 map with a wall at x=30 spanning the map except for a gap at the top
+    static std::shared_ptr<HierarchicalGraph> make_walled_graph()
+    {
+        NavigationGrid grid(64, 64, 1.f);
+        grid.set_walkable_rect({30, 0}, {30, 57}, false);
+        return std::make_shared<HierarchicalGraph>(grid, 8);
+    }
+
+    TEST(PathfindingTests, FindsPathAroundWall)
+    {
+        auto graph = make_walled_graph();
+        std::vector<GridCell> cells;
+
+        ASSERT_TRUE(graph->find_path({5, 5}, {50, 5}, cells));
+        EXPECT_TRUE(cells.front() == GridCell({5, 5}));
+        EXPECT_TRUE(cells.back() == GridCell({50, 5}));
+
+        bool b_used_gap = false;
+        for (size_t i = 0; i < cells.size(); i++)
+        {
+            EXPECT_TRUE(graph->grid().is_walkable(cells[i]));
+            if (cells[i].x == 30) b_used_gap = cells[i].y >= 58;
+            if (i > 0)
+            {
+                EXPECT_LE(std::abs(cells[i].x - cells[i - 1].x), 1);
+                EXPECT_LE(std::abs(cells[i].y - cells[i - 1].y), 1);
+            }
+        }
+        EXPECT_TRUE(b_used_gap);
+    }
+
+    TEST(PathfindingTests, UnreachableGoal)
+    {
+        NavigationGrid grid(32, 32, 1.f);
+        grid.set_walkable_rect({16, 0}, {16, 31}, false);
+        HierarchicalGraph graph(grid, 8);
+
+        std::vector<GridCell> cells;
+        EXPECT_FALSE(graph.find_path({2, 2}, {28, 2}, cells));
+        EXPECT_TRUE(cells.empty());
+    }
+
+    TEST(PathfindingTests, ServiceCachesClusterRoutes)
+    {
+        SketchBook::Threading::ThreadPool pool(2);
+        PathfindingService service(make_walled_graph(), pool);
+
+        PathRequest request{{5.5f, 5.5f}, {50.5f, 5.5f}, 2.f, 0.0, 0.1f};
+        PathResult first = service.request(request).get();
+        ASSERT_TRUE(first.b_found);
+        EXPECT_FALSE(first.b_cache_hit);
+        EXPECT_EQ(service.cache_size(), 1u);
+
+        // same cluster pair, different cells
+        request.start = {6.5f, 4.5f};
+        request.goal = {51.5f, 6.5f};
+        PathResult second = service.request(request).get();
+        ASSERT_TRUE(second.b_found);
+        EXPECT_TRUE(second.b_cache_hit);
+        EXPECT_EQ(service.cache_hits(), 1u);
+
+        ASSERT_FALSE(second.steering.empty());
+        EXPECT_EQ(second.steering.front().duration.created_at, 0.0);
+        for (size_t i = 1; i < second.steering.size(); i++)
+        {
+            const auto& prev = second.steering[i - 1].duration;
+            EXPECT_EQ(second.steering[i].duration.created_at, prev.created_at + prev.active_until);
+        }
+    }
+
+    TEST(PathfindingTests, ServiceEvictsOldestClusterRoute)
+    {
+        SketchBook::Threading::ThreadPool pool(0);
+        PathfindingService service(make_walled_graph(), pool, 2);
+
+        // three distinct cluster pairs through a two-entry cache
+        PathRequest first{{5.5f, 5.5f}, {50.5f, 5.5f}, 2.f, 0.0, 0.1f};
+        PathRequest second{{5.5f, 20.5f}, {50.5f, 20.5f}, 2.f, 0.0, 0.1f};
+        PathRequest third{{5.5f, 40.5f}, {50.5f, 40.5f}, 2.f, 0.0, 0.1f};
+        ASSERT_TRUE(service.solve(first).b_found);
+        ASSERT_TRUE(service.solve(second).b_found);
+        ASSERT_TRUE(service.solve(third).b_found);
+        EXPECT_EQ(service.cache_size(), 2u);
+
+        EXPECT_TRUE(service.solve(third).b_cache_hit);
+        EXPECT_TRUE(service.solve(second).b_cache_hit);
+        EXPECT_FALSE(service.solve(first).b_cache_hit);
+    }
+
+    TEST(PathfindingTests, FollowerReachesGoalAndStops)
+    {
+        SketchBook::Threading::ThreadPool pool(0);
+        PathfindingService service(make_walled_graph(), pool);
+
+        const float seconds_per_tick = 0.05f;
+        const PathRequest request{{5.5f, 5.5f}, {50.5f, 5.5f}, 1.f, 0.0, seconds_per_tick};
+        PathResult path = service.solve(request);
+        ASSERT_TRUE(path.b_found);
+        ASSERT_GT(path.steering.size(), 2u);
+        for (const SketchBook::World::SteeringOutputHandle& handle : path.steering)
+        {
+            EXPECT_LE(glm::length(handle.steering_output.linear), request.speed + 1e-4f);
+        }
+
+        // at max speed, so a corner briefly holding two segments has to be clamped
+        SketchBook::World::KinematicObject object(request.start.x, request.start.y);
+        object.set_max_speed(request.speed);
+        PathFollower follower;
+        follower.follow(std::move(path), 0.0);
+
+        int tick = 0;
+        for (; tick < 100000; tick++)
+        {
+            const SketchBook::World::Event_NextTick event{static_cast<double>(tick), seconds_per_tick};
+            follower.update(object, event);
+            object.update(event);
+            if (follower.is_finished() && object.get_current_steering().empty()) break;
+        }
+        ASSERT_TRUE(follower.is_finished());
+        ASSERT_TRUE(object.get_current_steering().empty());
+
+        // nothing left over once the last segment expires
+        EXPECT_NEAR(object.velocity_meter_per_second().x, 0.f, 1e-4f);
+        EXPECT_NEAR(object.velocity_meter_per_second().y, 0.f, 1e-4f);
+        EXPECT_NEAR(glm::length(object.effective_velocity()), 0.f, 1e-4f);
+
+        // each segment ends on its waypoint, so only float rounding from ~2000 integration steps is left
+        EXPECT_NEAR(object.get_position().x, request.goal.x, 1e-2f);
+        EXPECT_NEAR(object.get_position().y, request.goal.y, 1e-2f);
+    }
+}
@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "pipeline_cache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::IO;
+
+    static PipelineCacheKey test_key()
+    {
+        PipelineCacheKey key = {};
+        key.vendor_id = 0x10005;
+        key.device_id = 0;
+        key.driver_version = 4206599;
+        for (uint8_t i = 0; i < 16; i++) key.cache_uuid[i] = i * 3;
+        return key;
+    }
+
+    TEST(PipelineCacheTests, RoundTripForTheSameDevice)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "sk_pipeline_cache_test.skpc").string();
+        std::vector<uint8_t> data(1000);
+        for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 13);
+
+        ASSERT_TRUE(write_pipeline_cache(path, test_key(), data.data(), data.size()));
+
+        std::vector<uint8_t> loaded;
+        ASSERT_TRUE(read_pipeline_cache(path, test_key(), loaded));
+        EXPECT_EQ(loaded, data);
+
+        std::filesystem::remove(path);
+    }
+
+    TEST(PipelineCacheTests, RejectsOtherDriversAndCorruption)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "sk_pipeline_cache_stale.skpc").string();
+        const std::vector<uint8_t> data(256, 0xAB);
+        ASSERT_TRUE(write_pipeline_cache(path, test_key(), data.data(), data.size()));
+
+        std::vector<uint8_t> loaded;
+        PipelineCacheKey other_driver = test_key();
+        other_driver.driver_version++;
+        EXPECT_FALSE(read_pipeline_cache(path, other_driver, loaded));
+        EXPECT_TRUE(loaded.empty());
+
+        PipelineCacheKey other_uuid = test_key();
+        other_uuid.cache_uuid[15] ^= 1;
+        EXPECT_FALSE(read_pipeline_cache(path, other_uuid, loaded));
+
+        // flip one data byte
+        {
+            FILE* file = std::fopen(path.c_str(), "r+b");
+            ASSERT_NE(file, nullptr);
+            std::fseek(file, sizeof(SkPipelineCacheHeader) + 10, SEEK_SET);
+            std::fputc(0x00, file);
+            std::fclose(file);
+        }
+        EXPECT_FALSE(read_pipeline_cache(path, test_key(), loaded));
+
+        EXPECT_FALSE(read_pipeline_cache(path + ".missing", test_key(), loaded));
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "prefab.h"
+#include "world/kinematics.h"
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+
+    struct Health
+    {
+        int value;
+    };
+
+    struct Tag {};
+
+    TEST(PrefabTests, InstancesCopyTemplateAndApplyOverrides)
+    {
+        entt::registry registry;
+
+        Prefab prefab;
+        prefab.set(Health{100}).set<Tag>().set(Health{50}); // setting a component again replaces it
+        EXPECT_EQ(prefab.component_count(), 2u);
+
+        std::vector<entt::entity> entities;
+        prefab.instantiate(registry, 1000, entities);
+        ASSERT_EQ(entities.size(), 1000u);
+        for (const entt::entity entity : entities)
+        {
+            EXPECT_EQ(registry.get<Health>(entity).value, 50);
+            EXPECT_TRUE(registry.all_of<Tag>(entity));
+        }
+
+        std::vector<Health> health(10);
+        for (int i = 0; i < 10; i++) health[i].value = i;
+
+        PrefabOverrides overrides;
+        overrides.set(health.data());
+        prefab.instantiate(registry, health.size(), entities, overrides);
+        ASSERT_EQ(entities.size(), 1010u);
+        for (int i = 0; i < 10; i++)
+        {
+            EXPECT_EQ(registry.get<Health>(entities[1000 + i]).value, i);
+        }
+    }
+
+    TEST(PrefabTests, KinematicBatchSpawnFillsMotionGroup)
+    {
+        entt::registry registry;
+        std::vector<glm::vec2> positions;
+        for (int i = 0; i < 256; i++) positions.push_back({static_cast<float>(i), -static_cast<float>(i)});
+
+        std::vector<entt::entity> entities;
+        World::Kinematics::create_many(registry, positions.data(), positions.size(), entities, World::Kinematics::MotionLimits{3.f, 5.f, 0.25f});
+
+        EXPECT_EQ(World::Kinematics::motion_group(registry).size(), positions.size());
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            EXPECT_EQ(registry.get<World::Kinematics::Position>(entities[i]).value, positions[i]);
+            EXPECT_FLOAT_EQ(registry.get<World::Kinematics::MotionLimits>(entities[i]).max_speed, 3.f);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "data_structures.h"
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::DataStructures;
+
+    TEST(RetireListTests, ReleasesOnlyCompletedFrames)
+    {
+        RetireList<int> list;
+        list.push(1, 0);
+        list.push(2, 1);
+        list.push(3, 1);
+        list.push(4, 3);
+
+        std::vector<int> destroyed;
+        auto destroy = [&](const int handle) { destroyed.push_back(handle); };
+
+        EXPECT_EQ(list.release(0, destroy), 1);
+        EXPECT_EQ(destroyed, (std::vector<int>{1}));
+
+        EXPECT_EQ(list.release(2, destroy), 2);
+        EXPECT_EQ(destroyed, (std::vector<int>{1, 2, 3}));
+        EXPECT_EQ(list.size(), 1);
+
+        // nothing new finished
+        EXPECT_EQ(list.release(2, destroy), 0);
+
+        list.push(5, 4);
+        EXPECT_EQ(list.flush(destroy), 2);
+        EXPECT_EQ(destroyed, (std::vector<int>{1, 2, 3, 4, 5}));
+        EXPECT_TRUE(list.empty());
+    }
+
+    TEST(RetireListTests, SteadyStateKeepsFramesInFlight)
+    {
+        constexpr uint64_t frames_in_flight = 2;
+        RetireList<int> list;
+        int destroyed = 0;
+        auto destroy = [&](const int) { ++destroyed; };
+
+        for (uint64_t frame = 0; frame < 1000; frame++)
+        {
+            if (frame >= frames_in_flight) list.release(frame - frames_in_flight, destroy);
+            for (int i = 0; i < 3; i++) list.push(i, frame);
+
+            // only the frames that may still be on the GPU are held back
+            EXPECT_LE(list.size(), (frames_in_flight + 1) * 3);
+        }
+        EXPECT_EQ(destroyed + static_cast<int>(list.size()), 3000);
+    }
+}
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "slot_map.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::DataStructures;
+
+    TEST(SlotMapTests, InsertGetErase)
+    {
+        SlotMap<std::string> names;
+        const auto a = names.insert("a");
+        const auto b = names.insert("b");
+        const auto c = names.insert("c");
+
+        ASSERT_NE(names.get(b), nullptr);
+        EXPECT_EQ(*names.get(b), "b");
+        EXPECT_EQ(names.size(), 3);
+
+        EXPECT_TRUE(names.erase(a));
+        EXPECT_FALSE(names.erase(a));
+        EXPECT_EQ(names.get(a), nullptr);
+
+        // the last value was moved into the hole; its handle still finds it
+        EXPECT_EQ(*names.get(c), "c");
+        EXPECT_EQ(*names.get(b), "b");
+        EXPECT_EQ(names.size(), 2);
+    }
+
+    TEST(SlotMapTests, StaleHandlesDoNotSeeReusedSlots)
+    {
+        SlotMap<int> values;
+        const auto first = values.insert(1);
+        values.erase(first);
+        const auto second = values.insert(2);
+
+        EXPECT_EQ(first.index(), second.index());
+        EXPECT_NE(first, second);
+        EXPECT_EQ(values.get(first), nullptr);
+        EXPECT_EQ(*values.get(second), 2);
+    }
+
+    TEST(SlotMapTests, NullHandle)
+    {
+        SlotMap<int> values;
+        values.insert(7);
+
+        const Handle<int> null{};
+        EXPECT_TRUE(null.is_null());
+        EXPECT_FALSE(values.contains(null));
+        EXPECT_EQ(values.get(null), nullptr);
+    }
+
+    TEST(SlotMapTests, ExhaustedSlotsAreRetired)
+    {
+        SlotMap<int> values;
+        auto handle = values.insert(0);
+        const uint32_t index = handle.index();
+        for (uint32_t i = 1; i < Handle<int>::MAX_GENERATION; i++)
+        {
+            values.erase(handle);
+            handle = values.insert(static_cast<int>(i));
+            ASSERT_EQ(handle.index(), index);
+        }
+        EXPECT_EQ(handle.generation(), Handle<int>::MAX_GENERATION);
+
+        values.erase(handle);
+        const auto fresh = values.insert(-1);
+        EXPECT_NE(fresh.index(), index);
+        EXPECT_EQ(values.get(handle), nullptr);
+    }
+
+    TEST(SlotMapTests, DenseIteration)
+    {
+        SlotMap<int> values;
+        std::vector<Handle<int>> handles;
+        for (int i = 0; i < 10; i++) handles.push_back(values.insert(i));
+        for (int i = 0; i < 10; i += 2) values.erase(handles[i]);
+
+        int sum = 0;
+        for (const int value : values) sum += value;
+        EXPECT_EQ(sum, 1 + 3 + 5 + 7 + 9);
+
+        for (size_t dense = 0; dense < values.size(); dense++)
+        {
+            EXPECT_EQ(*values.get(values.handle_at(dense)), values.values()[dense]);
+        }
+
+        values.clear();
+        EXPECT_TRUE(values.empty());
+        for (const auto handle : handles) EXPECT_EQ(values.get(handle), nullptr);
+    }
+
+    TEST(SlotMapTests, ThrowsWhenIndicesRunOut)
+    {
+        using IntHandle = SlotMap<int>::handle_type;
+        const size_t capacity = static_cast<size_t>(IntHandle::INDEX_MASK) + 1;
+
+        SlotMap<int> values;
+        values.reserve(capacity);
+        IntHandle last;
+        for (size_t i = 0; i < capacity; i++)
+        {
+            last = values.insert(static_cast<int>(i));
+        }
+        EXPECT_EQ(last.index(), IntHandle::INDEX_MASK);
+
+        EXPECT_THROW(values.insert(-1), std::length_error);
+        EXPECT_EQ(values.size(), capacity);
+
+        // freed slots are still handed out once every index is taken
+        const IntHandle first = values.handle_at(0);
+        ASSERT_TRUE(values.erase(first));
+        const IntHandle reused = values.insert(-2);
+        EXPECT_EQ(reused.index(), first.index());
+        EXPECT_EQ(*values.get(reused), -2);
+        EXPECT_EQ(values.get(first), nullptr);
+    }
+}
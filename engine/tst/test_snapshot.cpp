@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "snapshot.h"
+#include "world/kinematics.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+
+    struct Label
+    {
+        std::string text;
+        std::vector<int> values;
+    };
+
+    template<typename Archive, typename L>
+    std::enable_if_t<std::is_same_v<std::remove_const_t<L>, Label>> snapshot_fields(Archive& archive, L& label)
+    {
+        archive.field(label.text);
+        archive.field(label.values);
+    }
+
+    struct Selected {};
+
+    using namespace SketchBook::World::Kinematics;
+
+    TEST(SnapshotTests, RoundTripsComponentsAndEntityIds)
+    {
+        entt::registry source;
+        std::vector<entt::entity> entities;
+        for (int i = 0; i < 100; i++)
+        {
+            entities.push_back(create(source, static_cast<float>(i), static_cast<float>(-i)));
+            if (i % 3 == 0) source.emplace<Label>(entities.back(), Label{"agent_" + std::to_string(i), {i, i * 2}});
+            if (i % 7 == 0) source.emplace<Selected>(entities.back());
+        }
+        source.destroy(entities[5]);
+        set_max_speed(source, entities[10], 7.f);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "sk_snapshot_test.sksn").string();
+        ASSERT_TRUE((save_snapshot<Position, Velocity, Heading, MotionLimits, Label, Selected>(source, path)));
+
+        entt::registry loaded;
+        ASSERT_TRUE((load_snapshot<Position, Velocity, Heading, MotionLimits, Label, Selected>(loaded, path)));
+
+        EXPECT_FALSE(loaded.valid(entities[5]));
+        for (int i = 0; i < 100; i++)
+        {
+            if (i == 5) continue;
+            const entt::entity entity = entities[i];
+            ASSERT_TRUE(loaded.valid(entity));
+            EXPECT_EQ(loaded.get<Position>(entity).value, source.get<Position>(entity).value);
+            EXPECT_EQ(loaded.all_of<Label>(entity), i % 3 == 0);
+            EXPECT_EQ(loaded.all_of<Selected>(entity), i % 7 == 0);
+            if (i % 3 == 0)
+            {
+                EXPECT_EQ(loaded.get<Label>(entity).text, source.get<Label>(entity).text);
+                EXPECT_EQ(loaded.get<Label>(entity).values, source.get<Label>(entity).values);
+            }
+        }
+        EXPECT_FLOAT_EQ(loaded.get<MotionLimits>(entities[10]).max_speed, 7.f);
+        EXPECT_EQ(motion_group(loaded).size(), 99u);
+    }
+
+    TEST(SnapshotTests, RejectsMismatchedOrTruncatedArchives)
+    {
+        entt::registry source;
+        for (int i = 0; i < 10; i++) create(source, 0.f, 0.f);
+        const std::vector<uint8_t> buffer = save_snapshot<Position, Velocity>(source);
+
+        entt::registry other_layout;
+        EXPECT_FALSE((load_snapshot<Position, Heading>(other_layout, buffer.data(), buffer.size())));
+
+        entt::registry truncated;
+        EXPECT_FALSE((load_snapshot<Position, Velocity>(truncated, buffer.data(), buffer.size() - 5)));
+        EXPECT_EQ(truncated.alive(), 0u);
+
+        entt::registry merged;
+        const entt::entity existing = merged.create();
+        EXPECT_FALSE((merge_snapshot<Position, Velocity>(merged, buffer.data(), buffer.size() - 5)));
+        EXPECT_TRUE(merged.valid(existing));
+        EXPECT_EQ(merged.alive(), 1u);
+        EXPECT_EQ(merged.view<Position>().size(), 0u);
+
+        EXPECT_TRUE((merge_snapshot<Position, Velocity>(merged, buffer.data(), buffer.size())));
+        EXPECT_TRUE(merged.valid(existing));
+        EXPECT_EQ(merged.view<Position>().size(), 10u);
+    }
+}
@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+#include "world/sk_world.h"
+#include "world/loose_tree.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::View;
+
+    static WorldObject make_object(const int id, const glm::vec3& position)
+    {
+        WorldObject object;
+        object.id = id;
+        object.position = position;
+        object.min_corner = position - glm::vec3(0.25f);
+        object.max_corner = position + glm::vec3(0.25f);
+        return object;
+    }
+
+    static std::vector<WorldObject> make_objects()
+    {
+        std::vector<WorldObject> objects;
+        for (int i = 0; i < 400; i++)
+        {
+            objects.push_back(make_object(i, {static_cast<float>((i * 37) % 101), static_cast<float>((i * 53) % 89), 0.f}));
+        }
+        return objects;
+    }
+
+    TEST(SpatialIndexTests, BoxQueryMatchesBruteForce)
+    {
+        const std::vector<WorldObject> objects = make_objects();
+        World2dModel model;
+        model.load(objects);
+        ASSERT_EQ(model.size(), objects.size());
+
+        const WorldBox box = to_world_box({20.f, 10.f, -1.f}, {45.f, 30.f, 1.f});
+        int ids[64];
+        const size_t count = model.query_box(box, ids, 64);
+        ASSERT_LE(count, 64u);
+
+        std::vector<int> found(ids, ids + count);
+        std::vector<int> expected;
+        for (const WorldObject& object : objects)
+        {
+            if (boost::geometry::intersects(object.box(), box)) expected.push_back(object.id);
+        }
+
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+
+    TEST(SpatialIndexTests, LoadKeepsLastCopyOfDuplicateIds)
+    {
+        // id 7 appears twice; the first copy must not linger in the tree
+        const std::vector<WorldObject> objects{
+            make_object(7, {10.f, 10.f, 0.f}),
+            make_object(8, {30.f, 30.f, 0.f}),
+            make_object(7, {60.f, 60.f, 0.f}),
+        };
+        World2dModel model;
+        model.load(objects);
+        EXPECT_EQ(model.size(), 2u);
+
+        int ids[8];
+        EXPECT_EQ(model.query_box(to_world_box({5.f, 5.f, -1.f}, {15.f, 15.f, 1.f}), ids, 8), 0u);
+        ASSERT_EQ(model.query_box(to_world_box({55.f, 55.f, -1.f}, {65.f, 65.f, 1.f}), ids, 8), 1u);
+        EXPECT_EQ(ids[0], 7);
+        ASSERT_EQ(model.query_box(to_world_box({0.f, 0.f, -1.f}, {100.f, 100.f, 1.f}), ids, 8), 2u);
+    }
+
+    TEST(SpatialIndexTests, MovesReinsertOnlyOutsideSlack)
+    {
+        World2dModel model(1.f);
+        model.load({make_object(7, {0.f, 0.f, 0.f})});
+
+        EXPECT_FALSE(model.move_object(7, {0.5f, 0.f, 0.f}));
+        EXPECT_TRUE(model.move_object(7, {1.f, 0.f, 0.f}));
+
+        int ids[4];
+        EXPECT_EQ(model.query_point({1.5f, 0.f, 0.f}, ids, 4), 1u);
+        EXPECT_EQ(ids[0], 7);
+        EXPECT_EQ(model.query_point({0.f, 0.f, 0.f}, ids, 4), 0u);
+
+        EXPECT_TRUE(model.remove(7));
+        EXPECT_EQ(model.query_point({1.5f, 0.f, 0.f}, ids, 4), 0u);
+    }
+
+    TEST(SpatialIndexTests, NearestMatchesBruteForce)
+    {
+        const std::vector<WorldObject> objects = make_objects();
+        World2dModel model;
+        model.load(objects);
+
+        const glm::vec3 center{-10.f, 40.f, 0.f};
+        int ids[5];
+        ASSERT_EQ(model.query_nearest({center.x, center.y, center.z}, 5, ids, 5), 5u);
+
+        std::vector<float> distances;
+        for (const WorldObject& object : objects)
+        {
+            distances.push_back(World2dModel::distance_sq(center, object));
+        }
+        std::sort(distances.begin(), distances.end());
+
+        for (int i = 0; i < 5; i++)
+        {
+            EXPECT_FLOAT_EQ(World2dModel::distance_sq(center, *model.get_object(ids[i])), distances[i]);
+        }
+    }
+
+    TEST(SpatialIndexTests, LooseQuadtreeMatchesBruteForceAfterMoves)
+    {
+        std::vector<WorldObject> objects = make_objects();
+        LooseQuadtree tree({50.f, 50.f, 0.f}, 64.f, 6);
+        tree.load(objects);
+        ASSERT_EQ(tree.size(), objects.size());
+
+        // drift every object; most stay inside their loose bounds
+        for (int step = 0; step < 20; step++)
+        {
+            for (WorldObject& object : objects)
+            {
+                const glm::vec3 delta{static_cast<float>((object.id % 7) - 3) * 0.3f, static_cast<float>((object.id % 5) - 2) * 0.3f, 0.f};
+                object.update_position(delta);
+                tree.move_object(object.id, delta);
+            }
+        }
+
+        const WorldBox box = to_world_box({20.f, 10.f, -1.f}, {45.f, 30.f, 1.f});
+        int ids[128];
+        const size_t count = tree.query_box(box, ids, 128);
+        ASSERT_LE(count, 128u);
+
+        std::vector<int> found(ids, ids + count);
+        std::vector<int> expected;
+        for (const WorldObject& object : objects)
+        {
+            if (boost::geometry::intersects(object.box(), box)) expected.push_back(object.id);
+        }
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+
+        const glm::vec3 center{30.f, 70.f, 0.f};
+        ASSERT_EQ(tree.query_nearest({center.x, center.y, center.z}, 3, ids, 3), 3u);
+        std::vector<float> distances;
+        for (const WorldObject& object : objects)
+        {
+            distances.push_back(LooseQuadtree::distance_sq(center, object));
+        }
+        std::sort(distances.begin(), distances.end());
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_FLOAT_EQ(LooseQuadtree::distance_sq(center, *tree.get_object(ids[i])), distances[i]);
+        }
+
+        for (const WorldObject& object : objects)
+        {
+            EXPECT_TRUE(tree.remove(object.id));
+        }
+        EXPECT_EQ(tree.size(), 0u);
+        EXPECT_EQ(tree.node_count(), 1u);
+    }
+
+    TEST(SpatialIndexTests, LooseQuadtreeNearestStopsWithoutEnoughCandidates)
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        LooseQuadtree tree({50.f, 50.f, 0.f}, 64.f, 6);
+        tree.insert(make_object(0, {10.f, 10.f, 0.f}));
+        tree.insert(make_object(1, {20.f, 10.f, 0.f}));
+        tree.insert(make_object(2, {nan, nan, 0.f}));
+        // far outside the world, so it lives in the root
+        tree.insert(make_object(3, {5000.f, 5000.f, 0.f}));
+
+        // the window grows past the world once and then stops, wherever the NaN entry ranks
+        int ids[4];
+        const size_t count = tree.query_nearest({12.f, 10.f, 0.f}, 4, ids, 4);
+        ASSERT_GE(count, 3u);
+        const std::vector<int> found(ids, ids + count);
+        for (const int id : {0, 1, 3})
+        {
+            EXPECT_NE(std::find(found.begin(), found.end(), id), found.end());
+        }
+
+        // nothing is within any distance of a NaN point
+        EXPECT_EQ(tree.query_nearest({nan, nan, 0.f}, 2, ids, 4), 0u);
+    }
+}
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include "texture_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook;
+    using namespace SketchBook::IO;
+
+    TEST(TextureCacheTests, CachePathReplacesTheExtension)
+    {
+        EXPECT_EQ(texture_cache_path("assets/bricks.png"), "assets/bricks.sktex");
+        EXPECT_EQ(texture_cache_path("assets.d/grass"), "assets.d/grass.sktex");
+    }
+
+    TEST(TextureCacheTests, RoundTripAndStaleness)
+    {
+        const std::string source = "not really a png";
+        const uint64_t source_hash = hash_bytes(source.data(), source.size());
+
+        std::vector<uint8_t> image(8 * 4 * 4);
+        for (size_t i = 0; i < image.size(); i++) image[i] = static_cast<uint8_t>(i * 7);
+        std::vector<uint8_t> chain;
+        std::vector<Imaging::MipLevel> levels;
+        Imaging::build_mip_chain(image.data(), 8, 4, true, chain, levels);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "sk_texture_cache_test.sktex").string();
+        ASSERT_TRUE(write_texture_cache(path, source_hash, source.size(), true, chain.data(), chain.size(), levels));
+
+        {
+            TextureCacheFile cache;
+            ASSERT_TRUE(cache.open(path, source_hash, source.size(), true));
+            EXPECT_EQ(cache.header().b_srgb, 1u);
+            ASSERT_EQ(cache.level_count(), levels.size());
+            EXPECT_EQ(cache.levels()[3].width, 1u);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(cache.pixels()) % SKTEX_ALIGNMENT, 0u);
+            ASSERT_EQ(cache.pixel_bytes(), chain.size());
+            EXPECT_EQ(std::memcmp(cache.pixels(), chain.data(), chain.size()), 0);
+        }
+
+        TextureCacheFile stale;
+        EXPECT_FALSE(stale.open(path, source_hash + 1, source.size(), true));
+        EXPECT_FALSE(stale.is_valid());
+        EXPECT_FALSE(stale.open(path, source_hash, source.size() + 1, true));
+        // built as sRGB, so a linear request must rebuild it
+        EXPECT_FALSE(stale.open(path, source_hash, source.size(), false));
+
+        // a truncated file is rejected rather than read past its end
+        std::filesystem::resize_file(path, sizeof(SkTexHeader) + 8);
+        EXPECT_FALSE(stale.open(path, source_hash, source.size(), true));
+
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "sk_threads.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace EngineTests
+{
+    using namespace SketchBook::Threading;
+
+    static std::vector<std::pair<size_t, size_t>> collect_ranges(ThreadPool& pool, const size_t begin, const size_t end, const size_t grain)
+    {
+        std::mutex mutex;
+        std::vector<std::pair<size_t, size_t>> ranges;
+        pool.parallel_for(begin, end, grain, [&](const size_t first, const size_t last) {
+            std::scoped_lock lock(mutex);
+            ranges.push_back({first, last});
+        });
+        std::sort(ranges.begin(), ranges.end());
+        return ranges;
+    }
+
+    TEST(ThreadPoolTests, ParallelForKeepsGrainWithAndWithoutWorkers)
+    {
+        ThreadPool inline_pool(0);
+        ThreadPool worker_pool(3);
+
+        const std::vector<std::pair<size_t, size_t>> expected{{5, 15}, {15, 25}, {25, 32}};
+        EXPECT_EQ(collect_ranges(inline_pool, 5, 32, 10), expected);
+        EXPECT_EQ(collect_ranges(worker_pool, 5, 32, 10), expected);
+
+        EXPECT_TRUE(collect_ranges(inline_pool, 7, 7, 10).empty());
+        EXPECT_EQ(collect_ranges(inline_pool, 0, 3, 10), (std::vector<std::pair<size_t, size_t>>{{0, 3}}));
+    }
+
+    TEST(ThreadPoolTests, SubmitResolvesWithoutWorkers)
+    {
+        ThreadPool pool(0);
+        std::future<int> result = pool.submit([]() { return 42; });
+        ASSERT_EQ(result.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        EXPECT_EQ(result.get(), 42);
+    }
+
+    TEST(ThreadPoolTests, ParallelForRethrowsOnCaller)
+    {
+        for (const size_t workers : {size_t(0), size_t(3)})
+        {
+            ThreadPool pool(workers);
+            std::atomic<size_t> chunks{0};
+            EXPECT_THROW(pool.parallel_for(0, 100, 10, [&](const size_t first, const size_t) {
+                chunks.fetch_add(1);
+                if (first == 30) throw std::runtime_error("chunk failed");
+            }), std::runtime_error);
+
+            // the pool is still usable afterwards
+            std::future<int> result = pool.submit([]() { return 7; });
+            EXPECT_EQ(result.get(), 7);
+            if (workers > 0) EXPECT_EQ(chunks.load(), 10u);
+        }
+    }
+}
@@ -13,6 +13,11 @@ layout(set = 0, binding = 0) uniform  CameraBuffer{
     vec3 position;
 } cameraData;
 
+// slot 0 is the identity, so draws that only use the push constant matrix are unaffected
+layout(std140, set = 0, binding = 1) readonly buffer InstanceBuffer{
+	mat4 models[];
+} instanceBuffer;
+
 layout( push_constant ) uniform constants
 {
     mat4 render_matrix;
@@ -21,7 +26,7 @@ layout( push_constant ) uniform constants
 
 void main()
 {
-    mat4 transformMatrix = (cameraData.view_proj * PushConstants.render_matrix);
+    mat4 transformMatrix = (cameraData.view_proj * PushConstants.render_matrix * instanceBuffer.models[gl_InstanceIndex]);
     gl_Position = transformMatrix * vec4(vPosition, 1.0f);
     outColor = (PushConstants.normal_color[3] < 1) ? vColor : vec3(PushConstants.normal_color[0], PushConstants.normal_color[1], PushConstants.normal_color[2]);
 }
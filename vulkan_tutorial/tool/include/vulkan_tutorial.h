@@ -22,16 +22,16 @@ namespace VulkanTutorial
     class MeshScene3D;
     class MonkeyMeshScene3D;
 
-    static std::string  default_2d_pipeline_layout_key      {"pipeline_layout.default.2d"};
-    static std::string  default_3d_pipeline_layout_key      {"pipeline_layout.default.3d"};
-    static std::string  pipeline_triangle_key               {"pipeline.triangle"};
-    static std::string  pipeline_red_triangle_key           {"pipeline.red_triangle"};
-    static std::string  pipeline_mesh_key                   {"pipeline.mesh"};
-    static std::string  pipeline_infinite_grid              {"pipeline.infinite_grid"};
-    static std::string  mesh_monkey_key                     {"mesh.monkey"};
-    static std::string  mesh_triangle_key                   {"mesh.triangle"};
-    static std::string  wedge_triangle_key                  {"wedge.triangle"};
-    static std::string  material_mesh_key                   {"material.mesh"};
+    static constexpr SketchBook::AssetKey  default_2d_pipeline_layout_key      {"pipeline_layout.default.2d"};
+    static constexpr SketchBook::AssetKey  default_3d_pipeline_layout_key      {"pipeline_layout.default.3d"};
+    static constexpr SketchBook::AssetKey  pipeline_triangle_key               {"pipeline.triangle"};
+    static constexpr SketchBook::AssetKey  pipeline_red_triangle_key           {"pipeline.red_triangle"};
+    static constexpr SketchBook::AssetKey  pipeline_mesh_key                   {"pipeline.mesh"};
+    static constexpr SketchBook::AssetKey  pipeline_infinite_grid              {"pipeline.infinite_grid"};
+    static constexpr SketchBook::AssetKey  mesh_monkey_key                     {"mesh.monkey"};
+    static constexpr SketchBook::AssetKey  mesh_triangle_key                   {"mesh.triangle"};
+    static constexpr SketchBook::AssetKey  wedge_triangle_key                  {"wedge.triangle"};
+    static constexpr SketchBook::AssetKey  material_mesh_key                   {"material.mesh"};
 
     class TutorialEngine : public Engine<TutorialEngine>{
         
@@ -55,6 +55,7 @@ namespace VulkanTutorial
 			init_framebuffers();
 			init_sync_structures();
             init_descriptors();
+            init_placeholders();
 
 			spdlog::info("Vulkan Init Done");
 
@@ -89,7 +90,7 @@ namespace VulkanTutorial
                 scene->render = [=](const float delta){
                     VkCommandBuffer& cmd = get_current_frame().main_command_buffer;
                     SketchBook::Components::Pipeline* pipeline = get_pipeline(pipeline_triangle_key);
-                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
+                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, resolve(pipeline->pipeline));
                     vkCmdDraw(cmd, 3, 1, 0, 0);
                 };
              });
@@ -99,7 +100,7 @@ namespace VulkanTutorial
                 scene->render = [=](const float delta){
                     VkCommandBuffer& cmd = get_current_frame().main_command_buffer;
                     SketchBook::Components::Pipeline* pipeline = get_pipeline(pipeline_red_triangle_key);
-                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
+                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, resolve(pipeline->pipeline));
                     vkCmdDraw(cmd, 3, 1, 0, 0);
                 };
              });
@@ -113,37 +114,14 @@ namespace VulkanTutorial
 
 
                 RenderObject obj;
-                obj.material_name = material_mesh_key;
-                obj.mesh_name = mesh_triangle_key;
+                obj.material_name = material_mesh_key.str();
+                obj.mesh_name = mesh_triangle_key.str();
 
-                obj.render = [=](const float delta) mutable {
-                    MeshPushConstants constants;
-                    constants.normal_color = {0.f, 1.f, 0.f, 0.f};
-                    constants.render_matrix = glm::mat4(1.f);
-
-                    VkCommandBuffer& cmd = get_current_frame().main_command_buffer;
-
-                    SketchBook::Components::Material* material = get_material(obj.material_name);
-                    SketchBook::Components::Pipeline* pipeline = get_pipeline(material->pipeline_name);
-                    SketchBook::Components::PipelineLayout* pipeline_layout = get_pipeline_layout(material->pipeline_layout_name);
-                    SketchBook::Components::Mesh* mesh = get_mesh(obj.mesh_name);
-                
-                    VkDeviceSize offset2 = 0;
-                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
-                    vkCmdBindVertexBuffers(cmd, 0, 1, &mesh->mesh.vertex_buffer.buffer, &offset2);
-                    vkCmdPushConstants(cmd, pipeline_layout->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
-                    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->pipeline_layout, 0, 1, &get_current_frame().global_descriptor, 0, nullptr);
-                    vkCmdDraw(cmd, mesh->mesh.vertices.size(), 1, 0, 0);
-                };
+                obj.model_matrix.translation = glm::vec3(0.f);
+                obj.normal_color = {0.f, 1.f, 0.f, 0.f};
 
-                scene->render_objects.push_back(obj);
-
-                scene->render = [=](const float delta) mutable {
-                    for (auto &obj : scene->render_objects)
-                    {
-                        obj.render(delta);
-                    }
-                };
+                // drawn by the engine from the compiled draw record
+                scene->add_render_object(obj);
              });
 
             create_scene("monkey_scene", [=](Scene* scene) mutable {
@@ -159,16 +137,14 @@ namespace VulkanTutorial
                     VkCommandBuffer& cmd = get_current_frame().main_command_buffer;
 
                     SketchBook::Components::Material* material = get_material(material_mesh_key);
-                    SketchBook::Components::Pipeline* pipeline = get_pipeline(material->pipeline_name);
-                    SketchBook::Components::PipelineLayout* pipeline_layout = get_pipeline_layout(material->pipeline_layout_name);
+                    SketchBook::Components::Pipeline* pipeline = get_pipeline(material->pipeline_id);
+                    SketchBook::Components::PipelineLayout* pipeline_layout = get_pipeline_layout(material->pipeline_layout_id);
                     SketchBook::Components::Mesh* mesh = get_mesh(mesh_monkey_key);
                 
-                    VkDeviceSize offset2 = 0;
-                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
-                    vkCmdBindVertexBuffers(cmd, 0, 1, &mesh->mesh.vertex_buffer.buffer, &offset2);
-                    vkCmdPushConstants(cmd, pipeline_layout->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
-                    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->pipeline_layout, 0, 1, &get_current_frame().global_descriptor, 0, nullptr);
-                    vkCmdDraw(cmd, mesh->mesh.vertices.size(), 1, 0, 0);
+                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, resolve(pipeline->pipeline));
+                    vkCmdPushConstants(cmd, resolve(pipeline_layout->pipeline_layout), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
+                    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, resolve(pipeline_layout->pipeline_layout), 0, 1, &get_current_frame().global_descriptor, 0, nullptr);
+                    draw_mesh(cmd, mesh->mesh);
                 };
             });
 
@@ -183,16 +159,14 @@ namespace VulkanTutorial
                     VkCommandBuffer& cmd = get_current_frame().main_command_buffer;
 
                     SketchBook::Components::Material* material = get_material(material_mesh_key);
-                    SketchBook::Components::Pipeline* pipeline = get_pipeline(material->pipeline_name);
-                    SketchBook::Components::PipelineLayout* pipeline_layout = get_pipeline_layout(material->pipeline_layout_name);
+                    SketchBook::Components::Pipeline* pipeline = get_pipeline(material->pipeline_id);
+                    SketchBook::Components::PipelineLayout* pipeline_layout = get_pipeline_layout(material->pipeline_layout_id);
                     SketchBook::Components::Mesh* mesh = get_mesh(wedge_triangle_key);
                 
                     float _x = 0.f, _y = 0.f, _z = 0.f;
                     float d = 1.f;
                     for (int i = 0; i < 4; i++)
                     {
-                        VkDeviceSize offset = 0;
-                
                         switch(i)
                         {
                             case 0:
@@ -217,11 +191,10 @@ namespace VulkanTutorial
                         constants.normal_color = {0.f, 0.f, 1.f, 1.f};
                         constants.render_matrix = glm::translate(glm::mat4(1.f), pos);
 
-                        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->pipeline);
-                        vkCmdBindVertexBuffers(cmd, 0, 1, &mesh->mesh.vertex_buffer.buffer, &offset);
-                        vkCmdPushConstants(cmd, pipeline_layout->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
-                        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->pipeline_layout, 0, 1, &get_current_frame().global_descriptor, 0, nullptr);            
-                        vkCmdDraw(cmd, mesh->mesh.vertices.size(), 1, 0, 0);
+                        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, resolve(pipeline->pipeline));
+                        vkCmdPushConstants(cmd, resolve(pipeline_layout->pipeline_layout), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
+                        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, resolve(pipeline_layout->pipeline_layout), 0, 1, &get_current_frame().global_descriptor, 0, nullptr);            
+                        draw_mesh(cmd, mesh->mesh);
                     };
                 };
             });
@@ -266,8 +239,9 @@ namespace VulkanTutorial
     {
         spdlog::info("Loading meshes");
 
-        create_mesh_from_file(mesh_monkey_key, "assets/monkey_smooth.obj");
-        create_mesh_from_file(wedge_triangle_key, "assets/wedge.obj");
+        // decoded on the thread pool; the scenes draw placeholders until the uploads land in draw()
+        create_mesh_from_file_async(mesh_monkey_key, "assets/monkey_smooth.obj");
+        create_mesh_from_file_async(wedge_triangle_key, "assets/wedge.obj");
 
         create_mesh(mesh_triangle_key, [](Vertex_RBG_Normal_Mesh* mesh){
             mesh->vertices.resize(6);
@@ -320,6 +294,9 @@ namespace VulkanTutorial
 
         spdlog::info("Loading Pipelines");
 
+        // the three pipelines are independent: build them together on the thread pool
+        begin_pipeline_batch();
+
         create_pipeline(pipeline_triangle_key, default_2d_pipeline_layout_key, triangleVertexShader, triangleFragShader, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_POLYGON_MODE_FILL);
 
         create_pipeline(pipeline_red_triangle_key, default_2d_pipeline_layout_key, redTriangleVertexShader, redTriangleFragShader, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_POLYGON_MODE_FILL);
@@ -335,6 +312,8 @@ namespace VulkanTutorial
                 builder._vertexInputInfo.vertexBindingDescriptionCount = m_vertex_description.bindings.size();
         });
 
+        end_pipeline_batch();
+
         spdlog::info("Cleanup Shaders");
 
         vkDestroyShaderModule(vk_init().device, redTriangleVertexShader, nullptr);